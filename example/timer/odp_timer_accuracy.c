@@ -865,6 +865,30 @@ static void print_nsec_error(const char *str, int64_t nsec, double res_ns,
 	printf("\n");
 }
 
+static void print_timer_pool_stats(test_global_t *test_global)
+{
+	odp_timer_pool_stats_t stats;
+	uint64_t lower;
+	int i;
+
+	if (odp_timer_pool_stats(test_global->timer_pool, &stats)) {
+		printf("  timer pool statistics not available\n");
+		return;
+	}
+
+	printf("  timer pool expired timers: %" PRIu64 "\n", stats.num_expired);
+	printf("  timer pool lateness (nsec):      expire      enqueue\n");
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++) {
+		if (stats.expire_lateness[i] == 0 && stats.enq_lateness[i] == 0)
+			continue;
+
+		lower = i ? (uint64_t)1 << (i - 1) : 0;
+		printf("         >= %-12" PRIu64 "     %12" PRIu64 " %12" PRIu64 "\n", lower,
+		       stats.expire_lateness[i], stats.enq_lateness[i]);
+	}
+}
+
 static void print_stat(test_global_t *test_global)
 {
 	uint64_t i;
@@ -997,6 +1021,8 @@ static void print_stat(test_global_t *test_global)
 	printf("  final timeout error (nsec):\n");
 	print_nsec_error("max", max, res_ns, -1, -1);
 
+	print_timer_pool_stats(test_global);
+
 	printf("\n");
 }
 
@@ -80,6 +80,15 @@ typedef union odp_pool_stats_opt_t {
 
 		/** See odp_pool_stats_t::thread::cache_available */
 		uint64_t thread_cache_available : 1;
+
+		/** See odp_pool_stats_t::remote_alloc_ops */
+		uint64_t remote_alloc_ops   : 1;
+
+		/** See odp_pool_stats_t::global_ops */
+		uint64_t global_ops         : 1;
+
+		/** See odp_pool_stats_t::max_in_use */
+		uint64_t max_in_use         : 1;
 	} bit;
 
 	/** All bits of the bit field structure
@@ -125,6 +134,24 @@ typedef struct odp_pool_stats_t {
 	/** The number of free operations, which stored events to pool caches. */
 	uint64_t cache_free_ops;
 
+	/** The number of alloc operations (see 'alloc_ops') done by threads, which
+	 *  run on a different NUMA node than where the pool memory is located.
+	 *  Always zero, when the NUMA node of the pool memory is not known. */
+	uint64_t remote_alloc_ops;
+
+	/** The number of alloc and free operations, which accessed the pool
+	 *  global (shared by all threads) event storage. These are the
+	 *  operations which could not be served only from / to pool caches.
+	 *  Together with 'cache_alloc_ops' and 'cache_free_ops', this counter
+	 *  indicates how efficiently pool caches are utilized. */
+	uint64_t global_ops;
+
+	/** The maximum number of events allocated from the pool simultaneously
+	 *  (high-water mark) since pool creation or the latest
+	 *  odp_pool_stats_reset() call. Events stored in pool caches may be
+	 *  counted as allocated. */
+	uint64_t max_in_use;
+
 	/** Per thread counters */
 	struct {
 		/** First thread identifier to read counters from. Ignored when
@@ -175,6 +202,15 @@ typedef struct odp_pool_stats_selected_t {
 	/** See odp_pool_stats_t::cache_free_ops */
 	uint64_t cache_free_ops;
 
+	/** See odp_pool_stats_t::remote_alloc_ops */
+	uint64_t remote_alloc_ops;
+
+	/** See odp_pool_stats_t::global_ops */
+	uint64_t global_ops;
+
+	/** See odp_pool_stats_t::max_in_use */
+	uint64_t max_in_use;
+
 } odp_pool_stats_selected_t;
 
 /**
@@ -640,6 +676,17 @@ typedef struct odp_pool_param_t {
 	 */
 	odp_pool_stats_opt_t stats;
 
+	/** NUMA node hint for pool memory
+	 *
+	 *  When zero or positive, implementation allocates pool memory (events,
+	 *  user areas and pool internal data) preferably from this NUMA node.
+	 *  Memory from other nodes may be used when the requested node does not
+	 *  have enough free memory. Use e.g. a separate pool per NUMA node to
+	 *  keep events local to the threads processing them. The default value
+	 *  is -1, which leaves memory placement to the implementation.
+	 */
+	int32_t numa_node;
+
 } odp_pool_param_t;
 
 /**
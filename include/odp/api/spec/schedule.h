@@ -537,6 +537,38 @@ void odp_schedule_order_lock_wait(uint32_t lock_index);
  */
 void odp_schedule_order_wait(void);
 
+/**
+ * Read scheduling latency statistics
+ *
+ * Outputs latency statistics of events scheduled from queues of the given
+ * schedule group, priority and synchronization type. Counters are collected
+ * since odp_schedule_config() call, or since the previous
+ * odp_schedule_latency_stats_reset() call. The call is not intended for fast
+ * path use.
+ *
+ * @param      group   Schedule group
+ * @param      prio    Priority level
+ * @param      sync    Synchronization type
+ * @param[out] stats   Pointer to statistics output buffer
+ *
+ * @retval  0 On success
+ * @retval <0 On failure, e.g. statistics are not supported or enabled
+ *
+ * @see odp_schedule_capability(), odp_schedule_latency_stats_t
+ */
+int odp_schedule_latency_stats(odp_schedule_group_t group, odp_schedule_prio_t prio,
+			       odp_schedule_sync_t sync, odp_schedule_latency_stats_t *stats);
+
+/**
+ * Reset scheduling latency statistics
+ *
+ * Resets all scheduling latency statistics counters to zero.
+ *
+ * @retval  0 On success
+ * @retval <0 On failure
+ */
+int odp_schedule_latency_stats_reset(void);
+
 /**
  * Print debug info about scheduler
  *
@@ -62,6 +62,12 @@ extern "C" {
  * Use direct function call instead.
  */
 
+/** Number of bins in scheduling latency histograms */
+#define ODP_SCHED_LATENCY_HIST_BINS 32
+
+/** Number of bins in scheduling burst size histograms */
+#define ODP_SCHED_BURST_HIST_BINS 9
+
 /**
  * @typedef odp_schedule_sync_t
  * Scheduler synchronization method
@@ -243,6 +249,13 @@ typedef struct odp_schedule_capability_t {
 	 *  does nothing. */
 	odp_support_t order_wait;
 
+	/** Scheduling latency statistics support
+	 *
+	 *  When true, odp_schedule_latency_stats() and
+	 *  odp_schedule_latency_stats_reset() are supported. The implementation
+	 *  may need to be configured to collect the statistics. */
+	odp_bool_t latency_stats;
+
 } odp_schedule_capability_t;
 
 /**
@@ -316,6 +329,46 @@ typedef struct odp_schedule_group_info_t {
 	odp_thrmask_t thrmask; /**< Thread mask of the schedule group */
 } odp_schedule_group_info_t;
 
+/**
+ * Scheduling latency statistics
+ *
+ * Statistics are collected from a sample of events. Latency histograms count
+ * sampled events by the time they waited in a scheduled queue before
+ * the scheduler dispatched them. Bin 0 counts latencies less than one
+ * nanosecond. Bin N (N > 0) counts latencies from 2^(N-1) to 2^N - 1
+ * nanoseconds. The last bin counts also all larger values.
+ *
+ * Burst size histograms count sampled schedule operations by the number of
+ * events the scheduler dispatched from a queue. Bin N counts burst sizes from
+ * 2^N to 2^(N+1) - 1 events. The last bin counts also all larger values.
+ */
+typedef struct odp_schedule_latency_stats_t {
+	/** Sampling rate
+	 *
+	 *  One out of 'sample_rate' enqueued events (and schedule operations)
+	 *  is sampled. */
+	uint32_t sample_rate;
+
+	/** Number of latency samples */
+	uint64_t num_sample;
+
+	/** Minimum sampled latency in nanoseconds. Zero when num_sample is zero. */
+	uint64_t min_latency;
+
+	/** Maximum sampled latency in nanoseconds */
+	uint64_t max_latency;
+
+	/** Average sampled latency in nanoseconds. Zero when num_sample is zero. */
+	uint64_t avg_latency;
+
+	/** Enqueue to dispatch latency histogram */
+	uint64_t latency[ODP_SCHED_LATENCY_HIST_BINS];
+
+	/** Burst size histogram */
+	uint64_t burst[ODP_SCHED_BURST_HIST_BINS];
+
+} odp_schedule_latency_stats_t;
+
 /**
  * @}
  */
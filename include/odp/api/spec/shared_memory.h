@@ -98,6 +98,15 @@ extern "C" {
  */
 #define ODP_SHM_NO_HP		0x40
 
+/**
+ * Allocate from the local NUMA node
+ *
+ * When set, the memory is allocated preferably from the NUMA node of the CPU
+ * running the calling thread. Memory from other nodes may be used when the
+ * local node does not have enough free memory.
+ */
+#define ODP_SHM_NUMA_LOCAL	0x80
+
 /**
  * Shared memory block info
  */
@@ -221,6 +221,34 @@ int odp_timer_sample_ticks(odp_timer_pool_t timer_pool[], uint64_t tick[], uint6
 int odp_timer_pool_info(odp_timer_pool_t timer_pool,
 			odp_timer_pool_info_t *info);
 
+/**
+ * Read timer pool statistics
+ *
+ * Outputs statistics counters of the timer pool. Counters are collected since the timer pool was
+ * created, or since the previous odp_timer_pool_stats_reset() call. Depending on
+ * the implementation, there may be some delay until expired timers are visible in
+ * the statistics.
+ *
+ * @param      timer_pool  Timer pool
+ * @param[out] stats       Pointer to statistics output buffer
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_timer_pool_stats(odp_timer_pool_t timer_pool, odp_timer_pool_stats_t *stats);
+
+/**
+ * Reset timer pool statistics
+ *
+ * Resets all timer pool statistics counters to zero.
+ *
+ * @param timer_pool  Timer pool
+ *
+ * @retval 0 on success
+ * @retval <0 on failure
+ */
+int odp_timer_pool_stats_reset(odp_timer_pool_t timer_pool);
+
 /**
  * Allocate a timer
  *
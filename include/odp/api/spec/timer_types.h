@@ -61,6 +61,9 @@ extern "C" {
  * Maximum timer pool name length in chars including null char
  */
 
+/** Number of bins in timer pool lateness histograms */
+#define ODP_TIMER_POOL_STATS_HIST_BINS 32
+
 /**
  * Timer type
  *
@@ -646,8 +649,44 @@ typedef struct {
 	/** Timer pool tick information */
 	odp_timer_tick_info_t tick_info;
 
+	/** Number of timer pool tick overruns
+	 *
+	 *  Number of timer pool ticks that implementation has missed, or processed too late,
+	 *  since the timer pool was started. Non-zero value indicates that timer resolution is
+	 *  too high for the implementation to process timers in time. The value is zero, when
+	 *  the implementation does not track overruns.
+	 */
+	uint64_t overruns;
+
 } odp_timer_pool_info_t;
 
+/**
+ * Timer pool statistics
+ *
+ * Lateness histograms count timeouts by how many nanoseconds the timeout was processed after its
+ * expiration time. Bin 0 counts timeouts that were not late. Bin N (N > 0) counts lateness
+ * values from 2^(N-1) to 2^N - 1 nanoseconds. The last bin counts also all larger values.
+ */
+typedef struct {
+	/** Number of expired timers */
+	uint64_t num_expired;
+
+	/** Lateness of timer expiration processing
+	 *
+	 *  Time from timer expiration time to the time when the implementation detected that
+	 *  the timer has expired.
+	 */
+	uint64_t expire_lateness[ODP_TIMER_POOL_STATS_HIST_BINS];
+
+	/** Lateness of timeout event enqueue
+	 *
+	 *  Time from timer expiration time to the time when the timeout event was enqueued into
+	 *  the destination queue.
+	 */
+	uint64_t enq_lateness[ODP_TIMER_POOL_STATS_HIST_BINS];
+
+} odp_timer_pool_stats_t;
+
 /**
  * @}
  */
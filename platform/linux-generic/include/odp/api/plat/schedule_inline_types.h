@@ -53,6 +53,10 @@ typedef struct {
 	void (*schedule_order_lock_wait)(uint32_t lock_index);
 	void (*schedule_order_wait)(void);
 	void (*schedule_print)(void);
+	int (*schedule_latency_stats)(odp_schedule_group_t group, odp_schedule_prio_t prio,
+				      odp_schedule_sync_t sync,
+				      odp_schedule_latency_stats_t *stats);
+	int (*schedule_latency_stats_reset)(void);
 
 } _odp_schedule_api_fn_t;
 
@@ -12,6 +12,8 @@
 extern "C" {
 #endif
 
+#include <odp/autoheader_internal.h>
+
 /*
  * Maximum number of supported CPU identifiers. The maximum supported CPU ID is
  * CONFIG_NUM_CPU_IDS - 1. Note that the maximum number of ODP threads is
@@ -37,9 +39,15 @@ extern "C" {
 /*
  * Maximum number of scheduled ODP queues
  *
- * Must be a power of two.
+ * Must be a power of two. Set with --with-max-sched-queues configure option.
+ * Queue ring storage and scheduler per queue storage are reserved when queues
+ * are created. Scheduler priority queue rings are sized by this value.
  */
+#ifdef _ODP_CONFIG_MAX_SCHED_QUEUES
+#define CONFIG_MAX_SCHED_QUEUES _ODP_CONFIG_MAX_SCHED_QUEUES
+#else
 #define CONFIG_MAX_SCHED_QUEUES 1024
+#endif
 
 /*
  * Maximum number of queues
@@ -48,6 +56,22 @@ extern "C" {
 			   CONFIG_MAX_PLAIN_QUEUES + \
 			   CONFIG_MAX_SCHED_QUEUES)
 
+/*
+ * Maximum number of shared memory chunks for queue ring storage
+ *
+ * Chunks are reserved when queues are created. Chunk sizes grow
+ * geometrically, so that the last chunk covers at least CONFIG_MAX_QUEUES.
+ */
+#define CONFIG_QUEUE_RING_CHUNKS 16
+
+/*
+ * Maximum number of shared memory chunks per scheduler storage table
+ *
+ * Basic scheduler reserves priority queue rings and order contexts in chunks,
+ * which grow geometrically.
+ */
+#define CONFIG_SCHED_STORAGE_CHUNKS 12
+
 /*
  * Maximum number of ordered locks per queue
  */
@@ -135,10 +159,13 @@ extern "C" {
  * Number of shared memory blocks reserved for implementation internal use.
  *
  * Each pool requires three blocks (buffers, ring, user area), 20 blocks
- * are reserved for per ODP module global data and one block per packet I/O is
- * reserved for TX completion usage.
+ * are reserved for per ODP module global data, one block per packet I/O is
+ * reserved for TX completion usage, CONFIG_QUEUE_RING_CHUNKS blocks for
+ * queue ring storage and CONFIG_SCHED_STORAGE_CHUNKS blocks for both scheduler
+ * storage tables.
  */
-#define CONFIG_INTERNAL_SHM_BLOCKS ((ODP_CONFIG_POOLS * 3) + 20 + ODP_CONFIG_PKTIO_ENTRIES)
+#define CONFIG_INTERNAL_SHM_BLOCKS ((ODP_CONFIG_POOLS * 3) + 20 + ODP_CONFIG_PKTIO_ENTRIES + \
+				    CONFIG_QUEUE_RING_CHUNKS + 2 * CONFIG_SCHED_STORAGE_CHUNKS)
 
 /*
  * Maximum number of shared memory blocks.
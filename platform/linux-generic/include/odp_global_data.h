@@ -44,9 +44,15 @@ typedef struct {
 	char     model_str[CONFIG_NUM_CPU_IDS][MODEL_STR_SIZE];
 } system_info_t;
 
+/* 1 GB huge page size */
+#define HUGE_PAGE_SIZE_1G (1024 * 1024 * 1024ULL)
+
 typedef struct {
 	uint64_t default_huge_page_size;
 	char     *default_huge_page_dir;
+	/* Mount point for 1 GB huge pages. NULL if not available, or if 1 GB
+	 * is the default huge page size. */
+	char     *huge_page_1g_dir;
 } hugepage_info_t;
 
 /* Read-only global data. Members should not be modified after global init
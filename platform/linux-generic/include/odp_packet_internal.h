@@ -37,6 +37,7 @@ extern "C" {
 #include <odp_queue_if.h>
 #include <odp_config_internal.h>
 
+#include <stddef.h>
 #include <stdint.h>
 #include <string.h>
 
@@ -82,18 +83,13 @@ typedef struct ODP_ALIGNED_CACHE odp_packet_hdr_t {
 	/* Common event header */
 	_odp_event_hdr_t event_hdr;
 
+	/* Fields accessed on every packet operation (data pointer, lengths
+	 * and headroom / tailroom) share the cache line with the event
+	 * header */
+
 	/* Segment data start */
 	uint8_t *seg_data;
 
-	packet_parser_t p;
-
-	/* --- 64-byte cache line boundary --- */
-
-	odp_pktio_t input;
-
-	/* Next header which continues the segment list */
-	struct odp_packet_hdr_t *seg_next;
-
 	/* Total packet length */
 	uint32_t frame_len;
 
@@ -110,9 +106,16 @@ typedef struct ODP_ALIGNED_CACHE odp_packet_hdr_t {
 	/* Event subtype */
 	int8_t   subtype;
 
-	/* Used as classifier destination queue, in IPsec inline input processing and as Tx
-	 * completion event queue. */
-	odp_queue_t dst_queue;
+	odp_pktio_t input;
+
+	/* --- 64-byte cache line boundary --- */
+
+	/* Parse results and fields used on packet free */
+
+	packet_parser_t p;
+
+	/* Next header which continues the segment list */
+	struct odp_packet_hdr_t *seg_next;
 
 	/* Reference count */
 	odp_atomic_u32_t ref_cnt;
@@ -120,6 +123,10 @@ typedef struct ODP_ALIGNED_CACHE odp_packet_hdr_t {
 	/* Flow hash value */
 	uint32_t flow_hash;
 
+	/* Used as classifier destination queue, in IPsec inline input processing and as Tx
+	 * completion event queue. */
+	odp_queue_t dst_queue;
+
 	/* User area pointer */
 	void *uarea_addr;
 
@@ -176,6 +183,12 @@ typedef struct ODP_ALIGNED_CACHE odp_packet_hdr_t {
  * grow over 256 bytes. */
 ODP_STATIC_ASSERT(sizeof(odp_packet_hdr_t) <= 256, "PACKET_HDR_SIZE_ERROR");
 
+/* Frequently used fields must stay within the first two 64-byte cache lines. Rarely used
+ * metadata (timestamp, classifier, LSO, Tx aging/completion, crypto/IPsec results) follows
+ * those. */
+ODP_STATIC_ASSERT(offsetof(odp_packet_hdr_t, user_ptr) + sizeof(void *) <= 128,
+		  "PACKET_HDR_HOT_FIELDS_ERROR");
+
 ODP_STATIC_ASSERT(ODP_CONFIG_PKTIO_ENTRIES < UINT8_MAX, "MS_PKTIO_IDX_SIZE_ERROR");
 
 /**
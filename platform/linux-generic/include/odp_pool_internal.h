@@ -34,6 +34,23 @@ extern "C" {
 typedef struct ODP_ALIGNED_CACHE pool_cache_t {
 	/* Number of buffers in cache */
 	odp_atomic_u32_t cache_num;
+	/* Current transfer size between the cache and the global pool */
+	uint16_t         burst;
+	/* Direction of the previous transfer (CACHE_REFILL or CACHE_FLUSH) */
+	uint8_t          burst_dir;
+
+	/* Statistics counters. Updated only by the owner thread and summed
+	 * over all threads on read. */
+	struct {
+		odp_atomic_u64_t alloc_ops;
+		odp_atomic_u64_t alloc_fails;
+		odp_atomic_u64_t free_ops;
+		odp_atomic_u64_t cache_alloc_ops;
+		odp_atomic_u64_t cache_free_ops;
+		odp_atomic_u64_t remote_alloc_ops;
+		odp_atomic_u64_t global_ops;
+	} stats;
+
 	/* Cached buffers */
 	_odp_event_hdr_t *event_hdr[CONFIG_POOL_CACHE_MAX_SIZE];
 
@@ -71,6 +88,7 @@ typedef struct pool_t {
 	uint32_t         ring_mask;
 	uint32_t         cache_size;
 	uint32_t         burst_size;
+	uint8_t          burst_adapt;
 	odp_shm_t        shm;
 	odp_shm_t        uarea_shm;
 	uint64_t         shm_size;
@@ -96,16 +114,18 @@ typedef struct pool_t {
 	uint32_t         ext_head_offset;
 	uint32_t         skipped_blocks;
 	uint8_t          mem_from_huge_pages;
+	/* Requested NUMA node, or -1 */
+	int              numa_node;
+	/* NUMA node where pool memory was allocated, or -1 if not known */
+	int              mem_numa_node;
 	const struct _odp_pool_mem_src_ops_t *mem_src_ops;
 	/* Private area for memory source operations */
 	uint8_t mem_src_data[_ODP_POOL_MEM_SRC_DATA_SIZE] ODP_ALIGNED_CACHE;
 
 	struct ODP_ALIGNED_CACHE {
-		odp_atomic_u64_t alloc_ops;
-		odp_atomic_u64_t alloc_fails;
-		odp_atomic_u64_t free_ops;
-		odp_atomic_u64_t cache_alloc_ops;
-		odp_atomic_u64_t cache_free_ops;
+		/* Number of events outside of the global ring */
+		odp_atomic_u64_t in_use;
+		odp_atomic_u64_t max_in_use;
 	} stats;
 
 	pool_cache_t     local_cache[ODP_THREAD_COUNT_MAX];
@@ -124,7 +144,10 @@ typedef struct pool_global_t {
 		uint32_t pkt_max_num;
 		uint32_t local_cache_size;
 		uint32_t burst_size;
+		uint32_t burst_adapt;
+		uint32_t lock_mem;
 		uint32_t pkt_base_align;
+		uint32_t pkt_cache_color;
 		uint32_t buf_min_align;
 	} config;
 
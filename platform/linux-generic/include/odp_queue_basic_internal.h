@@ -25,8 +25,8 @@ extern "C" {
 #include <odp_config_internal.h>
 #include <odp_macros_internal.h>
 #include <odp_ring_mpmc_u32_internal.h>
-#include <odp_ring_st_internal.h>
 #include <odp_ring_spsc_internal.h>
+#include <odp_ring_u32_internal.h>
 #include <odp_queue_lf.h>
 
 #define QUEUE_STATUS_FREE         0
@@ -50,38 +50,67 @@ typedef struct ODP_ALIGNED_CACHE queue_entry_s {
 	/* MPMC ring (2 cache lines). */
 	ring_mpmc_u32_t      ring_mpmc;
 
+	/* Protects status changes. Plain and scheduled queue enqueue and
+	 * dequeue operations are lock-free on ring_mpmc. */
 	odp_ticketlock_t     lock;
-	union {
-		ring_st_t    ring_st;
-		ring_spsc_t  ring_spsc;
-	};
+	ring_spsc_t          ring_spsc;
 
 	odp_atomic_u64_t     num_timers;
 	int                  status;
 
+	/* Scheduler latency sample: event index and enqueue time of a sampled event.
+	 * State is one of LAT_SAMPLE_FREE, _CLAIMED or _ARMED. */
+	odp_atomic_u32_t     lat_sample_state;
+	uint32_t             lat_sample_idx;
+	uint64_t             lat_sample_ns;
+
 	queue_deq_multi_fn_t orig_dequeue_multi;
 	odp_queue_param_t param;
 	odp_pktin_queue_t pktin;
 	odp_pktout_queue_t pktout;
 	void             *queue_lf;
 	int               spsc;
+	uint32_t          ring_slot;
 	char              name[ODP_QUEUE_NAME_LEN];
 } queue_entry_t;
 
 typedef struct queue_global_t {
 	queue_entry_t   queue[CONFIG_MAX_QUEUES];
-	uint32_t        *ring_data;
 	uint32_t        queue_lf_num;
 	uint32_t        queue_lf_size;
 	queue_lf_func_t queue_lf_func;
 	odp_shm_t       queue_gbl_shm;
-	odp_shm_t       queue_ring_shm;
+	odp_shm_t       queue_free_shm;
+
+	/* Queue ring storage is reserved in chunks when queues are created. Chunk 'i'
+	 * holds ring data of 'ring_chunk_num[i]' queues, starting from ring slot
+	 * 'ring_chunk_first[i]'. Free ring slots are stored in 'free_slot'. */
+	odp_ticketlock_t ring_chunk_lock;
+	uint32_t        num_ring_chunk;
+	uint32_t        num_ring_slot;
+	uint32_t        ring_chunk_first[CONFIG_QUEUE_RING_CHUNKS];
+	uint32_t        ring_chunk_num[CONFIG_QUEUE_RING_CHUNKS];
+	uint32_t        *ring_chunk_data[CONFIG_QUEUE_RING_CHUNKS];
+	odp_shm_t       ring_chunk_shm[CONFIG_QUEUE_RING_CHUNKS];
+	ring_u32_t      *free_slot;
+	uint32_t        free_slot_mask;
+
+	/* Indexes of free scheduled and plain queues. Queue create and destroy
+	 * take an index from / return it to these rings in constant time. */
+	ring_u32_t      *free_sched;
+	ring_u32_t      *free_plain;
+	uint32_t        free_sched_mask;
+	uint32_t        free_plain_mask;
 
 	struct {
 		uint32_t max_queue_size;
 		uint32_t default_queue_size;
 	} config;
 
+	/* Scheduled queue latency sampling rate (one per 'sched_lat_sample' enqueued
+	 * events). Set by the scheduler, zero when sampling is disabled. */
+	uint32_t        sched_lat_sample;
+
 } queue_global_t;
 
 extern queue_global_t *_odp_queue_glb;
@@ -112,10 +141,22 @@ void _odp_queue_spsc_init(queue_entry_t *queue, uint32_t queue_size);
 
 /* Functions for schedulers */
 void _odp_sched_queue_set_status(uint32_t queue_index, int status);
+/* Dequeue events from a scheduled queue. When a latency sampled event is dequeued, time it
+ * spent in the queue is written into 'lat_ns' (if not NULL). Otherwise, 'lat_ns' is not
+ * modified. */
 int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int num,
-			 int update_status);
+			 int update_status, uint64_t *lat_ns);
 int _odp_sched_queue_empty(uint32_t queue_index);
 
+/* Number of events in a scheduled queue. The value is an estimate, since other threads may
+ * enqueue concurrently. */
+static inline uint32_t _odp_sched_queue_len(uint32_t queue_index)
+{
+	queue_entry_t *queue = qentry_from_index(queue_index);
+
+	return ring_mpmc_u32_len(&queue->ring_mpmc);
+}
+
 /* Functions by schedulers */
 int _odp_sched_basic_get_spread(uint32_t queue_index);
 
@@ -84,6 +84,7 @@ static inline int cas_mo_u32(odp_atomic_u32_t *atom, uint32_t *old_val,
 #undef _RING_ENQ
 #undef _RING_ENQ_MULTI
 #undef _RING_LEN
+#undef _RING_PEEK
 
 /* Remap generic types and function names to ring data type specific ones. One
  * should never use the generic names (e.g. _RING_INIT) directly. */
@@ -99,6 +100,7 @@ static inline int cas_mo_u32(odp_atomic_u32_t *atom, uint32_t *old_val,
 	#define _RING_ENQ ring_u32_enq
 	#define _RING_ENQ_MULTI ring_u32_enq_multi
 	#define _RING_LEN ring_u32_len
+	#define _RING_PEEK ring_u32_peek
 #elif _ODP_RING_TYPE == _ODP_RING_TYPE_U64
 	#define _ring_gen_t ring_u64_t
 	#define _ring_data_t uint64_t
@@ -110,6 +112,7 @@ static inline int cas_mo_u32(odp_atomic_u32_t *atom, uint32_t *old_val,
 	#define _RING_ENQ ring_u64_enq
 	#define _RING_ENQ_MULTI ring_u64_enq_multi
 	#define _RING_LEN ring_u64_len
+	#define _RING_PEEK ring_u64_peek
 #elif _ODP_RING_TYPE == _ODP_RING_TYPE_PTR
 	#define _ring_gen_t ring_ptr_t
 	#define _ring_data_t void *
@@ -121,6 +124,7 @@ static inline int cas_mo_u32(odp_atomic_u32_t *atom, uint32_t *old_val,
 	#define _RING_ENQ ring_ptr_enq
 	#define _RING_ENQ_MULTI ring_ptr_enq_multi
 	#define _RING_LEN ring_ptr_len
+	#define _RING_PEEK ring_ptr_peek
 #endif
 
 /* Initialize ring */
@@ -318,6 +322,23 @@ static inline uint32_t _RING_LEN(_ring_gen_t *ring)
 	return tail - head;
 }
 
+/* Read data from the ring head without dequeuing it. Returns 0 when the ring
+ * is empty. The data may have been dequeued (and the slot overwritten) by
+ * the time the caller uses it, so the result is only a hint. */
+static inline uint32_t _RING_PEEK(_ring_gen_t *ring, uint32_t mask,
+				  _ring_data_t *data)
+{
+	uint32_t head = odp_atomic_load_acq_u32(&ring->r.r_head);
+	uint32_t tail = odp_atomic_load_acq_u32(&ring->r.w_tail);
+
+	if (head == tail)
+		return 0;
+
+	*data = ring->data[(head + 1) & mask];
+
+	return 1;
+}
+
 #ifdef __cplusplus
 }
 #endif
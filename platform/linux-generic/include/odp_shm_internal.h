@@ -35,7 +35,7 @@ typedef struct _odp_ishm_info_t {
 } _odp_ishm_info_t;
 
 int   _odp_ishm_reserve(const char *name, uint64_t size, int fd, uint32_t align,
-			uint64_t offset, uint32_t flags, uint32_t user_flags);
+			uint64_t offset, uint32_t flags, uint32_t user_flags, int numa_node);
 int   _odp_ishm_free_by_index(int block_index);
 int   _odp_ishm_lookup_by_name(const char *name);
 int   _odp_ishm_find_exported(const char *remote_name,
@@ -47,6 +47,18 @@ int   _odp_ishm_status(const char *title);
 int _odp_ishm_cleanup_files(const char *dirpath);
 void _odp_ishm_print(int block_index);
 
+/* Reserve shared memory preferably from a NUMA node (-1: no preference).
+ * 'ishm_flags' are internal _ODP_ISHM_* flags added to those derived from
+ * ODP_SHM_* 'flags'. */
+odp_shm_t _odp_shm_reserve(const char *name, uint64_t size, uint64_t align, uint32_t flags,
+			   int numa_node, uint32_t ishm_flags);
+
+/* NUMA node of the calling thread's CPU, or -1 if not known */
+int _odp_numa_node_current(void);
+
+/* NUMA node of the memory page at 'addr', or -1 if not known */
+int _odp_numa_node_of_addr(const void *addr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -44,6 +44,7 @@ AS_VAR_APPEND([PLAT_CFG_TEXT], ["
 	crypto:                 ${with_crypto}
 	pcap:			${have_pcap}
 	pcapng:			${have_pcapng}
+	max_sched_queues:	${with_max_sched_queues}
 	default_config_path:	${default_config_path}"])
 
 # Ignore Clang specific errors about fields with variable sized type not at the
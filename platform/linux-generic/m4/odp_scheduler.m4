@@ -8,4 +8,20 @@ AC_ARG_ENABLE([scheduler-default],
 	      [], [enable_scheduler_default=basic])
 AC_DEFINE_UNQUOTED([_ODP_SCHEDULE_DEFAULT], ["$enable_scheduler_default"],
 		   [Define to name default scheduler])
+
+##########################################################################
+# Maximum number of scheduled queues
+##########################################################################
+AC_ARG_WITH([max-sched-queues],
+	    [AS_HELP_STRING([--with-max-sched-queues=NUM],
+			    [maximum number of scheduled queues, must be a power of two ]
+			    [[default=1024] (linux-generic)])],
+	    [], [with_max_sched_queues=1024])
+AS_CASE([$with_max_sched_queues],
+	[''|*[[!0-9]]*], [AC_MSG_ERROR([bad --with-max-sched-queues value: $with_max_sched_queues])])
+AS_IF([test "$with_max_sched_queues" -eq 0 ||
+       test $(( with_max_sched_queues & (with_max_sched_queues - 1) )) -ne 0],
+      [AC_MSG_ERROR([--with-max-sched-queues value is not a power of two: $with_max_sched_queues])])
+AC_DEFINE_UNQUOTED([_ODP_CONFIG_MAX_SCHED_QUEUES], [$with_max_sched_queues],
+		   [Define to maximum number of scheduled queues])
 ]) # ODP_SCHEDULER
@@ -152,7 +152,7 @@ typedef struct ishm_fragment {
  * will allocate both a block and a fragment.
  * Blocks contain only global data common to all processes.
  */
-typedef enum {UNKNOWN, HUGE, NORMAL, EXTERNAL, CACHED} huge_flag_t;
+typedef enum {UNKNOWN, HUGE, NORMAL, EXTERNAL, CACHED, HUGE_1G} huge_flag_t;
 typedef struct ishm_block {
 	char name[ISHM_NAME_MAXLEN];    /* name for the ishm block (if any) */
 	char filename[ISHM_FILENAME_MAXLEN]; /* name of the .../odp-* file  */
@@ -168,6 +168,7 @@ typedef struct ishm_block {
 	huge_flag_t huge;	 /* page type: external means unknown here. */
 	uint64_t seq;	/* sequence number, incremented on alloc and free   */
 	uint64_t refcnt;/* number of linux processes mapping this block     */
+	int numa_node;	/* preferred NUMA node, -1 if none                  */
 } ishm_block_t;
 
 /*
@@ -182,6 +183,8 @@ typedef struct {
 	uint64_t dev_seq;	/* used when creating device names */
 	/* limit for reserving memory using huge pages */
 	uint64_t huge_page_limit;
+	/* limit for reserving memory using 1 GB huge pages (0: not used) */
+	uint64_t huge_page_1g_limit;
 	uint32_t odpthread_cnt;	/* number of running ODP threads   */
 	ishm_block_t  block[ISHM_MAX_NB_BLOCKS];
 	void *single_va_start;	/* start of single VA memory */
@@ -669,10 +672,18 @@ static int create_file(int block_index, huge_flag_t huge, uint64_t len,
 	    (!odp_global_ro.hugepage_info.default_huge_page_dir))
 		return -1;
 
+	if ((huge == HUGE_1G) &&
+	    (!odp_global_ro.hugepage_info.huge_page_1g_dir))
+		return -1;
+
 	if (huge == HUGE)
 		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s",
 			 odp_global_ro.hugepage_info.default_huge_page_dir,
 			 odp_global_ro.uid);
+	else if (huge == HUGE_1G)
+		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s",
+			 odp_global_ro.hugepage_info.huge_page_1g_dir,
+			 odp_global_ro.uid);
 	else
 		snprintf(dir, ISHM_FILENAME_MAXLEN, "%s/%s",
 			 odp_global_ro.shm_dir,
@@ -685,7 +696,7 @@ static int create_file(int block_index, huge_flag_t huge, uint64_t len,
 
 	fd = open(filename, oflag, S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
 	if (fd < 0) {
-		if (huge != HUGE)
+		if (huge != HUGE && huge != HUGE_1G)
 			_ODP_ERR("Normal page open failed: file=%s, "
 				"err=\"%s\"\n", filename, strerror(errno));
 		return -1;
@@ -700,8 +711,8 @@ static int create_file(int block_index, huge_flag_t huge, uint64_t len,
 
 		if (ret == -1) {
 			_ODP_ERR("%s memory allocation failed: fd=%d, file=%s, "
-				"err=\"%s\"\n", (huge == HUGE) ? "Huge page" :
-				"Normal page", fd, filename, strerror(errno));
+				"err=\"%s\"\n", (huge == HUGE || huge == HUGE_1G) ?
+				"Huge page" : "Normal page", fd, filename, strerror(errno));
 			close(fd);
 			unlink(filename);
 			return -1;
@@ -744,6 +755,132 @@ static void delete_file(ishm_block_t *block)
 		unlink(block->exptname);
 }
 
+/*
+ * NUMA memory policy helpers. The system calls are used directly to avoid
+ * a libnuma dependency. Memory policy is only a hint: failures are reported
+ * but do not fail the reserve.
+ */
+#define NUMA_MPOL_PREFERRED	1
+#define NUMA_MPOL_F_NODE	(1 << 0)
+#define NUMA_MPOL_F_ADDR	(1 << 1)
+#define NUMA_MAX_NODES		1024
+#define NUMA_MASK_BITS		(8 * sizeof(unsigned long))
+#define NUMA_MASK_WORDS		(NUMA_MAX_NODES / NUMA_MASK_BITS)
+
+typedef struct {
+	int mode;
+	int saved;
+	unsigned long mask[NUMA_MASK_WORDS];
+} numa_policy_t;
+
+static void numa_warn(const char *str, int node)
+{
+	static int numa_error_printed;
+
+	if (!numa_error_printed) {
+		_ODP_WARN("NUMA %s failed (node %i): %s\n", str, node, strerror(errno));
+		numa_error_printed = 1;
+	}
+}
+
+static int numa_node_mask(int node, unsigned long mask[])
+{
+	if (node < 0 || node >= NUMA_MAX_NODES)
+		return -1;
+
+	memset(mask, 0, NUMA_MASK_WORDS * sizeof(unsigned long));
+	mask[node / NUMA_MASK_BITS] = 1UL << (node % NUMA_MASK_BITS);
+
+	return 0;
+}
+
+/* Set calling thread memory policy to prefer the node. Memory allocated when
+ * creating the backing file (e.g. with fallocate()) follows this policy. */
+static void numa_policy_set(int node, numa_policy_t *old)
+{
+	unsigned long mask[NUMA_MASK_WORDS];
+
+	old->saved = 0;
+
+	if (node < 0)
+		return;
+
+	if (numa_node_mask(node, mask)) {
+		_ODP_ERR("Bad NUMA node %i\n", node);
+		return;
+	}
+
+	if (syscall(SYS_get_mempolicy, &old->mode, old->mask, NUMA_MAX_NODES, NULL, 0)) {
+		numa_warn("get_mempolicy", node);
+		return;
+	}
+
+	if (syscall(SYS_set_mempolicy, NUMA_MPOL_PREFERRED, mask, NUMA_MAX_NODES + 1)) {
+		numa_warn("set_mempolicy", node);
+		return;
+	}
+
+	old->saved = 1;
+}
+
+static void numa_policy_restore(numa_policy_t *old)
+{
+	if (!old->saved)
+		return;
+
+	if (syscall(SYS_set_mempolicy, old->mode, old->mask, NUMA_MAX_NODES + 1))
+		_ODP_ERR("Restoring memory policy failed: %s\n", strerror(errno));
+}
+
+/* Bind mapping to prefer the node. Shared memory objects keep the policy, so
+ * it applies also to pages faulted later by other threads and processes. */
+static void numa_bind(void *addr, uint64_t len, int node)
+{
+	unsigned long mask[NUMA_MASK_WORDS];
+
+	if (node < 0 || numa_node_mask(node, mask))
+		return;
+
+	if (syscall(SYS_mbind, addr, len, NUMA_MPOL_PREFERRED, mask, NUMA_MAX_NODES + 1, 0))
+		numa_warn("mbind", node);
+}
+
+int _odp_numa_node_current(void)
+{
+	unsigned int cpu, node;
+
+	if (syscall(SYS_getcpu, &cpu, &node, NULL))
+		return -1;
+
+	return node;
+}
+
+int _odp_numa_node_of_addr(const void *addr)
+{
+	int node;
+
+	if (syscall(SYS_get_mempolicy, &node, NULL, 0, addr, NUMA_MPOL_F_NODE | NUMA_MPOL_F_ADDR))
+		return -1;
+
+	return node;
+}
+
+/* Page size of a block, or 0 if not known */
+static uint64_t block_page_size(ishm_block_t *block)
+{
+	switch (block->huge) {
+	case HUGE:
+	case CACHED:
+		return odp_sys_huge_page_size();
+	case HUGE_1G:
+		return HUGE_PAGE_SIZE_1G;
+	case NORMAL:
+		return odp_sys_page_size();
+	default:
+		return 0;
+	}
+}
+
 /*
  * Performs the mapping.
  * Sets fd, and returns the mapping address. Not to be used with
@@ -830,6 +967,15 @@ static void *alloc_single_va(const char *name, int new_index, uint64_t size,
 	}
 	new_block->fragment = fragment;
 
+	/* Single VA memory is not mapped per block, lock the fragment here */
+	if ((flags & _ODP_ISHM_LOCK) && mlock(addr, len)) {
+		_ODP_ERR("mlock failed: %s\n", strerror(errno));
+		free_fragment(fragment);
+		new_block->fragment = NULL;
+		new_block->exptname[0] = 0;
+		return NULL;
+	}
+
 	/* Create export info file */
 	if (flags & _ODP_ISHM_EXPORT) {
 		uint64_t offset = (uintptr_t)addr -
@@ -1049,7 +1195,7 @@ static int block_free_internal(int block_index, int close_fd, int deregister)
  */
 int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		      uint32_t align, uint64_t offset,  uint32_t flags,
-		      uint32_t user_flags)
+		      uint32_t user_flags, int numa_node)
 {
 	int new_index;			      /* index in the main block table*/
 	ishm_block_t *new_block;	      /* entry in the main block table*/
@@ -1059,6 +1205,7 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 	uint64_t len = 0;		      /* mapped length */
 	void *addr = NULL;		      /* mapping address */
 	int new_proc_entry;
+	numa_policy_t numa_policy;
 	static int  huge_error_printed;       /* to avoid millions of error...*/
 
 	odp_spinlock_lock(&ishm_tbl->lock);
@@ -1099,6 +1246,11 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 	/* save user data: */
 	new_block->user_flags = user_flags;
 	new_block->user_len = size;
+	new_block->numa_node = numa_node;
+
+	/* Memory is allocated from the preferred node when backing files are
+	 * created */
+	numa_policy_set(numa_node, &numa_policy);
 
 	/* If a file descriptor is provided, get the real size and map: */
 	if (fd >= 0) {
@@ -1109,6 +1261,7 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		addr = do_map(new_index, len, align, offset, flags, EXTERNAL,
 			      &fd);
 		if (addr == NULL) {
+			numa_policy_restore(&numa_policy);
 			odp_spinlock_unlock(&ishm_tbl->lock);
 			_ODP_ERR("_ishm_reserve failed.\n");
 			return -1;
@@ -1119,6 +1272,23 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		new_block->huge = UNKNOWN;
 	}
 
+	/* Large reservations try 1 GB huge pages first. Single VA memory is
+	 * mapped from default size pages, so 1 GB pages cannot be used for
+	 * those blocks. */
+	if ((fd < 0) && !(user_flags & ODP_SHM_NO_HP) && !(flags & _ODP_ISHM_SINGLE_VA) &&
+	    ishm_tbl->huge_page_1g_limit && size > ishm_tbl->huge_page_1g_limit &&
+	    odp_global_ro.hugepage_info.huge_page_1g_dir && align <= HUGE_PAGE_SIZE_1G) {
+		len = (size + (HUGE_PAGE_SIZE_1G - 1)) & (-HUGE_PAGE_SIZE_1G);
+
+		addr = do_map(new_index, len, HUGE_PAGE_SIZE_1G, 0, flags, HUGE_1G, &fd);
+
+		if (addr == NULL)
+			_ODP_DBG("No 1 GB huge pages for '%s', trying smaller pages\n",
+				 name ? name : "");
+		else
+			new_block->huge = HUGE_1G;
+	}
+
 	/* Otherwise, Try first huge pages when possible and needed: */
 	if ((fd < 0) && page_hp_size && ((user_flags &  ODP_SHM_HP) ||
 					 size > ishm_tbl->huge_page_limit)) {
@@ -1139,8 +1309,9 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 		/* roundup to page size */
 		len = (size + (page_hp_size - 1)) & (-page_hp_size);
 
-		/* try pre-allocated pages */
-		fd = hp_get_cached(len);
+		/* try pre-allocated pages. Those are on an unknown node. */
+		if (numa_node < 0)
+			fd = hp_get_cached(len);
 		if (fd != -1) {
 			/* do as if user provided a fd */
 			new_block->external_fd = 1;
@@ -1173,6 +1344,7 @@ int _odp_ishm_reserve(const char *name, uint64_t size, int fd,
 	/* Try normal pages if huge pages failed */
 	if (fd < 0) {
 		if (user_flags & ODP_SHM_HP) {
+			numa_policy_restore(&numa_policy);
 			odp_spinlock_unlock(&ishm_tbl->lock);
 			_ODP_ERR("Unable to allocate memory from huge pages\n");
 			return -1;
@@ -1202,6 +1374,8 @@ use_single_va:
 		addr = alloc_single_va(name, new_index, size, align, flags, &fd,
 				       &len);
 
+	numa_policy_restore(&numa_policy);
+
 	/* if neither huge pages or normal pages works, we cannot proceed: */
 	if ((fd < 0) || (addr == NULL) || (len == 0)) {
 		if (new_block->external_fd) {
@@ -1216,6 +1390,9 @@ use_single_va:
 		return -1;
 	}
 
+	if (numa_node >= 0 && new_block->huge != EXTERNAL)
+		numa_bind(addr, len, numa_node);
+
 	/* remember block data and increment block seq number to mark change */
 	new_block->len = len;
 	new_block->user_len = size;
@@ -1382,7 +1559,7 @@ int _odp_ishm_find_exported(const char *remote_name, pid_t external_odp_pid,
 
 	/* reserve the memory, providing the opened file descriptor: */
 	block_index = _odp_ishm_reserve(local_name, len, fd, align, offset,
-					flags, 0);
+					flags, 0, -1);
 	if (block_index < 0) {
 		close(fd);
 		return block_index;
@@ -1554,8 +1731,9 @@ int _odp_ishm_info(int block_index, _odp_ishm_info_t *info)
 	info->name	 = ishm_tbl->block[block_index].name;
 	info->addr	 = ishm_proctable->entry[proc_index].start;
 	info->size	 = ishm_tbl->block[block_index].user_len;
-	info->page_size  = (ishm_tbl->block[block_index].huge == HUGE) ?
-			   odp_sys_huge_page_size() : odp_sys_page_size();
+	info->page_size  = block_page_size(&ishm_tbl->block[block_index]);
+	if (info->page_size == 0)
+		info->page_size = odp_sys_page_size();
 	info->flags	 = ishm_tbl->block[block_index].flags;
 	info->user_flags = ishm_tbl->block[block_index].user_flags;
 
@@ -1663,6 +1841,7 @@ int _odp_ishm_init_global(const odp_init_t *init)
 	uint64_t max_memory;
 	uint64_t internal;
 	uint64_t huge_page_limit;
+	uint64_t huge_page_1g_limit;
 
 	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "single_va_size_kb",
 					   &val_kb)) {
@@ -1684,6 +1863,15 @@ int _odp_ishm_init_global(const odp_init_t *init)
 
 	_ODP_DBG("Shm huge page usage limit: %dkB\n", val_kb);
 
+	if (!_odp_libconfig_lookup_ext_int("shm", NULL, "huge_page_1g_limit_kb",
+					   &val_kb)) {
+		_ODP_ERR("Unable to read 1 GB huge page usage limit from config\n");
+		return -1;
+	}
+	huge_page_1g_limit = val_kb > 0 ? (uint64_t)val_kb * 1024 : 0;
+
+	_ODP_DBG("Shm 1 GB huge page usage limit: %dkB\n", val_kb);
+
 	/* user requested memory size + some extra for internal use */
 	if (init && init->shm.max_memory)
 		max_memory = init->shm.max_memory + internal;
@@ -1721,6 +1909,12 @@ int _odp_ishm_init_global(const odp_init_t *init)
 		_odp_ishm_cleanup_files(hp_dir);
 	}
 
+	if (odp_global_ro.hugepage_info.huge_page_1g_dir) {
+		_ODP_DBG("1 GB huge pages mount point is: %s\n",
+			 odp_global_ro.hugepage_info.huge_page_1g_dir);
+		_odp_ishm_cleanup_files(odp_global_ro.hugepage_info.huge_page_1g_dir);
+	}
+
 	_odp_ishm_cleanup_files(odp_global_ro.shm_dir);
 
 	/* allocate space for the internal shared mem block table: */
@@ -1735,6 +1929,7 @@ int _odp_ishm_init_global(const odp_init_t *init)
 	ishm_tbl->dev_seq = 0;
 	ishm_tbl->odpthread_cnt = 0;
 	ishm_tbl->huge_page_limit = huge_page_limit;
+	ishm_tbl->huge_page_1g_limit = huge_page_1g_limit;
 	odp_spinlock_init(&ishm_tbl->lock);
 
 	/* allocate space for the internal shared mem fragment table: */
@@ -2024,6 +2219,9 @@ int _odp_ishm_status(const char *title)
 		case CACHED:
 			huge = 'C';
 			break;
+		case HUGE_1G:
+			huge = 'G';
+			break;
 		default:
 			huge = '?';
 		}
@@ -2161,11 +2359,15 @@ void _odp_ishm_print(int block_index)
 	case CACHED:
 		str = "cached";
 		break;
+	case HUGE_1G:
+		str = "huge 1G";
+		break;
 	default:
 		str = "??";
 	}
 
 	_ODP_PRINT(" page type:  %s\n", str);
+	_ODP_PRINT(" numa node:  %i\n", block->numa_node);
 	_ODP_PRINT(" seq:        %" PRIu64 "\n", block->seq);
 	_ODP_PRINT(" refcnt:     %" PRIu64 "\n", block->refcnt);
 	_ODP_PRINT("\n");
@@ -2217,6 +2419,8 @@ int32_t odp_system_meminfo(odp_system_meminfo_t *info, odp_system_memblock_t mem
 			page_size = 0;
 			if (block->huge == HUGE)
 				page_size = huge_sz;
+			else if (block->huge == HUGE_1G)
+				page_size = HUGE_PAGE_SIZE_1G;
 			else if (block->huge == NORMAL)
 				page_size = normal_sz;
 
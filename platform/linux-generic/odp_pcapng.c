@@ -518,14 +518,13 @@ static ssize_t write_fifo(int fd, struct iovec *iov, int iovcnt)
 {
 	ssize_t len = 0;
 
-	len = writev(fd, iov, iovcnt);
 	/*
 	 * we don't care if a writev fails, we asynchronously read the fifo
 	 * so the next block of packets might be successful. This error only
-	 * means that some packets failed to append on the pcap file
+	 * means that some packets failed to append on the pcap file. No
+	 * fsync() here, it does nothing for a fifo but costs a system call.
 	 */
-	if (len > 0)
-		fsync(fd);
+	len = writev(fd, iov, iovcnt);
 
 	return len;
 }
@@ -61,10 +61,15 @@ ODP_STATIC_ASSERT(CONFIG_PACKET_SEG_LEN_MIN >= 256,
 ODP_STATIC_ASSERT(CONFIG_PACKET_SEG_SIZE < 0xffff,
 		  "Segment size must be less than 64k (16 bit offsets)");
 
+/* Directions of transfers between thread local cache and global pool */
+#define CACHE_REFILL 1
+#define CACHE_FLUSH  2
+
 /* Thread local variables */
 typedef struct pool_local_t {
 	pool_cache_t *cache[ODP_CONFIG_POOLS];
 	int thr_id;
+	int numa_node;
 
 } pool_local_t;
 
@@ -127,17 +132,97 @@ static inline void cache_push(pool_cache_t *cache, _odp_event_hdr_t *event_hdr[]
 	odp_atomic_store_u32(&cache->cache_num, cache_num + num);
 }
 
+/* Select the number of events to transfer between local cache and global pool.
+ * Consecutive transfers to the same direction mean that the thread mainly
+ * allocates (or frees) events. The transfer size is then doubled up to the
+ * cache size, so that the thread accesses the global pool less often. A change
+ * of direction resets the transfer size to the configured burst size. */
+static inline uint32_t cache_burst(pool_t *pool, pool_cache_t *cache, uint8_t dir)
+{
+	uint32_t burst = pool->burst_size;
+
+	if (!pool->burst_adapt)
+		return burst;
+
+	if (cache->burst_dir == dir) {
+		burst = 2 * cache->burst;
+
+		if (burst > pool->cache_size)
+			burst = pool->cache_size;
+		if (burst < pool->burst_size)
+			burst = pool->burst_size;
+	}
+
+	cache->burst     = burst;
+	cache->burst_dir = dir;
+
+	return burst;
+}
+
+static inline void stat_inc(odp_atomic_u64_t *stat)
+{
+	/* Thread local counter, no need for an atomic read-modify-write */
+	odp_atomic_store_u64(stat, odp_atomic_load_u64(stat) + 1);
+}
+
+static inline void in_use_add(pool_t *pool, uint32_t num)
+{
+	uint64_t in_use = odp_atomic_fetch_add_u64(&pool->stats.in_use, num) + num;
+
+	odp_atomic_max_u64(&pool->stats.max_in_use, in_use);
+}
+
+static inline void in_use_sub(pool_t *pool, uint32_t num)
+{
+	odp_atomic_sub_u64(&pool->stats.in_use, num);
+}
+
 static void cache_flush(pool_cache_t *cache, pool_t *pool)
 {
 	_odp_event_hdr_t *event_hdr;
 	ring_ptr_t *ring;
 	uint32_t mask;
+	uint32_t num = 0;
 
 	ring = &pool->ring->hdr;
 	mask = pool->ring_mask;
 
-	while (cache_pop(cache, &event_hdr, 1))
+	while (cache_pop(cache, &event_hdr, 1)) {
 		ring_ptr_enq(ring, mask, event_hdr);
+		num++;
+	}
+
+	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.max_in_use && num)
+		in_use_sub(pool, num);
+}
+
+static void cache_stats_init(pool_cache_t *cache)
+{
+	odp_atomic_init_u64(&cache->stats.alloc_ops, 0);
+	odp_atomic_init_u64(&cache->stats.alloc_fails, 0);
+	odp_atomic_init_u64(&cache->stats.free_ops, 0);
+	odp_atomic_init_u64(&cache->stats.cache_alloc_ops, 0);
+	odp_atomic_init_u64(&cache->stats.cache_free_ops, 0);
+	odp_atomic_init_u64(&cache->stats.remote_alloc_ops, 0);
+	odp_atomic_init_u64(&cache->stats.global_ops, 0);
+}
+
+/* Sum up per thread statistics counters */
+static void cache_stats_sum(pool_t *pool, odp_pool_stats_selected_t *sum)
+{
+	memset(sum, 0, sizeof(odp_pool_stats_selected_t));
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++) {
+		pool_cache_t *cache = &pool->local_cache[i];
+
+		sum->alloc_ops        += odp_atomic_load_u64(&cache->stats.alloc_ops);
+		sum->alloc_fails      += odp_atomic_load_u64(&cache->stats.alloc_fails);
+		sum->free_ops         += odp_atomic_load_u64(&cache->stats.free_ops);
+		sum->cache_alloc_ops  += odp_atomic_load_u64(&cache->stats.cache_alloc_ops);
+		sum->cache_free_ops   += odp_atomic_load_u64(&cache->stats.cache_free_ops);
+		sum->remote_alloc_ops += odp_atomic_load_u64(&cache->stats.remote_alloc_ops);
+		sum->global_ops       += odp_atomic_load_u64(&cache->stats.global_ops);
+	}
 }
 
 static inline int cache_available(pool_t *pool, odp_pool_stats_t *stats)
@@ -235,6 +320,24 @@ static int read_config_file(pool_global_t *pool_glb)
 		return -1;
 	}
 
+	str = "pool.burst_adapt";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pool_glb->config.burst_adapt = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "pool.lock_mem";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pool_glb->config.lock_mem = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "pool.pkt.max_num";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -281,6 +384,15 @@ static int read_config_file(pool_global_t *pool_glb)
 	pool_glb->config.pkt_base_align = align;
 	_ODP_PRINT("  %s: %u\n", str, align);
 
+	str = "pool.pkt.cache_color";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	pool_glb->config.pkt_cache_color = !!val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "pool.buf.min_align";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -392,6 +504,7 @@ int _odp_pool_init_local(void)
 	}
 
 	local.thr_id = thr_id;
+	local.numa_node = _odp_numa_node_current();
 	return 0;
 }
 
@@ -408,7 +521,14 @@ int _odp_pool_term_local(void)
 	return 0;
 }
 
-static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
+/* Internal shm flags for pool memory reservations */
+static inline uint32_t pool_ishm_flags(void)
+{
+	/* Locking keeps pre-faulted pool memory resident */
+	return _odp_pool_glb->config.lock_mem ? _ODP_ISHM_LOCK : 0;
+}
+
+static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num, int numa_node)
 {
 	int i;
 	odp_shm_t shm;
@@ -433,7 +553,8 @@ static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
 			if (pool_ext)
 				mem_size += num * sizeof(_odp_event_hdr_t *);
 
-			shm = odp_shm_reserve(ring_name, mem_size, ODP_CACHE_LINE_SIZE, shmflags);
+			shm = _odp_shm_reserve(ring_name, mem_size, ODP_CACHE_LINE_SIZE, shmflags,
+					       numa_node, pool_ishm_flags());
 
 			if (odp_unlikely(shm == ODP_SHM_INVALID)) {
 				_ODP_ERR("Unable to alloc pool ring %d\n", i);
@@ -446,6 +567,8 @@ static pool_t *reserve_pool(uint32_t shmflags, uint8_t pool_ext, uint32_t num)
 			pool->ring_shm = shm;
 			pool->ring = odp_shm_addr(shm);
 			pool->pool_ext = pool_ext;
+			pool->numa_node = numa_node;
+			pool->mem_numa_node = -1;
 
 			return pool;
 		}
@@ -646,6 +769,7 @@ static void set_pool_cache_size(pool_t *pool, uint32_t cache_size)
 
 	pool->cache_size = 0;
 	pool->burst_size = 1;
+	pool->burst_adapt = 0;
 
 	if (cache_size > 1) {
 		cache_size = (cache_size / 2) * 2;
@@ -656,6 +780,7 @@ static void set_pool_cache_size(pool_t *pool, uint32_t cache_size)
 
 		pool->cache_size = cache_size;
 		pool->burst_size = burst_size;
+		pool->burst_adapt = _odp_pool_glb->config.burst_adapt;
 	}
 }
 
@@ -681,7 +806,8 @@ static int reserve_uarea(pool_t *pool, uint32_t uarea_size, uint32_t num_pkt, ui
 	pool->uarea_size       = _ODP_ROUNDUP_CACHE_LINE(uarea_size);
 	pool->uarea_shm_size   = num_pkt * (uint64_t)pool->uarea_size;
 
-	shm = odp_shm_reserve(uarea_name, pool->uarea_shm_size, ODP_PAGE_SIZE, shmflags);
+	shm = _odp_shm_reserve(uarea_name, pool->uarea_shm_size, ODP_PAGE_SIZE, shmflags,
+			       pool->numa_node, pool_ishm_flags());
 
 	if (shm == ODP_SHM_INVALID)
 		return -1;
@@ -844,7 +970,7 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 		return ODP_POOL_INVALID;
 	}
 
-	pool = reserve_pool(shmflags, 0, num);
+	pool = reserve_pool(shmflags, 0, num, params->numa_node);
 
 	if (pool == NULL) {
 		_ODP_ERR("No more free pools\n");
@@ -879,10 +1005,17 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 			}
 		}
 
-		if (adj_size != block_size)
+		if (adj_size != block_size) {
 			block_size = adj_size;
-		else
+		} else {
 			block_size = _ODP_ROUNDUP_CACHE_LINE(block_size);
+
+			/* With an odd number of cache lines per block, start addresses of
+			 * consecutive blocks rotate through all cache sets */
+			if (_odp_pool_glb->config.pkt_cache_color &&
+			    (block_size / ODP_CACHE_LINE_SIZE) % 2 == 0)
+				block_size += ODP_CACHE_LINE_SIZE;
+		}
 	} else {
 		/* Header size is rounded up to cache line size, so the
 		 * following data can be cache line aligned without extra
@@ -929,8 +1062,8 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 
 	set_pool_cache_size(pool, cache_size);
 
-	shm = odp_shm_reserve(shm_name, pool->shm_size, ODP_PAGE_SIZE,
-			      shmflags);
+	shm = _odp_shm_reserve(shm_name, pool->shm_size, ODP_PAGE_SIZE, shmflags,
+			       pool->numa_node, pool_ishm_flags());
 
 	pool->shm = shm;
 
@@ -952,6 +1085,9 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 	ring_ptr_init(&pool->ring->hdr);
 	init_buffers(pool);
 
+	/* Buffers have been touched, so pool memory has been allocated */
+	pool->mem_numa_node = _odp_numa_node_of_addr(pool->base_addr);
+
 	if (type == ODP_POOL_PACKET && pool->mem_src_ops && pool->mem_src_ops->bind &&
 	    pool->mem_src_ops->bind(pool->mem_src_data, pool)) {
 		_ODP_ERR("Binding pool as memory source failed\n");
@@ -965,11 +1101,11 @@ odp_pool_t _odp_pool_create(const char *name, const odp_pool_param_t *params,
 	}
 
 	/* Reset pool stats */
-	odp_atomic_init_u64(&pool->stats.alloc_ops, 0);
-	odp_atomic_init_u64(&pool->stats.alloc_fails, 0);
-	odp_atomic_init_u64(&pool->stats.free_ops, 0);
-	odp_atomic_init_u64(&pool->stats.cache_alloc_ops, 0);
-	odp_atomic_init_u64(&pool->stats.cache_free_ops, 0);
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		cache_stats_init(&pool->local_cache[i]);
+
+	odp_atomic_init_u64(&pool->stats.in_use, 0);
+	odp_atomic_init_u64(&pool->stats.max_in_use, 0);
 
 	return _odp_pool_handle(pool);
 
@@ -1002,6 +1138,11 @@ static int check_params(const odp_pool_param_t *params)
 	if (num_threads < cur_threads)
 		num_threads = cur_threads;
 
+	if (params->numa_node < -1) {
+		_ODP_ERR("Bad NUMA node %i\n", params->numa_node);
+		return -1;
+	}
+
 	switch (params->type) {
 	case ODP_POOL_BUFFER:
 		num = params->buf.num;
@@ -1262,21 +1403,20 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 	_odp_event_hdr_t *hdr;
 	uint32_t mask, num_ch, num_alloc, i;
 	uint32_t num_deq = 0;
-	uint32_t burst_size = pool->burst_size;
 
 	/* First pull packets from local cache */
 	num_ch = cache_pop(cache, event_hdr, max_num);
 
 	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_alloc_ops && num_ch)
-		odp_atomic_inc_u64(&pool->stats.cache_alloc_ops);
+		stat_inc(&cache->stats.cache_alloc_ops);
 
 	/* If needed, get more from the global pool */
 	if (odp_unlikely(num_ch != (uint32_t)max_num)) {
-		uint32_t burst = burst_size;
+		uint32_t burst = cache_burst(pool, cache, CACHE_REFILL);
 		uint32_t cache_num;
 
 		num_deq = max_num - num_ch;
-		if (odp_unlikely(num_deq > burst_size))
+		if (odp_unlikely(num_deq > burst))
 			burst = num_deq;
 
 		_odp_event_hdr_t *hdr_tmp[burst];
@@ -1289,9 +1429,16 @@ int _odp_event_alloc_multi(pool_t *pool, _odp_event_hdr_t *event_hdr[], int max_
 
 		if (CONFIG_POOL_STATISTICS) {
 			if (pool->params.stats.bit.alloc_ops)
-				odp_atomic_inc_u64(&pool->stats.alloc_ops);
+				stat_inc(&cache->stats.alloc_ops);
 			if (odp_unlikely(pool->params.stats.bit.alloc_fails && burst == 0))
-				odp_atomic_inc_u64(&pool->stats.alloc_fails);
+				stat_inc(&cache->stats.alloc_fails);
+			if (pool->params.stats.bit.remote_alloc_ops && local.numa_node >= 0 &&
+			    pool->mem_numa_node >= 0 && local.numa_node != pool->mem_numa_node)
+				stat_inc(&cache->stats.remote_alloc_ops);
+			if (pool->params.stats.bit.global_ops)
+				stat_inc(&cache->stats.global_ops);
+			if (pool->params.stats.bit.max_in_use && burst)
+				in_use_add(pool, burst);
 		}
 
 		if (odp_unlikely(burst < num_deq)) {
@@ -1334,8 +1481,14 @@ static inline void event_free_to_pool(pool_t *pool,
 
 		ring_ptr_enq_multi(ring, mask, (void **)event_hdr, num);
 
-		if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.free_ops)
-			odp_atomic_inc_u64(&pool->stats.free_ops);
+		if (CONFIG_POOL_STATISTICS) {
+			if (pool->params.stats.bit.free_ops)
+				stat_inc(&cache->stats.free_ops);
+			if (pool->params.stats.bit.global_ops)
+				stat_inc(&cache->stats.global_ops);
+			if (pool->params.stats.bit.max_in_use)
+				in_use_sub(pool, num);
+		}
 
 		return;
 	}
@@ -1345,14 +1498,14 @@ static inline void event_free_to_pool(pool_t *pool,
 	cache_num = odp_atomic_load_u32(&cache->cache_num);
 
 	if (odp_unlikely((int)(cache_size - cache_num) < num)) {
-		int burst = pool->burst_size;
+		int burst = cache_burst(pool, cache, CACHE_FLUSH);
 
 		ring  = &pool->ring->hdr;
 		mask  = pool->ring_mask;
 
 		if (odp_unlikely(num > burst))
 			burst = num;
-		if (odp_unlikely((uint32_t)num > cache_num))
+		if (odp_unlikely((uint32_t)burst > cache_num))
 			burst = cache_num;
 
 		_odp_event_hdr_t *event_hdr[burst];
@@ -1360,13 +1513,20 @@ static inline void event_free_to_pool(pool_t *pool,
 		cache_pop(cache, event_hdr, burst);
 
 		ring_ptr_enq_multi(ring, mask, (void **)event_hdr, burst);
-		if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.free_ops)
-			odp_atomic_inc_u64(&pool->stats.free_ops);
+
+		if (CONFIG_POOL_STATISTICS) {
+			if (pool->params.stats.bit.free_ops)
+				stat_inc(&cache->stats.free_ops);
+			if (pool->params.stats.bit.global_ops)
+				stat_inc(&cache->stats.global_ops);
+			if (pool->params.stats.bit.max_in_use && burst)
+				in_use_sub(pool, burst);
+		}
 	}
 
 	cache_push(cache, event_hdr, num);
 	if (CONFIG_POOL_STATISTICS && pool->params.stats.bit.cache_free_ops)
-		odp_atomic_inc_u64(&pool->stats.cache_free_ops);
+		stat_inc(&cache->stats.cache_free_ops);
 }
 
 void _odp_event_free_multi(_odp_event_hdr_t *event_hdr[], int num_total)
@@ -1480,6 +1640,9 @@ int odp_pool_capability(odp_pool_capability_t *capa)
 	supported_stats.bit.cache_alloc_ops = CONFIG_POOL_STATISTICS;
 	supported_stats.bit.cache_free_ops = CONFIG_POOL_STATISTICS;
 	supported_stats.bit.thread_cache_available = 1;
+	supported_stats.bit.remote_alloc_ops = CONFIG_POOL_STATISTICS;
+	supported_stats.bit.global_ops = CONFIG_POOL_STATISTICS;
+	supported_stats.bit.max_in_use = CONFIG_POOL_STATISTICS;
 
 	/* Buffer pools */
 	capa->buf.max_pools = max_pools;
@@ -1595,6 +1758,8 @@ void odp_pool_print(odp_pool_t pool_hdl)
 	_ODP_PRINT("  uarea base addr %p\n", (void *)pool->uarea_base_addr);
 	_ODP_PRINT("  cache size      %u\n", pool->cache_size);
 	_ODP_PRINT("  burst size      %u\n", pool->burst_size);
+	_ODP_PRINT("  burst adapt     %u\n", pool->burst_adapt);
+	_ODP_PRINT("  numa node       %i (requested %i)\n", pool->mem_numa_node, pool->numa_node);
 	_ODP_PRINT("  mem src         %s\n",
 		   pool->mem_src_ops ? pool->mem_src_ops->name : "(none)");
 	_ODP_PRINT("  event valid.    %d\n", _ODP_EVENT_VALIDATION);
@@ -1657,6 +1822,7 @@ void odp_pool_param_init(odp_pool_param_t *params)
 	params->pkt.cache_size = default_cache_size;
 	params->tmo.cache_size = default_cache_size;
 	params->vector.cache_size = default_cache_size;
+	params->numa_node = -1;
 }
 
 uint64_t odp_pool_to_u64(odp_pool_t hdl)
@@ -1672,6 +1838,7 @@ unsigned int odp_pool_max_index(void)
 int odp_pool_stats(odp_pool_t pool_hdl, odp_pool_stats_t *stats)
 {
 	pool_t *pool;
+	odp_pool_stats_selected_t sum;
 	uint16_t first, last;
 
 	if (odp_unlikely(pool_hdl == ODP_POOL_INVALID)) {
@@ -1696,14 +1863,16 @@ int odp_pool_stats(odp_pool_t pool_hdl, odp_pool_stats_t *stats)
 	if (pool->params.stats.bit.available)
 		stats->available = ring_ptr_len(&pool->ring->hdr);
 
+	cache_stats_sum(pool, &sum);
+
 	if (pool->params.stats.bit.alloc_ops)
-		stats->alloc_ops = odp_atomic_load_u64(&pool->stats.alloc_ops);
+		stats->alloc_ops = sum.alloc_ops;
 
 	if (pool->params.stats.bit.alloc_fails)
-		stats->alloc_fails = odp_atomic_load_u64(&pool->stats.alloc_fails);
+		stats->alloc_fails = sum.alloc_fails;
 
 	if (pool->params.stats.bit.free_ops)
-		stats->free_ops = odp_atomic_load_u64(&pool->stats.free_ops);
+		stats->free_ops = sum.free_ops;
 
 	if (pool->params.stats.bit.total_ops)
 		stats->total_ops = stats->alloc_ops + stats->free_ops;
@@ -1715,10 +1884,19 @@ int odp_pool_stats(odp_pool_t pool_hdl, odp_pool_stats_t *stats)
 	}
 
 	if (pool->params.stats.bit.cache_alloc_ops)
-		stats->cache_alloc_ops = odp_atomic_load_u64(&pool->stats.cache_alloc_ops);
+		stats->cache_alloc_ops = sum.cache_alloc_ops;
 
 	if (pool->params.stats.bit.cache_free_ops)
-		stats->cache_free_ops = odp_atomic_load_u64(&pool->stats.cache_free_ops);
+		stats->cache_free_ops = sum.cache_free_ops;
+
+	if (pool->params.stats.bit.remote_alloc_ops)
+		stats->remote_alloc_ops = sum.remote_alloc_ops;
+
+	if (pool->params.stats.bit.global_ops)
+		stats->global_ops = sum.global_ops;
+
+	if (pool->params.stats.bit.max_in_use)
+		stats->max_in_use = odp_atomic_load_u64(&pool->stats.max_in_use);
 
 	return 0;
 }
@@ -1727,6 +1905,7 @@ int odp_pool_stats_selected(odp_pool_t pool_hdl, odp_pool_stats_selected_t *stat
 			    const odp_pool_stats_opt_t *opt)
 {
 	pool_t *pool;
+	odp_pool_stats_selected_t sum;
 
 	if (odp_unlikely(pool_hdl == ODP_POOL_INVALID)) {
 		_ODP_ERR("Invalid pool handle\n");
@@ -1751,14 +1930,16 @@ int odp_pool_stats_selected(odp_pool_t pool_hdl, odp_pool_stats_selected_t *stat
 	if (opt->bit.available)
 		stats->available = ring_ptr_len(&pool->ring->hdr);
 
+	cache_stats_sum(pool, &sum);
+
 	if (opt->bit.alloc_ops || opt->bit.total_ops)
-		stats->alloc_ops = odp_atomic_load_u64(&pool->stats.alloc_ops);
+		stats->alloc_ops = sum.alloc_ops;
 
 	if (opt->bit.alloc_fails)
-		stats->alloc_fails = odp_atomic_load_u64(&pool->stats.alloc_fails);
+		stats->alloc_fails = sum.alloc_fails;
 
 	if (opt->bit.free_ops || opt->bit.total_ops)
-		stats->free_ops = odp_atomic_load_u64(&pool->stats.free_ops);
+		stats->free_ops = sum.free_ops;
 
 	if (opt->bit.total_ops)
 		stats->total_ops = stats->alloc_ops + stats->free_ops;
@@ -1767,10 +1948,19 @@ int odp_pool_stats_selected(odp_pool_t pool_hdl, odp_pool_stats_selected_t *stat
 		stats->cache_available = cache_total_available(pool);
 
 	if (opt->bit.cache_alloc_ops)
-		stats->cache_alloc_ops = odp_atomic_load_u64(&pool->stats.cache_alloc_ops);
+		stats->cache_alloc_ops = sum.cache_alloc_ops;
 
 	if (opt->bit.cache_free_ops)
-		stats->cache_free_ops = odp_atomic_load_u64(&pool->stats.cache_free_ops);
+		stats->cache_free_ops = sum.cache_free_ops;
+
+	if (opt->bit.remote_alloc_ops)
+		stats->remote_alloc_ops = sum.remote_alloc_ops;
+
+	if (opt->bit.global_ops)
+		stats->global_ops = sum.global_ops;
+
+	if (opt->bit.max_in_use)
+		stats->max_in_use = odp_atomic_load_u64(&pool->stats.max_in_use);
 
 	return 0;
 }
@@ -1786,11 +1976,12 @@ int odp_pool_stats_reset(odp_pool_t pool_hdl)
 
 	pool = _odp_pool_entry(pool_hdl);
 
-	odp_atomic_store_u64(&pool->stats.alloc_ops, 0);
-	odp_atomic_store_u64(&pool->stats.alloc_fails, 0);
-	odp_atomic_store_u64(&pool->stats.free_ops, 0);
-	odp_atomic_store_u64(&pool->stats.cache_alloc_ops, 0);
-	odp_atomic_store_u64(&pool->stats.cache_free_ops, 0);
+	/* Counters updated concurrently by other threads may miss the reset */
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX; i++)
+		cache_stats_init(&pool->local_cache[i]);
+
+	odp_atomic_store_u64(&pool->stats.max_in_use,
+			     odp_atomic_load_u64(&pool->stats.in_use));
 
 	return 0;
 }
@@ -1984,7 +2175,7 @@ odp_pool_t odp_pool_ext_create(const char *name, const odp_pool_ext_param_t *par
 	if (odp_global_ro.shm_single_va)
 		shm_flags |= ODP_SHM_SINGLE_VA;
 
-	pool = reserve_pool(shm_flags, 1, num_buf);
+	pool = reserve_pool(shm_flags, 1, num_buf, -1);
 
 	if (pool == NULL) {
 		_ODP_ERR("No more free pools\n");
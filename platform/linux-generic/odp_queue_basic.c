@@ -14,11 +14,13 @@
 #include <odp/api/std_types.h>
 #include <odp/api/sync.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/time.h>
 #include <odp/api/traffic_mngr.h>
 
 #include <odp/api/plat/queue_inline_types.h>
 #include <odp/api/plat/sync_inlines.h>
 #include <odp/api/plat/ticketlock_inlines.h>
+#include <odp/api/plat/time_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
@@ -35,15 +37,35 @@
 #include <odp_timer_internal.h>
 
 #include <inttypes.h>
+#include <stdio.h>
 #include <string.h>
 
 #define LOCK(queue_ptr)      odp_ticketlock_lock(&((queue_ptr)->lock))
 #define UNLOCK(queue_ptr)    odp_ticketlock_unlock(&((queue_ptr)->lock))
 #define LOCK_INIT(queue_ptr) odp_ticketlock_init(&((queue_ptr)->lock))
 
+/* Scheduler latency sample states */
+#define LAT_SAMPLE_FREE    0
+#define LAT_SAMPLE_CLAIMED 1
+#define LAT_SAMPLE_ARMED   2
+
 #define MIN_QUEUE_SIZE 32
 #define MAX_QUEUE_SIZE (1 * 1024 * 1024)
 
+/* Number of queues in the first ring storage chunk. Each following chunk is
+ * twice as large as the previous one. */
+#define RING_CHUNK_BASE 64
+
+/* Queue has no ring storage slot */
+#define RING_SLOT_NONE UINT32_MAX
+
+ODP_STATIC_ASSERT(CONFIG_MAX_QUEUES <=
+		  (uint64_t)RING_CHUNK_BASE * ((1ull << CONFIG_QUEUE_RING_CHUNKS) - 1),
+		  "Too few queue ring storage chunks");
+
+/* Number of events enqueued since the previous scheduler latency sample */
+static __thread uint32_t lat_sample_cnt;
+
 static int queue_init(queue_entry_t *queue, const char *name,
 		      const odp_queue_param_t *param);
 
@@ -110,6 +132,151 @@ static int read_config_file(queue_global_t *_odp_queue_glb)
 	return 0;
 }
 
+static int free_ring_init(queue_global_t *glb)
+{
+	uint32_t i, sched_size, plain_size, slot_size;
+	uint64_t sched_bytes, plain_bytes, slot_bytes;
+	uint8_t *base;
+	odp_shm_t shm;
+
+	/* Ring size must be larger than the number of stored indexes */
+	sched_size = _ODP_ROUNDUP_POWER2_U32(CONFIG_MAX_SCHED_QUEUES + 1);
+	plain_size = _ODP_ROUNDUP_POWER2_U32(CONFIG_MAX_QUEUES - CONFIG_MAX_SCHED_QUEUES + 1);
+	slot_size  = _ODP_ROUNDUP_POWER2_U32(CONFIG_MAX_QUEUES + 1);
+	sched_bytes = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_u32_t) + sched_size * sizeof(uint32_t));
+	plain_bytes = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_u32_t) + plain_size * sizeof(uint32_t));
+	slot_bytes  = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_u32_t) + slot_size * sizeof(uint32_t));
+
+	shm = odp_shm_reserve("_odp_queue_basic_free", sched_bytes + plain_bytes + slot_bytes,
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID)
+		return -1;
+
+	base = odp_shm_addr(shm);
+	glb->queue_free_shm  = shm;
+	glb->free_sched      = (ring_u32_t *)(uintptr_t)base;
+	glb->free_plain      = (ring_u32_t *)(uintptr_t)(base + sched_bytes);
+	glb->free_slot       = (ring_u32_t *)(uintptr_t)(base + sched_bytes + plain_bytes);
+	glb->free_sched_mask = sched_size - 1;
+	glb->free_plain_mask = plain_size - 1;
+	glb->free_slot_mask  = slot_size - 1;
+
+	ring_u32_init(glb->free_sched);
+	ring_u32_init(glb->free_plain);
+	ring_u32_init(glb->free_slot);
+
+	/* Scheduled queue indices start from zero to enable direct mapping to
+	 * scheduler implementation indices. All internal queues are of type
+	 * plain. Initially, the lowest free index is allocated first. */
+	for (i = 0; i < CONFIG_MAX_SCHED_QUEUES; i++)
+		ring_u32_enq(glb->free_sched, glb->free_sched_mask, i);
+
+	for (i = CONFIG_MAX_SCHED_QUEUES; i < CONFIG_MAX_QUEUES; i++)
+		ring_u32_enq(glb->free_plain, glb->free_plain_mask, i);
+
+	return 0;
+}
+
+/* Reserve the next chunk of queue ring storage and add its slots to the free slot ring.
+ * Returns 0 when a chunk was added, or there are free slots available already. */
+static int ring_chunk_add(queue_global_t *glb)
+{
+	char name[ODP_SHM_NAME_LEN];
+	uint32_t i, first, num;
+	uint64_t size;
+	odp_shm_t shm;
+	int ret = -1;
+
+	odp_ticketlock_lock(&glb->ring_chunk_lock);
+
+	/* Another thread may have added a chunk meanwhile */
+	if (ring_u32_len(glb->free_slot)) {
+		ret = 0;
+		goto unlock;
+	}
+
+	if (glb->num_ring_slot >= CONFIG_MAX_QUEUES ||
+	    glb->num_ring_chunk >= CONFIG_QUEUE_RING_CHUNKS)
+		goto unlock;
+
+	first = glb->num_ring_slot;
+	num   = _ODP_MIN((uint32_t)RING_CHUNK_BASE << glb->num_ring_chunk,
+			 CONFIG_MAX_QUEUES - first);
+
+	/* Process mode cannot map memory reserved after fork, so all storage is
+	 * reserved at once on init. */
+	if (odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS)
+		num = CONFIG_MAX_QUEUES - first;
+
+	size = (uint64_t)num * glb->config.max_queue_size * sizeof(uint32_t);
+
+	snprintf(name, sizeof(name), "_odp_queue_basic_rings_%u", glb->num_ring_chunk);
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Queue ring storage reserve failed: %u queues, %" PRIu64 " kB. "
+			 "Reduce queue_basic.max_queue_size.\n", num, size / 1024);
+		goto unlock;
+	}
+
+	glb->ring_chunk_shm[glb->num_ring_chunk]   = shm;
+	glb->ring_chunk_data[glb->num_ring_chunk]  = odp_shm_addr(shm);
+	glb->ring_chunk_first[glb->num_ring_chunk] = first;
+	glb->ring_chunk_num[glb->num_ring_chunk]   = num;
+	glb->num_ring_chunk++;
+	glb->num_ring_slot += num;
+
+	for (i = first; i < first + num; i++)
+		ring_u32_enq(glb->free_slot, glb->free_slot_mask, i);
+
+	ret = 0;
+
+unlock:
+	odp_ticketlock_unlock(&glb->ring_chunk_lock);
+	return ret;
+}
+
+/* Allocate ring storage for a queue. Freed slots are reused before more storage is
+ * reserved, so memory use follows the maximum number of queues existing at a time. */
+static uint32_t *ring_slot_alloc(queue_entry_t *queue)
+{
+	queue_global_t *glb = _odp_queue_glb;
+	uint32_t slot, chunk;
+
+	while (ring_u32_deq(glb->free_slot, glb->free_slot_mask, &slot) == 0) {
+		if (ring_chunk_add(glb))
+			return NULL;
+	}
+
+	/* Chunks are never freed before term, so reading the table without the lock
+	 * is safe for the chunk that contains an allocated slot */
+	chunk = 0;
+	while (slot >= glb->ring_chunk_first[chunk] + glb->ring_chunk_num[chunk])
+		chunk++;
+
+	queue->ring_slot = slot;
+
+	return &glb->ring_chunk_data[chunk][(uint64_t)(slot - glb->ring_chunk_first[chunk]) *
+					   glb->config.max_queue_size];
+}
+
+static inline void queue_index_free(uint32_t queue_index)
+{
+	queue_entry_t *queue = qentry_from_index(queue_index);
+
+	if (queue->ring_slot != RING_SLOT_NONE) {
+		ring_u32_enq(_odp_queue_glb->free_slot, _odp_queue_glb->free_slot_mask,
+			     queue->ring_slot);
+		queue->ring_slot = RING_SLOT_NONE;
+	}
+
+	if (queue_index < CONFIG_MAX_SCHED_QUEUES)
+		ring_u32_enq(_odp_queue_glb->free_sched, _odp_queue_glb->free_sched_mask,
+			     queue_index);
+	else
+		ring_u32_enq(_odp_queue_glb->free_plain, _odp_queue_glb->free_plain_mask,
+			     queue_index);
+}
+
 static int queue_init_global(void)
 {
 	uint32_t i;
@@ -117,7 +284,6 @@ static int queue_init_global(void)
 	uint32_t lf_size = 0;
 	queue_lf_func_t *lf_func;
 	odp_queue_capability_t capa;
-	uint64_t mem_size;
 
 	_ODP_DBG("Starts...\n");
 
@@ -145,6 +311,7 @@ static int queue_init_global(void)
 		LOCK_INIT(queue);
 		queue->index  = i;
 		queue->handle = (odp_queue_t)queue;
+		queue->ring_slot = RING_SLOT_NONE;
 	}
 
 	if (read_config_file(_odp_queue_glb)) {
@@ -153,21 +320,22 @@ static int queue_init_global(void)
 	}
 
 	_odp_queue_glb->queue_gbl_shm = shm;
-	mem_size = sizeof(uint32_t) * CONFIG_MAX_QUEUES *
-		   (uint64_t)_odp_queue_glb->config.max_queue_size;
 
-	shm = odp_shm_reserve("_odp_queue_basic_rings", mem_size,
-			      ODP_CACHE_LINE_SIZE,
-			      0);
+	if (free_ring_init(_odp_queue_glb)) {
+		odp_shm_free(shm);
+		return -1;
+	}
 
-	if (shm == ODP_SHM_INVALID) {
+	odp_ticketlock_init(&_odp_queue_glb->ring_chunk_lock);
+
+	/* In process mode, all ring storage is reserved here */
+	if (odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS &&
+	    ring_chunk_add(_odp_queue_glb)) {
+		odp_shm_free(_odp_queue_glb->queue_free_shm);
 		odp_shm_free(_odp_queue_glb->queue_gbl_shm);
 		return -1;
 	}
 
-	_odp_queue_glb->queue_ring_shm = shm;
-	_odp_queue_glb->ring_data      = odp_shm_addr(shm);
-
 	lf_func = &_odp_queue_glb->queue_lf_func;
 	_odp_queue_glb->queue_lf_num  = _odp_queue_lf_init_global(&lf_size, lf_func);
 	_odp_queue_glb->queue_lf_size = lf_size;
@@ -212,7 +380,14 @@ static int queue_term_global(void)
 
 	_odp_queue_lf_term_global();
 
-	if (odp_shm_free(_odp_queue_glb->queue_ring_shm)) {
+	for (i = 0; i < (int)_odp_queue_glb->num_ring_chunk; i++) {
+		if (odp_shm_free(_odp_queue_glb->ring_chunk_shm[i])) {
+			_ODP_ERR("shm free failed");
+			ret = -1;
+		}
+	}
+
+	if (odp_shm_free(_odp_queue_glb->queue_free_shm)) {
 		_ODP_ERR("shm free failed");
 		ret = -1;
 	}
@@ -261,13 +436,13 @@ static uint32_t queue_lock_count(odp_queue_t handle)
 static odp_queue_t queue_create(const char *name,
 				const odp_queue_param_t *param)
 {
-	uint32_t i;
-	uint32_t max_idx;
+	uint32_t i, free_mask;
+	ring_u32_t *free_ring;
 	queue_entry_t *queue;
 	void *queue_lf;
 	odp_queue_type_t type;
 	odp_queue_param_t default_param;
-	odp_queue_t handle = ODP_QUEUE_INVALID;
+	odp_queue_t handle;
 
 	if (param == NULL) {
 		odp_queue_param_init(&default_param);
@@ -299,69 +474,61 @@ static odp_queue_t queue_create(const char *name,
 	}
 
 	if (type == ODP_QUEUE_TYPE_SCHED) {
-		/* Start scheduled queue indices from zero to enable direct
-		 * mapping to scheduler implementation indices. */
-		i = 0;
-		max_idx = CONFIG_MAX_SCHED_QUEUES;
+		free_ring = _odp_queue_glb->free_sched;
+		free_mask = _odp_queue_glb->free_sched_mask;
 	} else {
-		i = CONFIG_MAX_SCHED_QUEUES;
-		/* All internal queues are of type plain */
-		max_idx = CONFIG_MAX_QUEUES;
+		free_ring = _odp_queue_glb->free_plain;
+		free_mask = _odp_queue_glb->free_plain_mask;
 	}
 
-	for (; i < max_idx; i++) {
-		queue = qentry_from_index(i);
+	if (ring_u32_deq(free_ring, free_mask, &i) == 0)
+		return ODP_QUEUE_INVALID;
 
-		if (queue->status != QUEUE_STATUS_FREE)
-			continue;
+	queue = qentry_from_index(i);
 
-		LOCK(queue);
-		if (queue->status == QUEUE_STATUS_FREE) {
-			if (queue_init(queue, name, param)) {
-				UNLOCK(queue);
-				return ODP_QUEUE_INVALID;
-			}
-
-			if (!queue->spsc &&
-			    param->nonblocking == ODP_NONBLOCKING_LF) {
-				queue_lf_func_t *lf_fn;
-
-				lf_fn = &_odp_queue_glb->queue_lf_func;
-
-				queue_lf = _odp_queue_lf_create(queue);
-
-				if (queue_lf == NULL) {
-					UNLOCK(queue);
-					return ODP_QUEUE_INVALID;
-				}
-				queue->queue_lf = queue_lf;
-
-				queue->enqueue       = lf_fn->enq;
-				queue->enqueue_multi = lf_fn->enq_multi;
-				queue->dequeue       = lf_fn->deq;
-				queue->dequeue_multi = lf_fn->deq_multi;
-				queue->orig_dequeue_multi = lf_fn->deq_multi;
-			}
-
-			if (type == ODP_QUEUE_TYPE_SCHED)
-				queue->status = QUEUE_STATUS_NOTSCHED;
-			else
-				queue->status = QUEUE_STATUS_READY;
-
-			handle = queue->handle;
+	LOCK(queue);
+	_ODP_ASSERT(queue->status == QUEUE_STATUS_FREE);
+
+	if (queue_init(queue, name, param)) {
+		UNLOCK(queue);
+		queue_index_free(i);
+		return ODP_QUEUE_INVALID;
+	}
+
+	if (!queue->spsc && param->nonblocking == ODP_NONBLOCKING_LF) {
+		queue_lf_func_t *lf_fn;
+
+		lf_fn = &_odp_queue_glb->queue_lf_func;
+
+		queue_lf = _odp_queue_lf_create(queue);
+
+		if (queue_lf == NULL) {
 			UNLOCK(queue);
-			break;
+			queue_index_free(i);
+			return ODP_QUEUE_INVALID;
 		}
-		UNLOCK(queue);
+		queue->queue_lf = queue_lf;
+
+		queue->enqueue       = lf_fn->enq;
+		queue->enqueue_multi = lf_fn->enq_multi;
+		queue->dequeue       = lf_fn->deq;
+		queue->dequeue_multi = lf_fn->deq_multi;
+		queue->orig_dequeue_multi = lf_fn->deq_multi;
 	}
 
-	if (handle == ODP_QUEUE_INVALID)
-		return ODP_QUEUE_INVALID;
+	if (type == ODP_QUEUE_TYPE_SCHED)
+		queue->status = QUEUE_STATUS_NOTSCHED;
+	else
+		queue->status = QUEUE_STATUS_READY;
+
+	handle = queue->handle;
+	UNLOCK(queue);
 
 	if (type == ODP_QUEUE_TYPE_SCHED) {
 		if (_odp_sched_fn->create_queue(queue->index,
 						&queue->param.sched)) {
 			queue->status = QUEUE_STATUS_FREE;
+			queue_index_free(queue->index);
 			_ODP_ERR("schedule queue init failed\n");
 			return ODP_QUEUE_INVALID;
 		}
@@ -405,8 +572,6 @@ static int queue_destroy(odp_queue_t handle)
 
 	if (queue->spsc)
 		empty = ring_spsc_is_empty(&queue->ring_spsc);
-	else if (queue->type == ODP_QUEUE_TYPE_SCHED)
-		empty = ring_st_is_empty(&queue->ring_st);
 	else
 		empty = ring_mpmc_u32_is_empty(&queue->ring_mpmc);
 
@@ -435,6 +600,10 @@ static int queue_destroy(odp_queue_t handle)
 	if (queue->queue_lf)
 		_odp_queue_lf_destroy(queue->queue_lf);
 
+	/* Scheduler frees the index of a destroyed queue later */
+	if (queue->status == QUEUE_STATUS_FREE)
+		queue_index_free(queue->index);
+
 	UNLOCK(queue);
 
 	return 0;
@@ -747,10 +916,6 @@ static void queue_print(odp_queue_t handle)
 		_ODP_PRINT("  implementation  ring_spsc\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
 			   ring_spsc_length(&queue->ring_spsc), queue->ring_mask + 1);
-	} else if (queue->type == ODP_QUEUE_TYPE_SCHED) {
-		_ODP_PRINT("  implementation  ring_st\n");
-		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
-			   ring_st_length(&queue->ring_st), queue->ring_mask + 1);
 	} else {
 		_ODP_PRINT("  implementation  ring_mpmc\n");
 		_ODP_PRINT("  length          %" PRIu32 "/%" PRIu32 "\n",
@@ -812,7 +977,7 @@ static void queue_print_all(void)
 			len     = ring_spsc_length(&queue->ring_spsc);
 			max_len = queue->ring_mask + 1;
 		} else if (type == ODP_QUEUE_TYPE_SCHED) {
-			len     = ring_st_length(&queue->ring_st);
+			len     = ring_mpmc_u32_len(&queue->ring_mpmc);
 			max_len = queue->ring_mask + 1;
 			prio    = queue->param.sched.prio;
 			grp     = queue->param.sched.group;
@@ -867,40 +1032,75 @@ static void queue_print_all(void)
 	_ODP_PRINT("\n");
 }
 
+/* Sample latency of the first event of an enqueue. A queue tracks one sample at a time.
+ * The sample is armed before the event becomes visible to the scheduler. */
+static inline int lat_sample_arm(queue_entry_t *queue, uint32_t event_idx, int num)
+{
+	uint32_t state = LAT_SAMPLE_FREE;
+
+	lat_sample_cnt += num;
+
+	if (lat_sample_cnt < _odp_queue_glb->sched_lat_sample)
+		return 0;
+
+	if (!odp_atomic_cas_acq_u32(&queue->lat_sample_state, &state, LAT_SAMPLE_CLAIMED))
+		return 0;
+
+	lat_sample_cnt = 0;
+	queue->lat_sample_idx = event_idx;
+	queue->lat_sample_ns  = odp_time_global_ns();
+	odp_atomic_store_rel_u32(&queue->lat_sample_state, LAT_SAMPLE_ARMED);
+
+	return 1;
+}
+
 static inline int _sched_queue_enq_multi(odp_queue_t handle,
 					 _odp_event_hdr_t *event_hdr[], int num)
 {
 	int sched = 0;
+	int sample = 0;
 	int ret;
 	queue_entry_t *queue;
 	int num_enq;
-	ring_st_t *ring_st;
+	ring_mpmc_u32_t *ring_mpmc;
 	uint32_t event_idx[num];
 
 	queue = qentry_from_handle(handle);
-	ring_st = &queue->ring_st;
+	ring_mpmc = &queue->ring_mpmc;
 
 	if (_odp_sched_fn->ord_enq_multi(handle, (void **)event_hdr, num, &ret))
 		return ret;
 
 	event_index_from_hdr(event_idx, event_hdr, num);
 
-	LOCK(queue);
+	if (odp_unlikely(_odp_queue_glb->sched_lat_sample))
+		sample = lat_sample_arm(queue, event_idx[0], num);
 
-	num_enq = ring_st_enq_multi(ring_st, queue->ring_data,
-				    queue->ring_mask, event_idx, num);
+	num_enq = ring_mpmc_u32_enq_multi(ring_mpmc, queue->ring_data,
+					  queue->ring_mask, event_idx, num);
 
 	if (odp_unlikely(num_enq == 0)) {
-		UNLOCK(queue);
+		if (sample)
+			odp_atomic_store_u32(&queue->lat_sample_state, LAT_SAMPLE_FREE);
+
 		return 0;
 	}
 
-	if (queue->status == QUEUE_STATUS_NOTSCHED) {
-		queue->status = QUEUE_STATUS_SCHED;
-		sched = 1;
-	}
+	/* Pairs with the barrier in sched_queue_set_empty(): either this thread
+	 * sees the queue not scheduled, or the dequeuer sees the new events. */
+	odp_mb_full();
 
-	UNLOCK(queue);
+	if (odp_unlikely(__atomic_load_n(&queue->status, __ATOMIC_RELAXED) ==
+			 QUEUE_STATUS_NOTSCHED)) {
+		LOCK(queue);
+
+		if (queue->status == QUEUE_STATUS_NOTSCHED) {
+			queue->status = QUEUE_STATUS_SCHED;
+			sched = 1;
+		}
+
+		UNLOCK(queue);
+	}
 
 	/* Add queue to scheduling */
 	if (sched && _odp_sched_fn->sched_queue(queue->index))
@@ -909,46 +1109,96 @@ static inline int _sched_queue_enq_multi(odp_queue_t handle,
 	return num_enq;
 }
 
+/* Called with queue locked when a scheduled queue was found empty. Returns 1 when the
+ * queue is still empty, or 0 when events were enqueued meanwhile and the queue remains
+ * scheduled. */
+static inline int sched_queue_set_empty(queue_entry_t *queue)
+{
+	if (queue->status != QUEUE_STATUS_SCHED)
+		return 1;
+
+	queue->status = QUEUE_STATUS_NOTSCHED;
+
+	/* Enqueuers do not lock the queue when it is scheduled. Re-check the
+	 * ring after status update. */
+	odp_mb_full();
+
+	if (odp_likely(ring_mpmc_u32_is_empty(&queue->ring_mpmc)))
+		return 1;
+
+	queue->status = QUEUE_STATUS_SCHED;
+	return 0;
+}
+
+static int sched_queue_destroyed(queue_entry_t *queue)
+{
+	/* Bad queue, or queue has been destroyed.
+	 * Inform scheduler about a destroyed queue. */
+	LOCK(queue);
+
+	if (queue->status == QUEUE_STATUS_DESTROYED) {
+		queue->status = QUEUE_STATUS_FREE;
+		_odp_sched_fn->destroy_queue(queue->index);
+		queue_index_free(queue->index);
+	}
+
+	UNLOCK(queue);
+	return -1;
+}
+
 int _odp_sched_queue_deq(uint32_t queue_index, odp_event_t ev[], int max_num,
-			 int update_status)
+			 int update_status, uint64_t *lat_ns)
 {
-	int num_deq, status;
-	ring_st_t *ring_st;
+	int num_deq, i, empty;
+	ring_mpmc_u32_t *ring_mpmc;
 	queue_entry_t *queue = qentry_from_index(queue_index);
 	uint32_t event_idx[max_num];
 
-	ring_st = &queue->ring_st;
+	ring_mpmc = &queue->ring_mpmc;
 
-	LOCK(queue);
+	if (odp_unlikely(__atomic_load_n(&queue->status, __ATOMIC_RELAXED) < QUEUE_STATUS_READY))
+		return sched_queue_destroyed(queue);
 
-	status = queue->status;
+	while (1) {
+		num_deq = ring_mpmc_u32_deq_multi(ring_mpmc, queue->ring_data,
+						  queue->ring_mask, event_idx, max_num);
 
-	if (odp_unlikely(status < QUEUE_STATUS_READY)) {
-		/* Bad queue, or queue has been destroyed.
-		 * Inform scheduler about a destroyed queue. */
-		if (queue->status == QUEUE_STATUS_DESTROYED) {
-			queue->status = QUEUE_STATUS_FREE;
-			_odp_sched_fn->destroy_queue(queue_index);
-		}
+		if (num_deq)
+			break;
 
-		UNLOCK(queue);
-		return -1;
-	}
+		/* Already empty queue */
+		if (!update_status)
+			return 0;
 
-	num_deq = ring_st_deq_multi(ring_st, queue->ring_data,
-				    queue->ring_mask, event_idx, max_num);
+		LOCK(queue);
 
-	if (num_deq == 0) {
-		/* Already empty queue */
-		if (update_status && status == QUEUE_STATUS_SCHED)
-			queue->status = QUEUE_STATUS_NOTSCHED;
+		if (odp_unlikely(queue->status < QUEUE_STATUS_READY)) {
+			UNLOCK(queue);
+			return sched_queue_destroyed(queue);
+		}
+
+		empty = sched_queue_set_empty(queue);
 
 		UNLOCK(queue);
 
-		return 0;
+		if (empty)
+			return 0;
 	}
 
-	UNLOCK(queue);
+	/* Sampled event was dequeued. Output time it spent in the queue. */
+	if (odp_unlikely(odp_atomic_load_acq_u32(&queue->lat_sample_state) ==
+			 LAT_SAMPLE_ARMED)) {
+		for (i = 0; i < num_deq; i++) {
+			if (event_idx[i] != queue->lat_sample_idx)
+				continue;
+
+			if (lat_ns)
+				*lat_ns = odp_time_global_ns() - queue->lat_sample_ns;
+
+			odp_atomic_store_rel_u32(&queue->lat_sample_state, LAT_SAMPLE_FREE);
+			break;
+		}
+	}
 
 	event_index_to_hdr((_odp_event_hdr_t **)ev, event_idx, num_deq);
 
@@ -986,13 +1236,9 @@ int _odp_sched_queue_empty(uint32_t queue_index)
 		return -1;
 	}
 
-	if (ring_st_is_empty(&queue->ring_st)) {
-		/* Already empty queue. Update status. */
-		if (queue->status == QUEUE_STATUS_SCHED)
-			queue->status = QUEUE_STATUS_NOTSCHED;
-
-		ret = 1;
-	}
+	/* Already empty queue. Update status. */
+	if (ring_mpmc_u32_is_empty(&queue->ring_mpmc))
+		ret = sched_queue_set_empty(queue);
 
 	UNLOCK(queue);
 
@@ -1002,7 +1248,7 @@ int _odp_sched_queue_empty(uint32_t queue_index)
 static int queue_init(queue_entry_t *queue, const char *name,
 		      const odp_queue_param_t *param)
 {
-	uint64_t offset;
+	uint32_t *ring_data;
 	uint32_t queue_size;
 	odp_queue_type_t queue_type;
 	int spsc;
@@ -1043,7 +1289,13 @@ static int queue_init(queue_entry_t *queue, const char *name,
 		return -1;
 	}
 
-	offset = queue->index * (uint64_t)_odp_queue_glb->config.max_queue_size;
+	ring_data = ring_slot_alloc(queue);
+	if (ring_data == NULL) {
+		_ODP_ERR("No queue ring storage left\n");
+		return -1;
+	}
+
+	queue->ring_data = ring_data;
 
 	/* Single-producer / single-consumer plain queue has simple and
 	 * lock-free implementation */
@@ -1071,7 +1323,6 @@ static int queue_init(queue_entry_t *queue, const char *name,
 			queue->dequeue_multi      = plain_queue_deq_multi;
 			queue->orig_dequeue_multi = plain_queue_deq_multi;
 
-			queue->ring_data = &_odp_queue_glb->ring_data[offset];
 			queue->ring_mask = queue_size - 1;
 			ring_mpmc_u32_init(&queue->ring_mpmc);
 
@@ -1079,9 +1330,9 @@ static int queue_init(queue_entry_t *queue, const char *name,
 			queue->enqueue            = sched_queue_enq;
 			queue->enqueue_multi      = sched_queue_enq_multi;
 
-			queue->ring_data = &_odp_queue_glb->ring_data[offset];
 			queue->ring_mask = queue_size - 1;
-			ring_st_init(&queue->ring_st);
+			ring_mpmc_u32_init(&queue->ring_mpmc);
+			odp_atomic_init_u32(&queue->lat_sample_state, LAT_SAMPLE_FREE);
 		}
 	}
 
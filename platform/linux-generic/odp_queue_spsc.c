@@ -120,17 +120,12 @@ static _odp_event_hdr_t *queue_spsc_deq(odp_queue_t handle)
 
 void _odp_queue_spsc_init(queue_entry_t *queue, uint32_t queue_size)
 {
-	uint64_t offset;
-
 	queue->enqueue = queue_spsc_enq;
 	queue->dequeue = queue_spsc_deq;
 	queue->enqueue_multi = queue_spsc_enq_multi;
 	queue->dequeue_multi = queue_spsc_deq_multi;
 	queue->orig_dequeue_multi = queue_spsc_deq_multi;
 
-	offset = queue->index * (uint64_t)_odp_queue_glb->config.max_queue_size;
-
-	queue->ring_data = &_odp_queue_glb->ring_data[offset];
 	queue->ring_mask = queue_size - 1;
 	ring_spsc_init(&queue->ring_spsc);
 }
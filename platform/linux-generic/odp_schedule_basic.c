@@ -5,14 +5,6 @@
  * SPDX-License-Identifier:     BSD-3-Clause
  */
 
-/*
- * Suppress bounds warnings about interior zero length arrays. Such an array
- * is used intentionally in prio_queue_t.
- */
-#if __GNUC__ >= 10
-#pragma GCC diagnostic ignored "-Wzero-length-bounds"
-#endif
-
 #include <odp_posix_extensions.h>
 
 #include <odp/api/schedule.h>
@@ -42,8 +34,13 @@
 #include <odp_macros_internal.h>
 #include <odp_print_internal.h>
 
+#include <inttypes.h>
+#include <limits.h>
+#include <linux/futex.h>
 #include <string.h>
+#include <sys/syscall.h>
 #include <time.h>
+#include <unistd.h>
 
 /* No synchronization context */
 #define NO_SYNC_CONTEXT ODP_SCHED_SYNC_PARALLEL
@@ -106,6 +103,26 @@ ODP_STATIC_ASSERT((QUEUE_LOAD * CONFIG_MAX_SCHED_QUEUES) < UINT32_MAX, "Load_val
  * and no spreading). */
 #define MAX_RING_SIZE CONFIG_MAX_SCHED_QUEUES
 
+/* Priority queue rings of a group and priority level are reserved as a set, when the first
+ * queue of the level is created. The first storage chunk holds one set of rings and each
+ * following chunk is twice as large as the previous one. */
+#define RING_SET_CHUNK_SHIFT 0
+
+/* Number of order contexts in the first storage chunk (log2). Order contexts are reserved
+ * for ordered queues only. */
+#define ORDER_CHUNK_SHIFT 9
+
+/* Storage element index is not valid */
+#define CHUNK_IDX_NONE UINT32_MAX
+
+ODP_STATIC_ASSERT(NUM_SCHED_GRPS * NUM_PRIO <=
+		  ((1ull << CONFIG_SCHED_STORAGE_CHUNKS) - 1) << RING_SET_CHUNK_SHIFT,
+		  "Too_few_ring_set_chunks");
+
+ODP_STATIC_ASSERT(CONFIG_MAX_SCHED_QUEUES <=
+		  ((1ull << CONFIG_SCHED_STORAGE_CHUNKS) - 1) << ORDER_CHUNK_SHIFT,
+		  "Too_few_order_context_chunks");
+
 /* For best performance, the number of queues should be a power of two. */
 ODP_STATIC_ASSERT(_ODP_CHECK_IS_POWER2(CONFIG_MAX_SCHED_QUEUES),
 		  "Number_of_queues_is_not_power_of_two");
@@ -150,6 +167,33 @@ typedef union {
 ODP_STATIC_ASSERT(sizeof(lock_called_t) == sizeof(uint32_t),
 		  "Lock_called_values_do_not_fit_in_uint32");
 
+/* Maximum reorder window size */
+#define MAX_REORDER_WINDOW 256
+
+/* Maximum number of ordered queues with a reorder window */
+#define MAX_REORDER_QUEUES 1024
+
+/* Queue has no reorder window */
+#define REORDER_IDX_NONE UINT16_MAX
+
+/* Maximum number of events per reorder window slot */
+#define REORDER_SLOT_EVENTS CONFIG_BURST_SIZE
+
+/* Reorder window slot is free */
+#define REORDER_SLOT_FREE UINT64_MAX
+
+/* Reorder window slot. Stores enqueue operations of an ordered context, which has been
+ * released before all preceding contexts. */
+typedef struct ODP_ALIGNED_CACHE {
+	/* Ordered context id, or REORDER_SLOT_FREE */
+	odp_atomic_u64_t ctx;
+	uint32_t num;
+	lock_called_t lock_called;
+	odp_queue_t queue[REORDER_SLOT_EVENTS];
+	_odp_event_hdr_t *event_hdr[REORDER_SLOT_EVENTS];
+
+} reorder_slot_t;
+
 /* Shuffled values from 0 to 127 */
 static uint8_t sched_random_u8[] = {
 	0x5B, 0x56, 0x21, 0x28, 0x77, 0x2C, 0x7E, 0x10,
@@ -172,6 +216,17 @@ static uint8_t sched_random_u8[] = {
 
 ODP_STATIC_ASSERT(sizeof(sched_random_u8) == RANDOM_TBL_SIZE, "Bad_random_table_size");
 
+/* Latency statistics per schedule group, priority and sync type */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u64_t num_sample;
+	odp_atomic_u64_t min_ns;
+	odp_atomic_u64_t max_ns;
+	odp_atomic_u64_t sum_ns;
+	odp_atomic_u64_t latency[ODP_SCHED_LATENCY_HIST_BINS];
+	odp_atomic_u64_t burst[ODP_SCHED_BURST_HIST_BINS];
+
+} lat_stats_t;
+
 /* Scheduler local data */
 typedef struct ODP_ALIGNED_CACHE {
 	uint32_t sched_round;
@@ -181,6 +236,7 @@ typedef struct ODP_ALIGNED_CACHE {
 	uint8_t  balance_on;
 	uint16_t balance_start;
 	uint16_t spread_round;
+	uint16_t atomic_hold;
 
 	struct {
 		uint16_t    num_ev;
@@ -198,6 +254,9 @@ typedef struct ODP_ALIGNED_CACHE {
 	uint8_t grp[NUM_SCHED_GRPS];
 	uint8_t spread_tbl[SPREAD_TBL_SIZE];
 
+	/* Number of dispatches since the previous burst size sample */
+	uint32_t lat_burst_cnt;
+
 	struct {
 		/* Source queue index */
 		uint32_t src_queue;
@@ -211,19 +270,6 @@ typedef struct ODP_ALIGNED_CACHE {
 
 } sched_local_t;
 
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-/* Priority queue */
-typedef struct ODP_ALIGNED_CACHE {
-	/* Ring header */
-	ring_u32_t ring;
-
-	/* Ring data: queue indexes */
-	uint32_t queue_index[MAX_RING_SIZE]; /* overlaps with ring.data[] */
-
-} prio_queue_t;
-#pragma GCC diagnostic pop
-
 /* Order context of a queue */
 typedef struct ODP_ALIGNED_CACHE {
 	/* Current ordered context id */
@@ -237,6 +283,25 @@ typedef struct ODP_ALIGNED_CACHE {
 
 } order_context_t;
 
+/* Storage, which is reserved in chunks when elements are allocated. Chunk 'i' holds
+ * (1 << (shift + i)) elements, and elements are indexed in the order of reservation.
+ * Free elements are linked into a list through their first four bytes. Chunks are
+ * freed only on term. */
+typedef struct {
+	odp_ticketlock_t lock;
+	const char *name;
+	uint64_t elem_size;
+	uint32_t shift;
+	uint32_t max_elem;
+	uint32_t num_chunk;
+	uint32_t num_elem;
+	uint32_t num_used;
+	uint32_t free_head;
+	uint8_t *data[CONFIG_SCHED_STORAGE_CHUNKS];
+	odp_shm_t shm[CONFIG_SCHED_STORAGE_CHUNKS];
+
+} chunk_tbl_t;
+
 typedef struct {
 	struct {
 		uint8_t burst_default[NUM_SCHED_SYNC][NUM_PRIO];
@@ -244,10 +309,21 @@ typedef struct {
 		uint16_t order_stash_size;
 		uint8_t num_spread;
 		uint8_t prefer_ratio;
+		uint16_t atomic_hold;
 	} config;
 	uint32_t         ring_mask;
 	uint16_t         max_spread;
 	uint8_t          load_balance;
+	uint8_t          work_steal;
+	uint8_t          burst_adaptive;
+	uint32_t         reorder_window;
+	uint32_t         reorder_queues;
+	odp_shm_t        reorder_shm;
+	reorder_slot_t   *reorder_slot;
+	/* Free reorder windows. Protected by 'reorder_lock'. */
+	odp_ticketlock_t reorder_lock;
+	uint32_t         reorder_num_free;
+	uint16_t         reorder_free[MAX_REORDER_QUEUES];
 	odp_atomic_u32_t grp_epoch;
 	odp_shm_t        shm;
 	odp_ticketlock_t mask_lock[NUM_SCHED_GRPS];
@@ -266,13 +342,18 @@ typedef struct {
 		uint8_t poll_pktin;
 		uint8_t pktio_index;
 		uint8_t pktin_index;
+		/* Reorder window index, or REORDER_IDX_NONE */
+		uint16_t reorder_idx;
+		/* Order context index (in 'order_tbl') of an ordered queue */
+		uint32_t order_idx;
 	} queue[CONFIG_MAX_SCHED_QUEUES];
 
-	/* Scheduler priority queues */
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wpedantic"
-	prio_queue_t prio_q[NUM_SCHED_GRPS][NUM_PRIO][MAX_SPREAD];
-#pragma GCC diagnostic pop
+	/* Scheduler priority queues. Rings of queue indexes, which are stored in
+	 * 'ring_tbl'. Only 'num_spread' rings per group and priority are used. Rings
+	 * are NULL until the first queue of the group and priority is created. */
+	ring_u32_t *prio_q[NUM_SCHED_GRPS][NUM_PRIO][MAX_SPREAD];
+	chunk_tbl_t ring_tbl;
+	uint32_t    ring_stride;
 	uint32_t prio_q_count[NUM_SCHED_GRPS][NUM_PRIO][MAX_SPREAD];
 
 	/* Number of queues per group and priority  */
@@ -293,13 +374,27 @@ typedef struct {
 	} pktio[NUM_PKTIO];
 	odp_ticketlock_t pktio_lock;
 
-	order_context_t order[CONFIG_MAX_SCHED_QUEUES];
+	/* Order contexts of ordered queues */
+	chunk_tbl_t order_tbl;
 
 	struct {
 		uint32_t poll_time;
+		uint64_t sleep_ns;
 		struct timespec sleep_time;
+		uint8_t block;
 	} powersave;
 
+	/* Threads blocked in powersave mode. Futex value 'seq' is incremented on wake up. */
+	struct ODP_ALIGNED_CACHE {
+		odp_atomic_u32_t seq;
+		odp_atomic_u32_t num;
+	} sleep;
+
+	/* Latency statistics sampling rate. Statistics are disabled when zero. */
+	uint32_t lat_sample;
+	odp_shm_t lat_shm;
+	lat_stats_t (*lat_stats)[NUM_PRIO][NUM_SCHED_SYNC];
+
 	/* Scheduler interface config options (not used in fast path) */
 	schedule_config_t config_if;
 	uint32_t max_queues;
@@ -321,6 +416,150 @@ static sched_global_t *sched;
 /* Thread local scheduler context */
 static __thread sched_local_t sched_local;
 
+static inline void *chunk_tbl_elem(chunk_tbl_t *tbl, uint32_t idx)
+{
+	uint32_t chunk = 31 - __builtin_clz((idx >> tbl->shift) + 1);
+	uint32_t first = ((1u << chunk) - 1) << tbl->shift;
+
+	return tbl->data[chunk] + (uint64_t)(idx - first) * tbl->elem_size;
+}
+
+/* Reserve the next storage chunk. Called with the table lock held. */
+static int chunk_tbl_add(chunk_tbl_t *tbl)
+{
+	char name[ODP_SHM_NAME_LEN];
+	uint32_t num;
+	uint64_t size;
+	odp_shm_t shm;
+
+	if (tbl->num_elem >= tbl->max_elem || tbl->num_chunk >= CONFIG_SCHED_STORAGE_CHUNKS)
+		return -1;
+
+	num  = _ODP_MIN((uint32_t)1 << (tbl->shift + tbl->num_chunk),
+			tbl->max_elem - tbl->num_elem);
+	size = num * tbl->elem_size;
+
+	snprintf(name, sizeof(name), "%s_%u", tbl->name, tbl->num_chunk);
+	shm = odp_shm_reserve(name, size, ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Schedule: %s reserve failed: %u elements, %" PRIu64 " kB\n",
+			 tbl->name, num, size / 1024);
+		return -1;
+	}
+
+	tbl->shm[tbl->num_chunk]  = shm;
+	tbl->data[tbl->num_chunk] = odp_shm_addr(shm);
+	tbl->num_chunk++;
+	tbl->num_elem += num;
+
+	return 0;
+}
+
+static int chunk_tbl_term(chunk_tbl_t *tbl)
+{
+	int rc = 0;
+
+	for (uint32_t i = 0; i < tbl->num_chunk; i++) {
+		if (odp_shm_free(tbl->shm[i])) {
+			_ODP_ERR("Shm free failed for %s\n", tbl->name);
+			rc = -1;
+		}
+	}
+
+	tbl->num_chunk = 0;
+	tbl->num_elem  = 0;
+
+	return rc;
+}
+
+static int chunk_tbl_init(chunk_tbl_t *tbl, const char *name, uint64_t elem_size,
+			  uint32_t shift, uint32_t max_elem)
+{
+	odp_ticketlock_init(&tbl->lock);
+	tbl->name      = name;
+	tbl->elem_size = elem_size;
+	tbl->shift     = shift;
+	tbl->max_elem  = max_elem;
+	tbl->num_chunk = 0;
+	tbl->num_elem  = 0;
+	tbl->num_used  = 0;
+	tbl->free_head = CHUNK_IDX_NONE;
+
+	/* Process mode cannot map memory reserved after fork, so all storage is
+	 * reserved at once on init. */
+	if (odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		while (tbl->num_elem < max_elem) {
+			if (chunk_tbl_add(tbl)) {
+				chunk_tbl_term(tbl);
+				return -1;
+			}
+		}
+	}
+
+	return 0;
+}
+
+/* Allocate an element. Freed elements are reused before more storage is reserved, so
+ * memory use follows the maximum number of elements in use at a time. */
+static uint32_t chunk_tbl_alloc(chunk_tbl_t *tbl)
+{
+	uint32_t idx = CHUNK_IDX_NONE;
+
+	odp_ticketlock_lock(&tbl->lock);
+
+	if (tbl->free_head != CHUNK_IDX_NONE) {
+		idx = tbl->free_head;
+		memcpy(&tbl->free_head, chunk_tbl_elem(tbl, idx), sizeof(uint32_t));
+	} else if (tbl->num_used < tbl->num_elem || chunk_tbl_add(tbl) == 0) {
+		idx = tbl->num_used++;
+	}
+
+	odp_ticketlock_unlock(&tbl->lock);
+
+	return idx;
+}
+
+static void chunk_tbl_free(chunk_tbl_t *tbl, uint32_t idx)
+{
+	odp_ticketlock_lock(&tbl->lock);
+
+	memcpy(chunk_tbl_elem(tbl, idx), &tbl->free_head, sizeof(uint32_t));
+	tbl->free_head = idx;
+
+	odp_ticketlock_unlock(&tbl->lock);
+}
+
+static inline order_context_t *order_context(uint32_t queue_index)
+{
+	return chunk_tbl_elem(&sched->order_tbl, sched->queue[queue_index].order_idx);
+}
+
+/* Reserve priority queue rings of a group and priority level. Called with 'grp_lock'
+ * held. */
+static int ring_set_alloc(int grp, int prio)
+{
+	uint32_t idx = chunk_tbl_alloc(&sched->ring_tbl);
+	uint8_t *ring_base;
+
+	if (idx == CHUNK_IDX_NONE) {
+		_ODP_ERR("Priority queue ring reserve failed. Reduce CONFIG_MAX_SCHED_QUEUES or "
+			 "sched_basic.prio_spread.\n");
+		return -1;
+	}
+
+	ring_base = chunk_tbl_elem(&sched->ring_tbl, idx);
+
+	for (int i = 0; i < sched->config.num_spread; i++) {
+		ring_u32_t *ring = (ring_u32_t *)(uintptr_t)ring_base;
+
+		ring_u32_init(ring);
+		sched->prio_q[grp][prio][i] = ring;
+		ring_base += sched->ring_stride;
+	}
+
+	return 0;
+}
+
 static void prio_grp_mask_init(void)
 {
 	int i;
@@ -445,6 +684,83 @@ static int read_config_file(sched_global_t *sched)
 	if (val == 0 || sched->config.num_spread == 1)
 		sched->load_balance = 0;
 
+	str = "sched_basic.work_steal";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > 1 || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	sched->work_steal = 1;
+	if (val == 0 || sched->config.num_spread == 1)
+		sched->work_steal = 0;
+
+	str = "sched_basic.reorder_window";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_REORDER_WINDOW || val < 0 || (val & (val - 1))) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->reorder_window = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.reorder_queues";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > MAX_REORDER_QUEUES || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->reorder_queues = val;
+	if (sched->reorder_window == 0 || sched->reorder_queues == 0) {
+		sched->reorder_window = 0;
+		sched->reorder_queues = 0;
+	}
+
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.burst_adaptive";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > 1 || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->burst_adaptive = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.atomic_hold";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > UINT16_MAX || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->config.atomic_hold = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	str = "sched_basic.order_stash_size";
 	if (!_odp_libconfig_lookup_int(str, &val)) {
 		_ODP_ERR("Config option '%s' not found.\n", str);
@@ -545,11 +861,41 @@ static int read_config_file(sched_global_t *sched)
 	}
 
 	val = _ODP_MAX(0, val);
+	sched->powersave.sleep_ns = val;
 	sched->powersave.sleep_time.tv_sec = val / 1000000000;
 	sched->powersave.sleep_time.tv_nsec = val % 1000000000;
 	_ODP_PRINT("  %s: %i\n", str, val);
 
+	str = "sched_basic.powersave.block";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val > 1 || val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->powersave.block = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	str = "sched_basic.latency_stats";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", str, val);
+		return -1;
+	}
+
+	sched->lat_sample = val;
+	_ODP_PRINT("  %s: %i\n", str, val);
+
 	_ODP_PRINT("  dynamic load balance: %s\n", sched->load_balance ? "ON" : "OFF");
+	_ODP_PRINT("  work stealing: %s\n", sched->work_steal ? "ON" : "OFF");
 
 	_ODP_PRINT("\n");
 
@@ -562,6 +908,52 @@ static inline uint8_t spread_from_index(uint32_t index)
 	return index % sched->config.num_spread;
 }
 
+static void lat_stats_reset(void)
+{
+	int grp, prio, sync, i;
+
+	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
+		for (prio = 0; prio < NUM_PRIO; prio++) {
+			for (sync = 0; sync < NUM_SCHED_SYNC; sync++) {
+				lat_stats_t *stats = &sched->lat_stats[grp][prio][sync];
+
+				odp_atomic_init_u64(&stats->num_sample, 0);
+				odp_atomic_init_u64(&stats->min_ns, UINT64_MAX);
+				odp_atomic_init_u64(&stats->max_ns, 0);
+				odp_atomic_init_u64(&stats->sum_ns, 0);
+
+				for (i = 0; i < ODP_SCHED_LATENCY_HIST_BINS; i++)
+					odp_atomic_init_u64(&stats->latency[i], 0);
+
+				for (i = 0; i < ODP_SCHED_BURST_HIST_BINS; i++)
+					odp_atomic_init_u64(&stats->burst[i], 0);
+			}
+		}
+	}
+}
+
+static int lat_stats_init(void)
+{
+	odp_shm_t shm;
+
+	shm = odp_shm_reserve("_odp_sched_basic_lat_stats",
+			      sizeof(lat_stats_t) * NUM_SCHED_GRPS * NUM_PRIO * NUM_SCHED_SYNC,
+			      ODP_CACHE_LINE_SIZE, 0);
+	if (shm == ODP_SHM_INVALID) {
+		_ODP_ERR("Schedule init: Latency stats shm reserve failed.\n");
+		return -1;
+	}
+
+	sched->lat_shm   = shm;
+	sched->lat_stats = odp_shm_addr(shm);
+	lat_stats_reset();
+
+	/* Queues sample events on enqueue */
+	_odp_queue_glb->sched_lat_sample = sched->lat_sample;
+
+	return 0;
+}
+
 static void sched_local_init(void)
 {
 	int i;
@@ -593,9 +985,9 @@ static void sched_local_init(void)
 static int schedule_init_global(void)
 {
 	odp_shm_t shm;
-	int i, j, grp;
+	int i, grp;
 	int prefer_ratio;
-	uint32_t ring_size, num_rings;
+	uint32_t ring_size, num_rings, ring_stride;
 
 	_ODP_DBG("Schedule init ... ");
 
@@ -617,8 +1009,39 @@ static int schedule_init_global(void)
 	}
 
 	sched->shm = shm;
+	sched->lat_shm = ODP_SHM_INVALID;
 	prefer_ratio = sched->config.prefer_ratio;
 
+	if (sched->lat_sample && lat_stats_init()) {
+		odp_shm_free(shm);
+		return -1;
+	}
+
+	sched->reorder_shm = ODP_SHM_INVALID;
+
+	if (sched->reorder_window) {
+		sched->reorder_shm = odp_shm_reserve("_odp_sched_basic_reorder",
+						     (uint64_t)sizeof(reorder_slot_t) *
+						     sched->reorder_window *
+						     sched->reorder_queues,
+						     ODP_CACHE_LINE_SIZE, 0);
+		if (sched->reorder_shm == ODP_SHM_INVALID) {
+			_ODP_ERR("Schedule init: Reorder window shm reserve failed.\n");
+			if (sched->lat_shm != ODP_SHM_INVALID)
+				odp_shm_free(sched->lat_shm);
+			odp_shm_free(shm);
+			return -1;
+		}
+
+		sched->reorder_slot = odp_shm_addr(sched->reorder_shm);
+
+		odp_ticketlock_init(&sched->reorder_lock);
+		sched->reorder_num_free = sched->reorder_queues;
+
+		for (i = 0; i < (int)sched->reorder_queues; i++)
+			sched->reorder_free[i] = sched->reorder_queues - 1 - i;
+	}
+
 	/* When num_spread == 1, only spread_tbl[0] is used. */
 	sched->max_spread = (sched->config.num_spread - 1) * prefer_ratio;
 
@@ -642,18 +1065,35 @@ static int schedule_init_global(void)
 	if (sched->max_queues > CONFIG_MAX_SCHED_QUEUES)
 		sched->max_queues = CONFIG_MAX_SCHED_QUEUES;
 
-	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
-		odp_ticketlock_init(&sched->mask_lock[grp]);
+	/* Rings of a group and priority level are reserved when the first queue of the level
+	 * is created, and order contexts when ordered queues are created. Ring size follows
+	 * CONFIG_MAX_SCHED_QUEUES, so a large value increases memory usage per level in use. */
+	ring_stride = _ODP_ROUNDUP_CACHE_LINE(sizeof(ring_u32_t) +
+					      ring_size * sizeof(uint32_t));
+	sched->ring_stride = ring_stride;
+
+	if (chunk_tbl_init(&sched->ring_tbl, "_odp_sched_basic_rings",
+			   (uint64_t)ring_stride * sched->config.num_spread,
+			   RING_SET_CHUNK_SHIFT, NUM_SCHED_GRPS * NUM_PRIO) ||
+	    chunk_tbl_init(&sched->order_tbl, "_odp_sched_basic_order",
+			   sizeof(order_context_t), ORDER_CHUNK_SHIFT,
+			   CONFIG_MAX_SCHED_QUEUES)) {
+		_ODP_ERR("Schedule init: Storage reserve failed. Reduce "
+			 "CONFIG_MAX_SCHED_QUEUES or sched_basic.prio_spread.\n");
+		chunk_tbl_term(&sched->ring_tbl);
+		if (sched->reorder_shm != ODP_SHM_INVALID)
+			odp_shm_free(sched->reorder_shm);
+		if (sched->lat_shm != ODP_SHM_INVALID)
+			odp_shm_free(sched->lat_shm);
+		odp_shm_free(shm);
+		return -1;
+	}
 
-		for (i = 0; i < NUM_PRIO; i++) {
-			for (j = 0; j < MAX_SPREAD; j++) {
-				prio_queue_t *prio_q;
+	for (grp = 0; grp < NUM_SCHED_GRPS; grp++)
+		odp_ticketlock_init(&sched->mask_lock[grp]);
 
-				prio_q = &sched->prio_q[grp][i][j];
-				ring_u32_init(&prio_q->ring);
-			}
-		}
-	}
+	odp_atomic_init_u32(&sched->sleep.seq, 0);
+	odp_atomic_init_u32(&sched->sleep.num, 0);
 
 	odp_ticketlock_init(&sched->pktio_lock);
 	for (i = 0; i < NUM_PKTIO; i++)
@@ -697,17 +1137,17 @@ static int schedule_term_global(void)
 
 	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
 		for (i = 0; i < NUM_PRIO; i++) {
-			for (j = 0; j < MAX_SPREAD; j++) {
+			for (j = 0; j < sched->config.num_spread; j++) {
 				ring_u32_t *ring;
 				uint32_t qi;
 
-				ring = &sched->prio_q[grp][i][j].ring;
+				ring = sched->prio_q[grp][i][j];
 
-				while (ring_u32_deq(ring, ring_mask, &qi)) {
+				while (ring && ring_u32_deq(ring, ring_mask, &qi)) {
 					odp_event_t events[1];
 					int num;
 
-					num = _odp_sched_queue_deq(qi, events, 1, 1);
+					num = _odp_sched_queue_deq(qi, events, 1, 1, NULL);
 
 					if (num > 0)
 						_ODP_ERR("Queue not empty\n");
@@ -716,6 +1156,26 @@ static int schedule_term_global(void)
 		}
 	}
 
+	if (sched->reorder_shm != ODP_SHM_INVALID && odp_shm_free(sched->reorder_shm)) {
+		_ODP_ERR("Shm free failed for reorder window\n");
+		rc = -1;
+	}
+
+	if (sched->lat_shm != ODP_SHM_INVALID) {
+		_odp_queue_glb->sched_lat_sample = 0;
+
+		if (odp_shm_free(sched->lat_shm)) {
+			_ODP_ERR("Shm free failed for latency stats\n");
+			rc = -1;
+		}
+	}
+
+	if (chunk_tbl_term(&sched->ring_tbl))
+		rc = -1;
+
+	if (chunk_tbl_term(&sched->order_tbl))
+		rc = -1;
+
 	ret = odp_shm_free(sched->shm);
 	if (ret < 0) {
 		_ODP_ERR("Shm free failed for odp_scheduler");
@@ -873,6 +1333,8 @@ static int schedule_create_queue(uint32_t queue_index,
 {
 	int i;
 	uint8_t spread;
+	order_context_t *order;
+	uint32_t order_idx = CHUNK_IDX_NONE;
 	int grp  = sched_param->group;
 	int prio = prio_level_from_api(sched_param->prio);
 
@@ -898,12 +1360,26 @@ static int schedule_create_queue(uint32_t queue_index,
 		return -1;
 	}
 
+	if (sched_param->sync == ODP_SCHED_SYNC_ORDERED) {
+		order_idx = chunk_tbl_alloc(&sched->order_tbl);
+		if (order_idx == CHUNK_IDX_NONE) {
+			_ODP_ERR("Order context reserve failed\n");
+			return -1;
+		}
+	}
+
 	odp_ticketlock_lock(&sched->grp_lock);
 
 	if (sched->sched_grp[grp].allocated == 0) {
 		odp_ticketlock_unlock(&sched->grp_lock);
 		_ODP_ERR("Group not created: %i\n", grp);
-		return -1;
+		goto error;
+	}
+
+	/* Rings are set before the group is added to the priority level mask */
+	if (sched->prio_q[grp][prio][0] == NULL && ring_set_alloc(grp, prio)) {
+		odp_ticketlock_unlock(&sched->grp_lock);
+		goto error;
 	}
 
 	prio_grp_mask_set(prio, grp);
@@ -920,14 +1396,46 @@ static int schedule_create_queue(uint32_t queue_index,
 	sched->queue[queue_index].poll_pktin  = 0;
 	sched->queue[queue_index].pktio_index = 0;
 	sched->queue[queue_index].pktin_index = 0;
+	sched->queue[queue_index].order_idx = order_idx;
+
+	if (order_idx != CHUNK_IDX_NONE) {
+		order = order_context(queue_index);
+		odp_atomic_init_u64(&order->ctx, 0);
+		odp_atomic_init_u64(&order->next_ctx, 0);
+
+		for (i = 0; i < CONFIG_QUEUE_MAX_ORD_LOCKS; i++)
+			odp_atomic_init_u64(&order->lock[i], 0);
+	}
 
-	odp_atomic_init_u64(&sched->order[queue_index].ctx, 0);
-	odp_atomic_init_u64(&sched->order[queue_index].next_ctx, 0);
+	sched->queue[queue_index].reorder_idx = REORDER_IDX_NONE;
 
-	for (i = 0; i < CONFIG_QUEUE_MAX_ORD_LOCKS; i++)
-		odp_atomic_init_u64(&sched->order[queue_index].lock[i], 0);
+	/* Ordered queues get a reorder window while there are free ones left. Other ordered
+	 * queues wait for their turn when releasing the context. */
+	if (sched->reorder_window && sched_param->sync == ODP_SCHED_SYNC_ORDERED) {
+		uint16_t idx = REORDER_IDX_NONE;
+
+		odp_ticketlock_lock(&sched->reorder_lock);
+		if (sched->reorder_num_free)
+			idx = sched->reorder_free[--sched->reorder_num_free];
+		odp_ticketlock_unlock(&sched->reorder_lock);
+
+		if (idx != REORDER_IDX_NONE) {
+			reorder_slot_t *slot = &sched->reorder_slot[idx * sched->reorder_window];
+
+			for (i = 0; i < (int)sched->reorder_window; i++)
+				odp_atomic_init_u64(&slot[i].ctx, REORDER_SLOT_FREE);
+
+			sched->queue[queue_index].reorder_idx = idx;
+		}
+	}
 
 	return 0;
+
+error:
+	if (order_idx != CHUNK_IDX_NONE)
+		chunk_tbl_free(&sched->order_tbl, order_idx);
+
+	return -1;
 }
 
 static inline uint8_t sched_sync_type(uint32_t queue_index)
@@ -951,10 +1459,49 @@ static void schedule_destroy_queue(uint32_t queue_index)
 	sched->queue[queue_index].prio   = 0;
 	sched->queue[queue_index].spread = 0;
 
-	if ((sched_sync_type(queue_index) == ODP_SCHED_SYNC_ORDERED) &&
-	    odp_atomic_load_u64(&sched->order[queue_index].ctx) !=
-	    odp_atomic_load_u64(&sched->order[queue_index].next_ctx))
-		_ODP_ERR("queue reorder incomplete\n");
+	if (sched->queue[queue_index].reorder_idx != REORDER_IDX_NONE) {
+		uint16_t reorder_idx = sched->queue[queue_index].reorder_idx;
+
+		odp_ticketlock_lock(&sched->reorder_lock);
+		sched->reorder_free[sched->reorder_num_free++] = reorder_idx;
+		odp_ticketlock_unlock(&sched->reorder_lock);
+		sched->queue[queue_index].reorder_idx = REORDER_IDX_NONE;
+	}
+
+	if (sched_sync_type(queue_index) == ODP_SCHED_SYNC_ORDERED) {
+		order_context_t *order = order_context(queue_index);
+
+		if (odp_atomic_load_u64(&order->ctx) != odp_atomic_load_u64(&order->next_ctx))
+			_ODP_ERR("queue reorder incomplete\n");
+
+		chunk_tbl_free(&sched->order_tbl, sched->queue[queue_index].order_idx);
+		sched->queue[queue_index].order_idx = CHUNK_IDX_NONE;
+	}
+}
+
+/* Wake up threads blocked in powersave mode */
+static inline void wake_sleepers(void)
+{
+	/* Ring enqueue must be visible before the number of sleepers is read. Pairs with
+	 * the barrier in sleep_block(). */
+	odp_mb_full();
+
+	if (odp_likely(odp_atomic_load_u32(&sched->sleep.num) == 0))
+		return;
+
+	/* Threads may belong to multiple groups, so all are woken up */
+	odp_atomic_inc_u32(&sched->sleep.seq);
+	syscall(SYS_futex, &sched->sleep.seq, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+}
+
+/* Return a queue that is still being scheduled into its spread ring. Threads blocked in
+ * powersave mode are woken up when the queue has events left. */
+static inline void requeue_sched_queue(ring_u32_t *ring, uint32_t qi)
+{
+	ring_u32_enq(ring, sched->ring_mask, qi);
+
+	if (odp_unlikely(sched->powersave.block) && _odp_sched_queue_len(qi))
+		wake_sleepers();
 }
 
 static int schedule_sched_queue(uint32_t queue_index)
@@ -962,9 +1509,13 @@ static int schedule_sched_queue(uint32_t queue_index)
 	int grp      = sched->queue[queue_index].grp;
 	int prio     = sched->queue[queue_index].prio;
 	int spread   = sched->queue[queue_index].spread;
-	ring_u32_t *ring = &sched->prio_q[grp][prio][spread].ring;
+	ring_u32_t *ring = sched->prio_q[grp][prio][spread];
 
 	ring_u32_enq(ring, sched->ring_mask, queue_index);
+
+	if (odp_unlikely(sched->powersave.block))
+		wake_sleepers();
+
 	return 0;
 }
 
@@ -996,7 +1547,7 @@ static inline void release_atomic(void)
 	ring_u32_t *ring = sched_local.stash.ring;
 
 	/* Release current atomic queue */
-	ring_u32_enq(ring, sched->ring_mask, qi);
+	requeue_sched_queue(ring, qi);
 
 	/* We don't hold sync context anymore */
 	sched_local.sync_ctx = NO_SYNC_CONTEXT;
@@ -1013,7 +1564,7 @@ static inline int ordered_own_turn(uint32_t queue_index)
 {
 	uint64_t ctx;
 
-	ctx = odp_atomic_load_acq_u64(&sched->order[queue_index].ctx);
+	ctx = odp_atomic_load_acq_u64(&order_context(queue_index)->ctx);
 
 	return ctx == sched_local.ordered.ctx;
 }
@@ -1061,6 +1612,128 @@ static inline void ordered_stash_release(void)
 	sched_local.ordered.stash_num = 0;
 }
 
+static inline int has_reorder_window(uint32_t queue_index)
+{
+	return sched->queue[queue_index].reorder_idx != REORDER_IDX_NONE;
+}
+
+static inline reorder_slot_t *reorder_slot(uint32_t queue_index, uint64_t ctx)
+{
+	uint32_t window = sched->reorder_window;
+	uint32_t idx = sched->queue[queue_index].reorder_idx;
+
+	return &sched->reorder_slot[idx * window + (ctx & (window - 1))];
+}
+
+/* Store stashed enqueue operations of the current ordered context into the reorder window of
+ * the source queue. Returns 1 when a thread completing the preceding contexts takes care of
+ * the operations, or 0 when the caller must wait for its own turn. */
+static inline int reorder_deposit(uint32_t queue_index)
+{
+	reorder_slot_t *slot;
+	uint64_t head, old;
+	uint32_t num = 0;
+	int i, j;
+	uint64_t ctx = sched_local.ordered.ctx;
+	odp_atomic_u64_t *order_ctx = &order_context(queue_index)->ctx;
+
+	head = odp_atomic_load_acq_u64(order_ctx);
+
+	if (head == ctx || ctx - head >= sched->reorder_window)
+		return 0;
+
+	for (i = 0; i < sched_local.ordered.stash_num; i++)
+		num += sched_local.ordered.stash[i].num;
+
+	if (num > REORDER_SLOT_EVENTS)
+		return 0;
+
+	slot = reorder_slot(queue_index, ctx);
+	num = 0;
+
+	for (i = 0; i < sched_local.ordered.stash_num; i++) {
+		ordered_stash_t *stash = &sched_local.ordered.stash[i];
+
+		for (j = 0; j < stash->num; j++) {
+			slot->queue[num]     = stash->queue;
+			slot->event_hdr[num] = stash->event_hdr[j];
+			num++;
+		}
+	}
+
+	slot->num = num;
+	slot->lock_called = sched_local.ordered.lock_called;
+	odp_atomic_store_rel_u64(&slot->ctx, ctx);
+
+	/* Slot update must be visible before the head is read. Pairs with the barrier in
+	 * reorder_release(). */
+	odp_mb_full();
+
+	if (odp_atomic_load_acq_u64(order_ctx) != ctx)
+		return 1;
+
+	/* Preceding contexts completed meanwhile. Either this thread takes the slot back and
+	 * continues in order, or the thread that completed them has already taken the slot. */
+	old = ctx;
+	if (odp_atomic_cas_acq_u64(&slot->ctx, &old, REORDER_SLOT_FREE))
+		return 0;
+
+	return 1;
+}
+
+/* Release the head of the ordered queue to 'next' context and perform enqueue operations of
+ * following contexts that are waiting in the reorder window. */
+static inline void reorder_release(uint32_t queue_index, uint64_t next)
+{
+	odp_atomic_u64_t *order_ctx = &order_context(queue_index)->ctx;
+	uint32_t lock_count = sched->queue[queue_index].order_lock_count;
+	reorder_slot_t *slot;
+	uint64_t old;
+	uint32_t i, num, num_enq;
+
+	while (1) {
+		odp_atomic_store_rel_u64(order_ctx, next);
+
+		/* Head update must be visible before the slot is read. Pairs with the barrier in
+		 * reorder_deposit(). */
+		odp_mb_full();
+
+		slot = reorder_slot(queue_index, next);
+		old  = next;
+
+		if (!odp_atomic_cas_acq_u64(&slot->ctx, &old, REORDER_SLOT_FREE))
+			return;
+
+		/* Release ordered locks on behalf of the context */
+		for (i = 0; i < lock_count; i++) {
+			if (!slot->lock_called.u8[i])
+				odp_atomic_store_rel_u64(&order_context(queue_index)->lock[i],
+							 next + 1);
+		}
+
+		/* Enqueue events in order, consecutive events of the same destination queue
+		 * with a single call */
+		for (i = 0; i < slot->num; i += num) {
+			odp_queue_t queue = slot->queue[i];
+			int ret;
+
+			for (num = 1; i + num < slot->num && slot->queue[i + num] == queue; num++)
+				;
+
+			ret = odp_queue_enq_multi(queue, (odp_event_t *)&slot->event_hdr[i], num);
+			num_enq = ret < 0 ? 0 : ret;
+
+			/* Drop packets that were not enqueued */
+			if (odp_unlikely(num_enq < num)) {
+				_ODP_DBG("Dropped %u packets\n", num - num_enq);
+				_odp_event_free_multi(&slot->event_hdr[i + num_enq], num - num_enq);
+			}
+		}
+
+		next++;
+	}
+}
+
 static inline void release_ordered(void)
 {
 	uint32_t qi;
@@ -1068,12 +1741,20 @@ static inline void release_ordered(void)
 
 	qi = sched_local.ordered.src_queue;
 
+	if (has_reorder_window(qi) && !sched_local.ordered.in_order && reorder_deposit(qi)) {
+		/* Events will be enqueued by another thread */
+		sched_local.ordered.stash_num = 0;
+		sched_local.ordered.lock_called.all = 0;
+		sched_local.sync_ctx = NO_SYNC_CONTEXT;
+		return;
+	}
+
 	wait_for_order(qi);
 
 	/* Release all ordered locks */
 	for (i = 0; i < sched->queue[qi].order_lock_count; i++) {
 		if (!sched_local.ordered.lock_called.u8[i])
-			odp_atomic_store_rel_u64(&sched->order[qi].lock[i],
+			odp_atomic_store_rel_u64(&order_context(qi)->lock[i],
 						 sched_local.ordered.ctx + 1);
 	}
 
@@ -1085,8 +1766,13 @@ static inline void release_ordered(void)
 
 	ordered_stash_release();
 
+	if (has_reorder_window(qi)) {
+		reorder_release(qi, sched_local.ordered.ctx + 1);
+		return;
+	}
+
 	/* Next thread can continue processing */
-	odp_atomic_add_rel_u64(&sched->order[qi].ctx, 1);
+	odp_atomic_add_rel_u64(&order_context(qi)->ctx, 1);
 }
 
 static void schedule_release_ordered(void)
@@ -1198,6 +1884,77 @@ static inline int balance_spread(int grp, int prio, int cur_spr)
 	return new_spr;
 }
 
+static inline uint32_t lat_stats_bin(uint64_t val, uint32_t num_bins)
+{
+	uint32_t bin;
+
+	if (val == 0)
+		return 0;
+
+	bin = 64 - __builtin_clzll(val);
+
+	return bin < num_bins ? bin : num_bins - 1;
+}
+
+/* Update latency statistics of a dispatch. Latency is UINT64_MAX when none of the events
+ * was sampled. Burst sizes are sampled with the same rate as events. */
+static inline void lat_stats_update(int grp, int prio, int sync, uint32_t num, uint64_t lat_ns)
+{
+	lat_stats_t *stats = &sched->lat_stats[grp][prio][sync];
+
+	if (lat_ns != UINT64_MAX) {
+		odp_atomic_inc_u64(&stats->num_sample);
+		odp_atomic_min_u64(&stats->min_ns, lat_ns);
+		odp_atomic_max_u64(&stats->max_ns, lat_ns);
+		odp_atomic_add_u64(&stats->sum_ns, lat_ns);
+		odp_atomic_inc_u64(&stats->latency[lat_stats_bin(lat_ns,
+								 ODP_SCHED_LATENCY_HIST_BINS)]);
+	}
+
+	if (++sched_local.lat_burst_cnt >= sched->lat_sample) {
+		sched_local.lat_burst_cnt = 0;
+		/* Bin N counts burst sizes from 2^N to 2^(N+1) - 1 */
+		uint32_t bin = lat_stats_bin(num, ODP_SCHED_BURST_HIST_BINS + 1) - 1;
+
+		odp_atomic_inc_u64(&stats->burst[bin]);
+	}
+}
+
+/* Select the spread with the largest event backlog. Backlog of a spread is estimated as the
+ * number of events in the queue at the head of its ring multiplied by the number of ready
+ * queues in the ring. Returns -1 when other spreads have no queues ready for scheduling. */
+static inline int steal_spread(int grp, int prio, int cur_spr)
+{
+	int spr;
+	uint32_t qi;
+	uint64_t backlog;
+	uint64_t max_backlog = 0;
+	ring_u32_t *ring;
+	int num_spread = sched->config.num_spread;
+	int new_spr = -1;
+
+	for (spr = 0; spr < num_spread; spr++) {
+		if (spr == cur_spr || (sched->prio_q_mask[grp][prio] & (1 << spr)) == 0)
+			continue;
+
+		ring = sched->prio_q[grp][prio][spr];
+
+		if (ring == NULL || ring_u32_peek(ring, sched->ring_mask, &qi) == 0)
+			continue;
+
+		/* Count a ready queue as at least one event, the head queue may have been
+		 * emptied meanwhile. */
+		backlog = (uint64_t)ring_u32_len(ring) * _ODP_MAX(_odp_sched_queue_len(qi), 1u);
+
+		if (backlog > max_backlog) {
+			new_spr = spr;
+			max_backlog = backlog;
+		}
+	}
+
+	return new_spr;
+}
+
 static inline int copy_from_stash(odp_event_t out_ev[], uint32_t max)
 {
 	int i = 0;
@@ -1273,6 +2030,33 @@ static inline int queue_is_pktin(uint32_t queue_index)
 	return sched->queue[queue_index].poll_pktin;
 }
 
+/* Adapt burst sizes to the current queue backlog. A deep queue is served with bursts up to
+ * the configured maximum (and stash size) to maximize throughput. Events of a shallow
+ * parallel or ordered queue of default or higher priority are spread over the threads
+ * serving the queue in small bursts, so that the events are not serialized through the
+ * stash of a single thread. */
+static inline void adapt_burst(uint32_t qi, int grp, int prio, int spr, int sync,
+			       uint32_t *burst_def, uint32_t *burst_max)
+{
+	uint32_t len = _odp_sched_queue_len(qi);
+	uint32_t num_thr, burst;
+
+	if (len > *burst_def) {
+		*burst_def = _ODP_MIN(_ODP_MIN(len, *burst_max), (uint32_t)STASH_SIZE);
+		return;
+	}
+
+	if (sync == ODP_SCHED_SYNC_ATOMIC || prio > prio_level_from_api(schedule_default_prio()))
+		return;
+
+	num_thr = sched->sched_grp[grp].spread_thrs[spr];
+	burst = num_thr > 1 ? (len + num_thr - 1) / num_thr : len;
+	burst = _ODP_MAX(burst, 1u);
+
+	*burst_def = _ODP_MIN(*burst_def, burst);
+	*burst_max = _ODP_MIN(*burst_max, burst);
+}
+
 static inline int poll_pktin(uint32_t qi, int direct_recv,
 			     odp_event_t ev_tbl[], int max_num)
 {
@@ -1362,33 +2146,57 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 		odp_queue_t handle;
 		ring_u32_t *ring;
 		int pktin;
-		uint32_t max_deq;
+		uint32_t max_deq, burst_max;
 		int stashed = 1;
 		odp_event_t *ev_tbl = sched_local.stash.ev;
+		uint64_t lat_ns = UINT64_MAX;
 
 		if (spr >= num_spread)
 			spr = 0;
 
-		/* No queues allocated to this spread */
-		if (odp_unlikely((sched->prio_q_mask[grp][prio] & (1 << spr)) == 0)) {
-			i++;
-			spr++;
-			continue;
-		}
+		ring = sched->prio_q[grp][prio][spr];
 
-		ring = &sched->prio_q[grp][prio][spr].ring;
+		/* Get queue index from the spread queue. Skip the ring when no queues are
+		 * allocated to this spread. Mask may be seen updated before the ring pointer
+		 * of a newly reserved ring. */
+		if (odp_unlikely((sched->prio_q_mask[grp][prio] & (1 << spr)) == 0 ||
+				 ring == NULL) ||
+		    ring_u32_deq(ring, ring_mask, &qi) == 0) {
+			int steal_spr;
 
-		/* Get queue index from the spread queue */
-		if (ring_u32_deq(ring, ring_mask, &qi) == 0) {
-			/* Spread queue is empty */
-			i++;
-			spr++;
-			continue;
+			if (odp_likely(!sched->work_steal || i)) {
+				/* Spread queue is empty */
+				i++;
+				spr++;
+				continue;
+			}
+
+			/* The first spread is empty. Instead of polling other spreads in
+			 * round-robin order, steal from the one with the most queues waiting. */
+			steal_spr = steal_spread(grp, prio, spr);
+			if (steal_spr < 0)
+				return 0;
+
+			spr  = steal_spr;
+			ring = sched->prio_q[grp][prio][spr];
+
+			if (ring_u32_deq(ring, ring_mask, &qi) == 0) {
+				/* Lost the race to other threads. Continue round-robin from
+				 * the next spread. */
+				i++;
+				spr++;
+				continue;
+			}
 		}
 
-		sync_ctx = sched_sync_type(qi);
-		ordered  = (sync_ctx == ODP_SCHED_SYNC_ORDERED);
-		max_deq = burst_def_sync[sync_ctx];
+		sync_ctx  = sched_sync_type(qi);
+		ordered   = (sync_ctx == ODP_SCHED_SYNC_ORDERED);
+		max_deq   = burst_def_sync[sync_ctx];
+		burst_max = burst_max_sync[sync_ctx];
+		pktin     = queue_is_pktin(qi);
+
+		if (odp_unlikely(sched->burst_adaptive) && !pktin)
+			adapt_burst(qi, grp, prio, spr, sync_ctx, &max_deq, &burst_max);
 
 		/* When application's array is larger than default burst
 		 * size, output all events directly there. Also, ordered
@@ -1396,8 +2204,6 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 		 * parallelism. Ordered context can only be released
 		 * when the local cache is empty. */
 		if (max_num > max_deq || ordered) {
-			const uint32_t burst_max = burst_max_sync[sync_ctx];
-
 			stashed = 0;
 			ev_tbl  = out_ev;
 			max_deq = max_num;
@@ -1405,8 +2211,6 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 				max_deq = burst_max;
 		}
 
-		pktin = queue_is_pktin(qi);
-
 		/* Update queue spread before dequeue. Dequeue changes status of an empty
 		 * queue, which enables a following enqueue operation to insert the queue
 		 * back into scheduling (with new spread). */
@@ -1415,12 +2219,12 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 
 			if (new_spr != spr) {
 				sched->queue[qi].spread = new_spr;
-				ring = &sched->prio_q[grp][prio][new_spr].ring;
+				ring = sched->prio_q[grp][prio][new_spr];
 				update_queue_count(grp, prio, spr, new_spr);
 			}
 		}
 
-		num = _odp_sched_queue_deq(qi, ev_tbl, max_deq, !pktin);
+		num = _odp_sched_queue_deq(qi, ev_tbl, max_deq, !pktin, &lat_ns);
 
 		if (odp_unlikely(num < 0)) {
 			/* Remove destroyed queue from scheduling. Continue scheduling
@@ -1449,7 +2253,7 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			if (num_pkt == 0 || !direct_recv) {
 				/* No packets to be returned. Continue scheduling
 				 * packet input queue even when it is empty. */
-				ring_u32_enq(ring, ring_mask, qi);
+				requeue_sched_queue(ring, qi);
 
 				/* Continue scheduling from the next spread */
 				i++;
@@ -1461,18 +2265,21 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			num = num_pkt;
 		}
 
+		if (odp_unlikely(sched->lat_sample))
+			lat_stats_update(grp, prio, sync_ctx, num, lat_ns);
+
 		if (ordered) {
 			uint64_t ctx;
 			odp_atomic_u64_t *next_ctx;
 
-			next_ctx = &sched->order[qi].next_ctx;
+			next_ctx = &order_context(qi)->next_ctx;
 			ctx = odp_atomic_fetch_inc_u64(next_ctx);
 
 			sched_local.ordered.ctx = ctx;
 			sched_local.ordered.src_queue = qi;
 
 			/* Continue scheduling ordered queues */
-			ring_u32_enq(ring, ring_mask, qi);
+			requeue_sched_queue(ring, qi);
 			sched_local.sync_ctx = sync_ctx;
 
 		} else if (sync_ctx == ODP_SCHED_SYNC_ATOMIC) {
@@ -1480,9 +2287,10 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 			sched_local.stash.qi   = qi;
 			sched_local.stash.ring = ring;
 			sched_local.sync_ctx   = sync_ctx;
+			sched_local.atomic_hold = 0;
 		} else {
 			/* Continue scheduling parallel queues */
-			ring_u32_enq(ring, ring_mask, qi);
+			requeue_sched_queue(ring, qi);
 		}
 
 		handle = queue_from_index(qi);
@@ -1507,6 +2315,65 @@ static inline int schedule_grp_prio(odp_queue_t *out_queue, odp_event_t out_ev[]
 	return 0;
 }
 
+/* Continue scheduling the atomic queue, which context the thread holds, without returning
+ * the queue into the spread ring in between. Releases the context when the queue is empty. */
+static inline int schedule_atomic_hold(odp_queue_t *out_queue, odp_event_t out_ev[],
+				       uint32_t max_num)
+{
+	int num, ret;
+	odp_queue_t handle;
+	uint32_t qi = sched_local.stash.qi;
+	int prio = sched->queue[qi].prio;
+	uint32_t max_deq = sched->config.burst_default[ODP_SCHED_SYNC_ATOMIC][prio];
+	uint32_t burst_max = sched->config.burst_max[ODP_SCHED_SYNC_ATOMIC][prio];
+	odp_event_t *ev_tbl = sched_local.stash.ev;
+	int stashed = 1;
+	uint64_t lat_ns = UINT64_MAX;
+
+	if (odp_unlikely(sched->burst_adaptive))
+		adapt_burst(qi, sched->queue[qi].grp, prio, sched->queue[qi].spread,
+			    ODP_SCHED_SYNC_ATOMIC, &max_deq, &burst_max);
+
+	if (max_num > max_deq) {
+		stashed = 0;
+		ev_tbl  = out_ev;
+		max_deq = max_num;
+		if (max_num > burst_max)
+			max_deq = burst_max;
+	}
+
+	num = _odp_sched_queue_deq(qi, ev_tbl, max_deq, 1, &lat_ns);
+
+	if (num <= 0) {
+		/* Queue is empty and was removed from scheduling, or it has been destroyed.
+		 * In both cases, the queue must not be returned into the spread ring. */
+		sched_local.sync_ctx = NO_SYNC_CONTEXT;
+		return 0;
+	}
+
+	sched_local.atomic_hold++;
+
+	if (odp_unlikely(sched->lat_sample))
+		lat_stats_update(sched->queue[qi].grp, prio, ODP_SCHED_SYNC_ATOMIC, num, lat_ns);
+
+	handle = queue_from_index(qi);
+
+	if (stashed) {
+		sched_local.stash.num_ev   = num;
+		sched_local.stash.ev_index = 0;
+		sched_local.stash.queue    = handle;
+		ret = copy_from_stash(out_ev, max_num);
+	} else {
+		sched_local.stash.num_ev = 0;
+		ret = num;
+	}
+
+	if (out_queue)
+		*out_queue = handle;
+
+	return ret;
+}
+
 /*
  * Schedule queues
  */
@@ -1529,10 +2396,20 @@ static inline int do_schedule(odp_queue_t *out_q, odp_event_t out_ev[], uint32_t
 	}
 
 	/* Release schedule context */
-	if (sched_local.sync_ctx == ODP_SCHED_SYNC_ATOMIC)
-		release_atomic();
-	else if (sched_local.sync_ctx == ODP_SCHED_SYNC_ORDERED)
+	if (sched_local.sync_ctx == ODP_SCHED_SYNC_ATOMIC) {
+		/* Keep the atomic context for a limited number of rounds */
+		if (sched_local.atomic_hold < sched->config.atomic_hold && !sched_local.pause &&
+		    !queue_is_pktin(sched_local.stash.qi)) {
+			ret = schedule_atomic_hold(out_q, out_ev, max_num);
+
+			if (ret)
+				return ret;
+		} else {
+			release_atomic();
+		}
+	} else if (sched_local.sync_ctx == ODP_SCHED_SYNC_ORDERED) {
 		release_ordered();
+	}
 
 	if (odp_unlikely(sched_local.pause))
 		return 0;
@@ -1660,6 +2537,37 @@ static inline int schedule_loop(odp_queue_t *out_queue, uint64_t wait,
 	return ret;
 }
 
+/* Block until a queue becomes ready for scheduling, or 'timeout_ns' has passed (0: no timeout).
+ * Returns number of events, when events were found before blocking. */
+static inline int sleep_block(odp_queue_t *out_queue, odp_event_t out_ev[], uint32_t max_num,
+			      uint64_t timeout_ns)
+{
+	struct timespec ts;
+	uint32_t seq = odp_atomic_load_u32(&sched->sleep.seq);
+	int ret;
+
+	odp_atomic_inc_u32(&sched->sleep.num);
+
+	/* Number of sleepers must be visible before rings are checked. Pairs with the barrier
+	 * in wake_sleepers(). */
+	odp_mb_full();
+
+	ret = do_schedule(out_queue, out_ev, max_num);
+
+	if (ret == 0) {
+		ts.tv_sec  = timeout_ns / ODP_TIME_SEC_IN_NS;
+		ts.tv_nsec = timeout_ns % ODP_TIME_SEC_IN_NS;
+
+		/* Returns immediately, if 'seq' has been already incremented */
+		syscall(SYS_futex, &sched->sleep.seq, FUTEX_WAIT, seq,
+			timeout_ns ? &ts : NULL, NULL, 0);
+	}
+
+	odp_atomic_dec_u32(&sched->sleep.num);
+
+	return ret;
+}
+
 static inline int schedule_loop_sleep(odp_queue_t *out_queue, uint64_t wait,
 				      odp_event_t out_ev[], uint32_t max_num)
 {
@@ -1686,8 +2594,31 @@ static inline int schedule_loop_sleep(odp_queue_t *out_queue, uint64_t wait,
 			continue;
 		}
 
-		if (sleep)
+		if (sleep && sched->powersave.block) {
+			uint64_t timeout_ns = sched->powersave.sleep_ns;
+
+			if (wait != ODP_SCHED_WAIT) {
+				odp_time_t now = odp_time_local();
+				uint64_t left_ns = 0;
+
+				if (odp_time_cmp(end, now) > 0)
+					left_ns = odp_time_diff_ns(end, now);
+
+				if (timeout_ns == 0 || left_ns < timeout_ns)
+					timeout_ns = left_ns;
+			}
+
+			/* Zero timeout would block without a time limit */
+			if (wait == ODP_SCHED_WAIT || timeout_ns) {
+				ret = sleep_block(out_queue, out_ev, max_num, timeout_ns);
+				if (ret) {
+					timer_run(2);
+					break;
+				}
+			}
+		} else if (sleep) {
 			nanosleep(&sched->powersave.sleep_time, NULL);
+		}
 
 		if (wait != ODP_SCHED_WAIT || !sleep) {
 			current = odp_time_local();
@@ -1795,7 +2726,7 @@ static void schedule_order_lock(uint32_t lock_index)
 	_ODP_ASSERT(lock_index <= sched->queue[queue_index].order_lock_count &&
 		    !sched_local.ordered.lock_called.u8[lock_index]);
 
-	ord_lock = &sched->order[queue_index].lock[lock_index];
+	ord_lock = &order_context(queue_index)->lock[lock_index];
 
 	/* Busy loop to synchronize ordered processing */
 	while (1) {
@@ -1823,7 +2754,7 @@ static void schedule_order_unlock(uint32_t lock_index)
 
 	_ODP_ASSERT(lock_index <= sched->queue[queue_index].order_lock_count);
 
-	ord_lock = &sched->order[queue_index].lock[lock_index];
+	ord_lock = &order_context(queue_index)->lock[lock_index];
 
 	_ODP_ASSERT(sched_local.ordered.ctx == odp_atomic_load_u64(ord_lock));
 
@@ -2209,10 +3140,110 @@ static int schedule_capability(odp_schedule_capability_t *capa)
 	capa->max_queue_size = _odp_queue_glb->config.max_queue_size;
 	capa->max_flow_id = BUF_HDR_MAX_FLOW_ID;
 	capa->order_wait = ODP_SUPPORT_YES;
+	capa->latency_stats = sched->lat_stats != NULL;
 
 	return 0;
 }
 
+static int schedule_latency_stats(odp_schedule_group_t group, odp_schedule_prio_t prio,
+				  odp_schedule_sync_t sync, odp_schedule_latency_stats_t *stats)
+{
+	lat_stats_t *lat_stats;
+	int i;
+
+	if (sched->lat_stats == NULL) {
+		_ODP_ERR("Latency statistics not enabled\n");
+		return -1;
+	}
+
+	if (group < 0 || group >= NUM_SCHED_GRPS || prio < schedule_min_prio() ||
+	    prio > schedule_max_prio() || (int)sync < 0 || sync >= NUM_SCHED_SYNC) {
+		_ODP_ERR("Bad parameter\n");
+		return -1;
+	}
+
+	lat_stats = &sched->lat_stats[group][prio_level_from_api(prio)][sync];
+
+	stats->sample_rate = sched->lat_sample;
+	stats->num_sample  = odp_atomic_load_u64(&lat_stats->num_sample);
+	stats->min_latency = 0;
+	stats->max_latency = odp_atomic_load_u64(&lat_stats->max_ns);
+	stats->avg_latency = 0;
+
+	if (stats->num_sample) {
+		stats->min_latency = odp_atomic_load_u64(&lat_stats->min_ns);
+		stats->avg_latency = odp_atomic_load_u64(&lat_stats->sum_ns) / stats->num_sample;
+	}
+
+	for (i = 0; i < ODP_SCHED_LATENCY_HIST_BINS; i++)
+		stats->latency[i] = odp_atomic_load_u64(&lat_stats->latency[i]);
+
+	for (i = 0; i < ODP_SCHED_BURST_HIST_BINS; i++)
+		stats->burst[i] = odp_atomic_load_u64(&lat_stats->burst[i]);
+
+	return 0;
+}
+
+static int schedule_latency_stats_reset(void)
+{
+	if (sched->lat_stats == NULL) {
+		_ODP_ERR("Latency statistics not enabled\n");
+		return -1;
+	}
+
+	lat_stats_reset();
+
+	return 0;
+}
+
+static void lat_stats_print(void)
+{
+	int grp, prio, sync, i;
+	uint64_t val, num;
+	static const char * const sync_str[NUM_SCHED_SYNC] = {"parallel", "atomic", "ordered"};
+
+	_ODP_PRINT("\n  Latency statistics (sample rate 1/%u):\n", sched->lat_sample);
+
+	for (grp = 0; grp < NUM_SCHED_GRPS; grp++) {
+		for (prio = 0; prio < NUM_PRIO; prio++) {
+			for (sync = 0; sync < NUM_SCHED_SYNC; sync++) {
+				lat_stats_t *stats = &sched->lat_stats[grp][prio][sync];
+
+				num = odp_atomic_load_u64(&stats->num_sample);
+
+				if (num == 0)
+					continue;
+
+				_ODP_PRINT("    group %i, prio %i, %s: %" PRIu64 " samples\n", grp,
+					   prio, sync_str[sync], num);
+				_ODP_PRINT("      min/avg/max (nsec): %" PRIu64 " / %" PRIu64 " / %"
+					   PRIu64 "\n", odp_atomic_load_u64(&stats->min_ns),
+					   odp_atomic_load_u64(&stats->sum_ns) / num,
+					   odp_atomic_load_u64(&stats->max_ns));
+				_ODP_PRINT("      latency (nsec):\n");
+
+				for (i = 0; i < ODP_SCHED_LATENCY_HIST_BINS; i++) {
+					val = odp_atomic_load_u64(&stats->latency[i]);
+					if (val)
+						_ODP_PRINT("        >= %-10" PRIu64 " %12"
+							   PRIu64 "\n",
+							   i ? (uint64_t)1 << (i - 1) : 0,
+							   val);
+				}
+
+				_ODP_PRINT("      burst size:\n");
+
+				for (i = 0; i < ODP_SCHED_BURST_HIST_BINS; i++) {
+					val = odp_atomic_load_u64(&stats->burst[i]);
+					if (val)
+						_ODP_PRINT("        >= %-10u %12" PRIu64 "\n",
+							   1u << i, val);
+				}
+			}
+		}
+	}
+}
+
 static void schedule_print(void)
 {
 	int spr, prio, grp, pos;
@@ -2264,8 +3295,8 @@ static void schedule_print(void)
 
 			for (spr = 0; spr < num_spread; spr++) {
 				num_queues = sched->prio_q_count[grp][prio][spr];
-				ring = &sched->prio_q[grp][prio][spr].ring;
-				num_active = ring_u32_len(ring);
+				ring = sched->prio_q[grp][prio][spr];
+				num_active = ring ? ring_u32_len(ring) : 0;
 				pos += _odp_snprint(&str[pos], size - pos, " %3u/%3u",
 						    num_active, num_queues);
 			}
@@ -2292,6 +3323,9 @@ static void schedule_print(void)
 		_ODP_PRINT("%s\n", str);
 	}
 
+	if (sched->lat_stats)
+		lat_stats_print();
+
 	_ODP_PRINT("\n");
 }
 
@@ -2365,7 +3399,9 @@ const _odp_schedule_api_fn_t _odp_schedule_basic_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_latency_stats   = schedule_latency_stats,
+	.schedule_latency_stats_reset = schedule_latency_stats_reset
 };
 
 /* API functions used when powersave is enabled in the config file. */
@@ -2402,5 +3438,7 @@ const _odp_schedule_api_fn_t _odp_schedule_basic_sleep_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_latency_stats   = schedule_latency_stats,
+	.schedule_latency_stats_reset = schedule_latency_stats_reset
 };
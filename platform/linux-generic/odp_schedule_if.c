@@ -130,6 +130,17 @@ int odp_schedule_group_info(odp_schedule_group_t group,
 	return _odp_sched_api->schedule_group_info(group, info);
 }
 
+int odp_schedule_latency_stats(odp_schedule_group_t group, odp_schedule_prio_t prio,
+			       odp_schedule_sync_t sync, odp_schedule_latency_stats_t *stats)
+{
+	return _odp_sched_api->schedule_latency_stats(group, prio, sync, stats);
+}
+
+int odp_schedule_latency_stats_reset(void)
+{
+	return _odp_sched_api->schedule_latency_stats_reset();
+}
+
 void odp_schedule_print(void)
 {
 	_odp_sched_api->schedule_print();
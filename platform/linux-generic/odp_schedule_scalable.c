@@ -2169,6 +2169,19 @@ static int schedule_capability(odp_schedule_capability_t *capa)
 	return 0;
 }
 
+static int schedule_latency_stats(odp_schedule_group_t group ODP_UNUSED,
+				  odp_schedule_prio_t prio ODP_UNUSED,
+				  odp_schedule_sync_t sync ODP_UNUSED,
+				  odp_schedule_latency_stats_t *stats ODP_UNUSED)
+{
+	return -1;
+}
+
+static int schedule_latency_stats_reset(void)
+{
+	return -1;
+}
+
 static void schedule_print(void)
 {
 	odp_schedule_capability_t capa;
@@ -2240,5 +2253,7 @@ const _odp_schedule_api_fn_t _odp_schedule_scalable_api = {
 	.schedule_order_lock_start	= schedule_order_lock_start,
 	.schedule_order_lock_wait	= schedule_order_lock_wait,
 	.schedule_order_wait		= order_lock,
-	.schedule_print			= schedule_print
+	.schedule_print			= schedule_print,
+	.schedule_latency_stats		= schedule_latency_stats,
+	.schedule_latency_stats_reset	= schedule_latency_stats_reset
 };
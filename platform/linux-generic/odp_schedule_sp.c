@@ -252,7 +252,7 @@ static int term_global(void)
 		int report = 1;
 
 		if (sched_global->queue_cmd[qi].init) {
-			while (_odp_sched_queue_deq(qi, &event, 1, 1) > 0) {
+			while (_odp_sched_queue_deq(qi, &event, 1, 1, NULL) > 0) {
 				if (report) {
 					_ODP_ERR("Queue not empty\n");
 					report = 0;
@@ -696,7 +696,7 @@ static int schedule_multi(odp_queue_t *from, uint64_t wait,
 		}
 
 		qi  = cmd->index;
-		num = _odp_sched_queue_deq(qi, events, 1, 1);
+		num = _odp_sched_queue_deq(qi, events, 1, 1, NULL);
 
 		if (num <= 0) {
 			timer_run(1);
@@ -1040,6 +1040,19 @@ static int schedule_capability(odp_schedule_capability_t *capa)
 	return 0;
 }
 
+static int schedule_latency_stats(odp_schedule_group_t group ODP_UNUSED,
+				  odp_schedule_prio_t prio ODP_UNUSED,
+				  odp_schedule_sync_t sync ODP_UNUSED,
+				  odp_schedule_latency_stats_t *stats ODP_UNUSED)
+{
+	return -1;
+}
+
+static int schedule_latency_stats_reset(void)
+{
+	return -1;
+}
+
 static void schedule_print(void)
 {
 	odp_schedule_capability_t capa;
@@ -1119,5 +1132,7 @@ const _odp_schedule_api_fn_t _odp_schedule_sp_api = {
 	.schedule_order_lock_start  = schedule_order_lock_start,
 	.schedule_order_lock_wait   = schedule_order_lock_wait,
 	.schedule_order_wait      = order_lock,
-	.schedule_print           = schedule_print
+	.schedule_print           = schedule_print,
+	.schedule_latency_stats   = schedule_latency_stats,
+	.schedule_latency_stats_reset = schedule_latency_stats_reset
 };
@@ -18,7 +18,7 @@
 
 /* Supported ODP_SHM_* flags */
 #define SUPPORTED_SHM_FLAGS (ODP_SHM_PROC | ODP_SHM_SINGLE_VA | ODP_SHM_EXPORT | \
-			     ODP_SHM_HP | ODP_SHM_NO_HP)
+			     ODP_SHM_HP | ODP_SHM_NO_HP | ODP_SHM_NUMA_LOCAL)
 
 static inline uint32_t from_handle(odp_shm_t shm)
 {
@@ -57,8 +57,8 @@ int odp_shm_capability(odp_shm_capability_t *capa)
 	return 0;
 }
 
-odp_shm_t odp_shm_reserve(const char *name, uint64_t size, uint64_t align,
-			  uint32_t flags)
+odp_shm_t _odp_shm_reserve(const char *name, uint64_t size, uint64_t align, uint32_t flags,
+			   int numa_node, uint32_t ishm_flags)
 {
 	int block_index;
 	uint32_t flgs = 0; /* internal ishm flags */
@@ -69,15 +69,26 @@ odp_shm_t odp_shm_reserve(const char *name, uint64_t size, uint64_t align,
 		return ODP_SHM_INVALID;
 	}
 
-	flgs = get_ishm_flags(flags);
+	flgs = get_ishm_flags(flags) | ishm_flags;
 
-	block_index = _odp_ishm_reserve(name, size, -1, align, 0, flgs, flags);
+	block_index = _odp_ishm_reserve(name, size, -1, align, 0, flgs, flags, numa_node);
 	if (block_index >= 0)
 		return to_handle(block_index);
 	else
 		return ODP_SHM_INVALID;
 }
 
+odp_shm_t odp_shm_reserve(const char *name, uint64_t size, uint64_t align,
+			  uint32_t flags)
+{
+	int numa_node = -1;
+
+	if (flags & ODP_SHM_NUMA_LOCAL)
+		numa_node = _odp_numa_node_current();
+
+	return _odp_shm_reserve(name, size, align, flags, numa_node, 0);
+}
+
 odp_shm_t odp_shm_import(const char *remote_name,
 			 odp_instance_t odp_inst,
 			 const char *local_name)
@@ -5,12 +5,15 @@
  */
 
 #include <odp/api/align.h>
+#include <odp/api/atomic.h>
 #include <odp/api/shared_memory.h>
 #include <odp/api/stash.h>
 #include <odp/api/std_types.h>
+#include <odp/api/thread.h>
 #include <odp/api/ticketlock.h>
 
 #include <odp/api/plat/strong_types.h>
+#include <odp/api/plat/thread_inlines.h>
 
 #include <odp_config_internal.h>
 #include <odp_debug_internal.h>
@@ -32,6 +35,15 @@ ODP_STATIC_ASSERT(CONFIG_INTERNAL_STASHES < CONFIG_MAX_STASHES, "TOO_MANY_INTERN
 
 #define MIN_RING_SIZE 64
 
+/* Maximum number of object handles in a thread local cache */
+#define MAX_CACHE_SIZE 256
+
+/* Maximum number of stashes with thread local caches */
+#define MAX_CACHED_STASHES 64
+
+/* Stash has no thread local cache */
+#define CACHE_NONE -1
+
 enum {
 	STASH_FREE = 0,
 	STASH_RESERVED,
@@ -54,34 +66,55 @@ typedef int32_t (*ring_u64_deq_multi_fn_t)(stash_t *stash, uint64_t val[], int32
 typedef int32_t (*ring_u64_deq_batch_fn_t)(stash_t *stash, uint64_t val[], int32_t num);
 typedef int32_t (*ring_u64_len_fn_t)(stash_t *stash);
 
+typedef union {
+	struct {
+		ring_u32_enq_multi_fn_t enq_multi;
+		ring_u32_enq_batch_fn_t enq_batch;
+		ring_u32_deq_multi_fn_t deq_multi;
+		ring_u32_deq_batch_fn_t deq_batch;
+		ring_u32_init_fn_t      init;
+		ring_u32_len_fn_t       len;
+	} u32;
+
+	struct {
+		ring_u64_enq_multi_fn_t enq_multi;
+		ring_u64_enq_batch_fn_t enq_batch;
+		ring_u64_deq_multi_fn_t deq_multi;
+		ring_u64_deq_batch_fn_t deq_batch;
+		ring_u64_init_fn_t      init;
+		ring_u64_len_fn_t       len;
+	} u64;
+} stash_ring_fn_t;
+
+/* Thread local object cache. Object handles are stored as uint32_t or uint64_t
+ * depending on the ring type of the stash. */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_atomic_u32_t cache_num;
+	uint64_t         data[];
+
+} stash_cache_t;
+
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wpedantic"
 typedef struct ODP_ALIGNED_CACHE stash_t {
-	/* Ring functions */
-	union {
-		struct {
-			ring_u32_enq_multi_fn_t enq_multi;
-			ring_u32_enq_batch_fn_t enq_batch;
-			ring_u32_deq_multi_fn_t deq_multi;
-			ring_u32_deq_batch_fn_t deq_batch;
-			ring_u32_init_fn_t      init;
-			ring_u32_len_fn_t       len;
-		} u32;
-
-		struct {
-			ring_u64_enq_multi_fn_t enq_multi;
-			ring_u64_enq_batch_fn_t enq_batch;
-			ring_u64_deq_multi_fn_t deq_multi;
-			ring_u64_deq_batch_fn_t deq_batch;
-			ring_u64_init_fn_t      init;
-			ring_u64_len_fn_t       len;
-		} u64;
-	} ring_fn;
+	/* Ring functions. These point to the cache functions when thread local
+	 * caching is enabled. */
+	stash_ring_fn_t ring_fn;
+
+	/* Shared ring functions */
+	stash_ring_fn_t shared_fn;
 
 	uint32_t  ring_mask;
 	uint32_t  ring_size;
 	uint32_t  obj_size;
 
+	/* Thread local caches */
+	uint32_t  cache_size;
+	uint32_t  cache_burst;
+	uint32_t  cache_stride;
+	uint8_t   *cache_base;
+	int       cache_idx;
+
 	char      name[ODP_STASH_NAME_LEN];
 	int       index;
 	uint8_t   strict_size;
@@ -118,6 +151,10 @@ typedef struct stash_global_t {
 	uint32_t          max_num;
 	uint32_t          max_num_obj;
 	uint32_t          num_internal;
+	uint32_t          max_num_cache;
+	uint64_t          cache_block_size;
+	uint8_t           *cache_data;
+	uint8_t           cache_used[MAX_CACHED_STASHES];
 	uint8_t           stash_state[CONFIG_MAX_STASHES];
 	stash_t           *stash[CONFIG_MAX_STASHES];
 	uint8_t           data[] ODP_ALIGNED_CACHE;
@@ -139,9 +176,10 @@ static inline odp_stash_t stash_handle(stash_t *stash)
 int _odp_stash_init_global(void)
 {
 	odp_shm_t shm;
-	uint32_t max_num, max_num_obj;
+	uint32_t max_num, max_num_obj, max_num_cache;
 	const char *str;
 	uint64_t ring_max_size, stash_max_size, stash_data_size, offset;
+	uint64_t cache_block_size, cache_data_size;
 	const uint32_t internal_stashes = odp_global_ro.disable.dma ? 0 : CONFIG_INTERNAL_STASHES;
 	uint8_t *stash_data;
 	int val = 0;
@@ -169,6 +207,19 @@ int _odp_stash_init_global(void)
 	_ODP_PRINT("  %s: %i\n", str, val);
 	max_num_obj = val;
 
+	str = "stash.max_num_cache";
+	if (!_odp_libconfig_lookup_int(str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", str);
+		return -1;
+	}
+	_ODP_PRINT("  %s: %i\n", str, val);
+
+	if (val < 0 || val > MAX_CACHED_STASHES) {
+		_ODP_ERR("Bad value %s = %i (max %i)\n", str, val, MAX_CACHED_STASHES);
+		return -1;
+	}
+	max_num_cache = val;
+
 	_ODP_PRINT("\n");
 
 	/* Reserve resources for implementation internal stashes */
@@ -190,7 +241,16 @@ int _odp_stash_init_global(void)
 						 (ring_max_size * sizeof(uint64_t)));
 	stash_data_size = max_num * stash_max_size;
 
-	shm = odp_shm_reserve("_odp_stash_global", sizeof(stash_global_t) + stash_data_size,
+	/* Thread local caches are reserved from the same block, so that caching does not
+	 * consume any additional shared memory blocks. A cache block holds maximum sized
+	 * caches for all threads. */
+	cache_block_size = (uint64_t)odp_thread_count_max() *
+			   _ODP_ROUNDUP_CACHE_LINE(sizeof(stash_cache_t) +
+						   MAX_CACHE_SIZE * sizeof(uint64_t));
+	cache_data_size = max_num_cache * cache_block_size;
+
+	shm = odp_shm_reserve("_odp_stash_global",
+			      sizeof(stash_global_t) + stash_data_size + cache_data_size,
 			      ODP_CACHE_LINE_SIZE, 0);
 
 	stash_global = odp_shm_addr(shm);
@@ -205,6 +265,9 @@ int _odp_stash_init_global(void)
 	stash_global->max_num = max_num;
 	stash_global->max_num_obj = max_num_obj;
 	stash_global->num_internal = internal_stashes;
+	stash_global->max_num_cache = max_num_cache;
+	stash_global->cache_block_size = cache_block_size;
+	stash_global->cache_data = stash_global->data + stash_data_size;
 	odp_ticketlock_init(&stash_global->lock);
 
 	/* Initialize stash pointers */
@@ -244,7 +307,6 @@ int odp_stash_capability(odp_stash_capability_t *capa, odp_stash_type_t type)
 		return -1;
 	}
 
-	(void)type;
 	max_stashes = stash_global->max_num - stash_global->num_internal;
 
 	memset(capa, 0, sizeof(odp_stash_capability_t));
@@ -264,6 +326,12 @@ int odp_stash_capability(odp_stash_capability_t *capa, odp_stash_type_t type)
 	capa->max_put_batch        = MIN_RING_SIZE;
 	capa->stats.bit.count      = 1;
 
+	/* Caching would break FIFO order of the objects */
+	if (type != ODP_STASH_TYPE_FIFO && stash_global->max_num_cache) {
+		capa->max_cache_size        = MAX_CACHE_SIZE;
+		capa->stats.bit.cache_count = 1;
+	}
+
 	return 0;
 }
 
@@ -303,6 +371,34 @@ static void free_index(int i)
 	odp_ticketlock_unlock(&stash_global->lock);
 }
 
+static int reserve_cache(void)
+{
+	int idx = CACHE_NONE;
+
+	odp_ticketlock_lock(&stash_global->lock);
+
+	for (uint32_t i = 0; i < stash_global->max_num_cache; i++) {
+		if (!stash_global->cache_used[i]) {
+			idx = i;
+			stash_global->cache_used[i] = 1;
+			break;
+		}
+	}
+
+	odp_ticketlock_unlock(&stash_global->lock);
+
+	return idx;
+}
+
+static void free_cache(int idx)
+{
+	odp_ticketlock_lock(&stash_global->lock);
+
+	stash_global->cache_used[idx] = 0;
+
+	odp_ticketlock_unlock(&stash_global->lock);
+}
+
 static inline void strict_ring_u32_init(stash_t *stash)
 {
 	ring_u32_init(&stash->ring_u32.hdr);
@@ -439,6 +535,311 @@ static inline int32_t mpmc_ring_u64_len(stash_t *stash)
 	return ring_mpmc_u64_len(&stash->ring_mpmc_u64.hdr);
 }
 
+static inline stash_cache_t *stash_cache(stash_t *stash)
+{
+	return (stash_cache_t *)(uintptr_t)(stash->cache_base +
+					    odp_thread_id() * stash->cache_stride);
+}
+
+static inline int32_t cache_u32_put(stash_t *stash, const uint32_t val[], int32_t num,
+				    odp_bool_t is_batch)
+{
+	stash_cache_t *cache;
+	uint32_t *data;
+	uint32_t cache_num;
+	const uint32_t cache_size = stash->cache_size;
+	int32_t i;
+
+	if (odp_unlikely((uint32_t)num > cache_size)) {
+		if (is_batch)
+			return stash->shared_fn.u32.enq_batch(stash, val, num);
+
+		return stash->shared_fn.u32.enq_multi(stash, val, num);
+	}
+
+	cache = stash_cache(stash);
+	data = (uint32_t *)(uintptr_t)cache->data;
+	cache_num = odp_atomic_load_u32(&cache->cache_num);
+
+	if (odp_unlikely(cache_num + num > cache_size)) {
+		/* Move objects from the top of the cache into the shared ring */
+		uint32_t num_move = cache_num + num - cache_size;
+		uint32_t first;
+		int32_t num_enq;
+
+		if (num_move < stash->cache_burst)
+			num_move = stash->cache_burst;
+		if (num_move > cache_num)
+			num_move = cache_num;
+
+		first = cache_num - num_move;
+		num_enq = stash->shared_fn.u32.enq_multi(stash, &data[first], num_move);
+
+		if (odp_unlikely((uint32_t)num_enq < num_move))
+			memmove(&data[first], &data[first + num_enq],
+				(num_move - num_enq) * sizeof(uint32_t));
+
+		cache_num -= num_enq;
+
+		if (odp_unlikely(cache_num + num > cache_size)) {
+			/* Shared ring is full */
+			if (is_batch) {
+				odp_atomic_store_u32(&cache->cache_num, cache_num);
+				return 0;
+			}
+
+			num = cache_size - cache_num;
+		}
+	}
+
+	for (i = 0; i < num; i++)
+		data[cache_num + i] = val[i];
+
+	odp_atomic_store_u32(&cache->cache_num, cache_num + num);
+
+	return num;
+}
+
+static inline int32_t cache_u64_put(stash_t *stash, const uint64_t val[], int32_t num,
+				    odp_bool_t is_batch)
+{
+	stash_cache_t *cache;
+	uint64_t *data;
+	uint32_t cache_num;
+	const uint32_t cache_size = stash->cache_size;
+	int32_t i;
+
+	if (odp_unlikely((uint32_t)num > cache_size)) {
+		if (is_batch)
+			return stash->shared_fn.u64.enq_batch(stash, val, num);
+
+		return stash->shared_fn.u64.enq_multi(stash, val, num);
+	}
+
+	cache = stash_cache(stash);
+	data = cache->data;
+	cache_num = odp_atomic_load_u32(&cache->cache_num);
+
+	if (odp_unlikely(cache_num + num > cache_size)) {
+		/* Move objects from the top of the cache into the shared ring */
+		uint32_t num_move = cache_num + num - cache_size;
+		uint32_t first;
+		int32_t num_enq;
+
+		if (num_move < stash->cache_burst)
+			num_move = stash->cache_burst;
+		if (num_move > cache_num)
+			num_move = cache_num;
+
+		first = cache_num - num_move;
+		num_enq = stash->shared_fn.u64.enq_multi(stash, &data[first], num_move);
+
+		if (odp_unlikely((uint32_t)num_enq < num_move))
+			memmove(&data[first], &data[first + num_enq],
+				(num_move - num_enq) * sizeof(uint64_t));
+
+		cache_num -= num_enq;
+
+		if (odp_unlikely(cache_num + num > cache_size)) {
+			/* Shared ring is full */
+			if (is_batch) {
+				odp_atomic_store_u32(&cache->cache_num, cache_num);
+				return 0;
+			}
+
+			num = cache_size - cache_num;
+		}
+	}
+
+	for (i = 0; i < num; i++)
+		data[cache_num + i] = val[i];
+
+	odp_atomic_store_u32(&cache->cache_num, cache_num + num);
+
+	return num;
+}
+
+static inline int32_t cache_u32_get(stash_t *stash, uint32_t val[], int32_t num,
+				    odp_bool_t is_batch)
+{
+	stash_cache_t *cache;
+	uint32_t *data;
+	uint32_t cache_num;
+	const uint32_t cache_size = stash->cache_size;
+	int32_t i;
+
+	if (odp_unlikely((uint32_t)num > cache_size)) {
+		if (is_batch)
+			return stash->shared_fn.u32.deq_batch(stash, val, num);
+
+		return stash->shared_fn.u32.deq_multi(stash, val, num);
+	}
+
+	cache = stash_cache(stash);
+	data = (uint32_t *)(uintptr_t)cache->data;
+	cache_num = odp_atomic_load_u32(&cache->cache_num);
+
+	if (odp_unlikely(cache_num < (uint32_t)num)) {
+		/* Refill the cache from the shared ring */
+		uint32_t num_deq = num - cache_num + stash->cache_burst;
+
+		if (num_deq > cache_size - cache_num)
+			num_deq = cache_size - cache_num;
+
+		cache_num += stash->shared_fn.u32.deq_multi(stash, &data[cache_num], num_deq);
+
+		if (odp_unlikely(cache_num < (uint32_t)num)) {
+			if (is_batch) {
+				odp_atomic_store_u32(&cache->cache_num, cache_num);
+				return 0;
+			}
+
+			num = cache_num;
+		}
+	}
+
+	/* Most recently stored objects are output first */
+	for (i = 0; i < num; i++)
+		val[i] = data[cache_num - 1 - i];
+
+	odp_atomic_store_u32(&cache->cache_num, cache_num - num);
+
+	return num;
+}
+
+static inline int32_t cache_u64_get(stash_t *stash, uint64_t val[], int32_t num,
+				    odp_bool_t is_batch)
+{
+	stash_cache_t *cache;
+	uint64_t *data;
+	uint32_t cache_num;
+	const uint32_t cache_size = stash->cache_size;
+	int32_t i;
+
+	if (odp_unlikely((uint32_t)num > cache_size)) {
+		if (is_batch)
+			return stash->shared_fn.u64.deq_batch(stash, val, num);
+
+		return stash->shared_fn.u64.deq_multi(stash, val, num);
+	}
+
+	cache = stash_cache(stash);
+	data = cache->data;
+	cache_num = odp_atomic_load_u32(&cache->cache_num);
+
+	if (odp_unlikely(cache_num < (uint32_t)num)) {
+		/* Refill the cache from the shared ring */
+		uint32_t num_deq = num - cache_num + stash->cache_burst;
+
+		if (num_deq > cache_size - cache_num)
+			num_deq = cache_size - cache_num;
+
+		cache_num += stash->shared_fn.u64.deq_multi(stash, &data[cache_num], num_deq);
+
+		if (odp_unlikely(cache_num < (uint32_t)num)) {
+			if (is_batch) {
+				odp_atomic_store_u32(&cache->cache_num, cache_num);
+				return 0;
+			}
+
+			num = cache_num;
+		}
+	}
+
+	/* Most recently stored objects are output first */
+	for (i = 0; i < num; i++)
+		val[i] = data[cache_num - 1 - i];
+
+	odp_atomic_store_u32(&cache->cache_num, cache_num - num);
+
+	return num;
+}
+
+static int32_t cache_u32_enq_multi(stash_t *stash, const uint32_t val[], int32_t num)
+{
+	return cache_u32_put(stash, val, num, false);
+}
+
+static int32_t cache_u32_enq_batch(stash_t *stash, const uint32_t val[], int32_t num)
+{
+	return cache_u32_put(stash, val, num, true);
+}
+
+static int32_t cache_u32_deq_multi(stash_t *stash, uint32_t val[], int32_t num)
+{
+	return cache_u32_get(stash, val, num, false);
+}
+
+static int32_t cache_u32_deq_batch(stash_t *stash, uint32_t val[], int32_t num)
+{
+	return cache_u32_get(stash, val, num, true);
+}
+
+static int32_t cache_u64_enq_multi(stash_t *stash, const uint64_t val[], int32_t num)
+{
+	return cache_u64_put(stash, val, num, false);
+}
+
+static int32_t cache_u64_enq_batch(stash_t *stash, const uint64_t val[], int32_t num)
+{
+	return cache_u64_put(stash, val, num, true);
+}
+
+static int32_t cache_u64_deq_multi(stash_t *stash, uint64_t val[], int32_t num)
+{
+	return cache_u64_get(stash, val, num, false);
+}
+
+static int32_t cache_u64_deq_batch(stash_t *stash, uint64_t val[], int32_t num)
+{
+	return cache_u64_get(stash, val, num, true);
+}
+
+static void cache_init(stash_t *stash, const char *name, uint32_t cache_size, int ring_u64)
+{
+	uint8_t *base;
+	uint32_t stride;
+	int idx;
+
+	idx = reserve_cache();
+
+	/* Cache size is a hint. When all cache blocks are in use, the stash works
+	 * without a cache. */
+	if (idx == CACHE_NONE) {
+		_ODP_DBG("No free stash cache, cache disabled (%s)\n", name ? name : "");
+		return;
+	}
+
+	stride = _ODP_ROUNDUP_CACHE_LINE(sizeof(stash_cache_t) + cache_size * sizeof(uint64_t));
+	base = stash_global->cache_data + idx * stash_global->cache_block_size;
+
+	for (int i = 0; i < odp_thread_count_max(); i++) {
+		stash_cache_t *cache = (stash_cache_t *)(uintptr_t)(base + i * stride);
+
+		odp_atomic_init_u32(&cache->cache_num, 0);
+	}
+
+	stash->cache_size   = cache_size;
+	stash->cache_burst  = cache_size > 1 ? cache_size / 2 : 1;
+	stash->cache_stride = stride;
+	stash->cache_base   = base;
+	stash->cache_idx    = idx;
+
+	stash->shared_fn = stash->ring_fn;
+
+	if (ring_u64) {
+		stash->ring_fn.u64.enq_multi = cache_u64_enq_multi;
+		stash->ring_fn.u64.enq_batch = cache_u64_enq_batch;
+		stash->ring_fn.u64.deq_multi = cache_u64_deq_multi;
+		stash->ring_fn.u64.deq_batch = cache_u64_deq_batch;
+	} else {
+		stash->ring_fn.u32.enq_multi = cache_u32_enq_multi;
+		stash->ring_fn.u32.enq_batch = cache_u32_enq_batch;
+		stash->ring_fn.u32.deq_multi = cache_u32_deq_multi;
+		stash->ring_fn.u32.deq_batch = cache_u32_deq_batch;
+	}
+}
+
 odp_stash_t odp_stash_create(const char *name, const odp_stash_param_t *param)
 {
 	stash_t *stash;
@@ -465,6 +866,11 @@ odp_stash_t odp_stash_create(const char *name, const odp_stash_param_t *param)
 		return ODP_STASH_INVALID;
 	}
 
+	if (param->cache_size > MAX_CACHE_SIZE) {
+		_ODP_ERR("Too large cache size.\n");
+		return ODP_STASH_INVALID;
+	}
+
 	index = reserve_index();
 
 	if (index < 0) {
@@ -530,6 +936,11 @@ odp_stash_t odp_stash_create(const char *name, const odp_stash_param_t *param)
 	stash->obj_size     = param->obj_size;
 	stash->ring_mask    = ring_size - 1;
 	stash->ring_size    = ring_size;
+	stash->cache_idx    = CACHE_NONE;
+
+	/* Caching would break FIFO order of the objects */
+	if (param->cache_size && param->type != ODP_STASH_TYPE_FIFO)
+		cache_init(stash, name, param->cache_size, ring_u64);
 
 	if (ring_u64)
 		stash->ring_fn.u64.init(stash);
@@ -546,10 +957,15 @@ odp_stash_t odp_stash_create(const char *name, const odp_stash_param_t *param)
 
 int odp_stash_destroy(odp_stash_t st)
 {
+	stash_t *stash = stash_entry(st);
+
 	if (st == ODP_STASH_INVALID)
 		return -1;
 
-	free_index(stash_entry(st)->index);
+	if (stash->cache_idx != CACHE_NONE)
+		free_cache(stash->cache_idx);
+
+	free_index(stash->index);
 
 	return 0;
 }
@@ -879,9 +1295,48 @@ int32_t odp_stash_get_ptr_batch(odp_stash_t st, uintptr_t ptr[], int32_t num)
 
 int odp_stash_flush_cache(odp_stash_t st)
 {
+	stash_t *stash = stash_entry(st);
+	stash_cache_t *cache;
+	uint32_t cache_num, num_left;
+	int32_t num_enq;
+
 	if (odp_unlikely(st == ODP_STASH_INVALID))
 		return -1;
 
+	if (stash->cache_size == 0)
+		return 0;
+
+	cache = stash_cache(stash);
+	cache_num = odp_atomic_load_u32(&cache->cache_num);
+
+	if (cache_num == 0)
+		return 0;
+
+	if (stash->obj_size == sizeof(uint64_t)) {
+		uint64_t *data = cache->data;
+
+		num_enq = stash->shared_fn.u64.enq_multi(stash, data, cache_num);
+		num_left = cache_num - num_enq;
+
+		if (odp_unlikely(num_left))
+			memmove(data, &data[num_enq], num_left * sizeof(uint64_t));
+	} else {
+		uint32_t *data = (uint32_t *)(uintptr_t)cache->data;
+
+		num_enq = stash->shared_fn.u32.enq_multi(stash, data, cache_num);
+		num_left = cache_num - num_enq;
+
+		if (odp_unlikely(num_left))
+			memmove(data, &data[num_enq], num_left * sizeof(uint32_t));
+	}
+
+	odp_atomic_store_u32(&cache->cache_num, num_left);
+
+	if (odp_unlikely(num_left)) {
+		_ODP_DBG("Stash full, %u objects left in cache\n", num_left);
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -895,6 +1350,23 @@ static uint32_t stash_obj_count(stash_t *stash)
 	return stash->ring_fn.u32.len(stash);
 }
 
+static uint32_t stash_cache_count(stash_t *stash)
+{
+	uint32_t num = 0;
+
+	if (stash->cache_size == 0)
+		return 0;
+
+	for (int i = 0; i < odp_thread_count_max(); i++) {
+		stash_cache_t *cache = (stash_cache_t *)(uintptr_t)(stash->cache_base +
+								    i * stash->cache_stride);
+
+		num += odp_atomic_load_u32(&cache->cache_num);
+	}
+
+	return num;
+}
+
 void odp_stash_print(odp_stash_t st)
 {
 	stash_t *stash = stash_entry(st);
@@ -913,6 +1385,8 @@ void odp_stash_print(odp_stash_t st)
 	_ODP_PRINT("  obj count       %u\n", stash_obj_count(stash));
 	_ODP_PRINT("  ring size       %u\n", stash->ring_size);
 	_ODP_PRINT("  strict size     %u\n", stash->strict_size);
+	_ODP_PRINT("  cache size      %u\n", stash->cache_size);
+	_ODP_PRINT("  cache count     %u\n", stash_cache_count(stash));
 	_ODP_PRINT("\n");
 }
 
@@ -926,7 +1400,7 @@ int odp_stash_stats(odp_stash_t st, odp_stash_stats_t *stats)
 	}
 
 	stats->count       = stash_obj_count(stash);
-	stats->cache_count = 0;
+	stats->cache_count = stash_cache_count(stash);
 
 	return 0;
 }
@@ -314,6 +314,11 @@ static int system_hp(hugepage_info_t *hugeinfo)
 	/* default_huge_page_dir may be NULL if no huge page support */
 	hugeinfo->default_huge_page_dir = get_hugepage_dir(0);
 
+	/* 1 GB pages are used through a separate hugetlbfs mount point */
+	hugeinfo->huge_page_1g_dir = NULL;
+	if (hugeinfo->default_huge_page_size != HUGE_PAGE_SIZE_1G)
+		hugeinfo->huge_page_1g_dir = get_hugepage_dir(HUGE_PAGE_SIZE_1G);
+
 	return 0;
 }
 
@@ -423,6 +428,7 @@ int _odp_system_info_init(void)
 int _odp_system_info_term(void)
 {
 	free(odp_global_ro.hugepage_info.default_huge_page_dir);
+	free(odp_global_ro.hugepage_info.huge_page_1g_dir);
 
 	return 0;
 }
@@ -108,6 +108,32 @@
 
 #define ACC_SIZE (1ull << 32)
 
+/* Maximum number of POSIX timer threads per timer pool */
+#define MAX_POSIX_THREADS 32
+
+/* Maximum number of expired timeout events collected before delivery */
+#define EXPIRE_BURST 32
+
+/* Timing wheel has WHEEL_LEVELS levels of WHEEL_SLOTS slots. A slot on level N
+ * covers WHEEL_SLOTS^N wheel ticks. One wheel tick is one scan period. */
+#define WHEEL_SLOT_BITS  6
+#define WHEEL_SLOTS      (1 << WHEEL_SLOT_BITS)
+#define WHEEL_SLOT_MASK  (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS     6
+#define WHEEL_NUM_SLOTS  (WHEEL_LEVELS * WHEEL_SLOTS)
+
+/* Timers further away are filed into the last slot and re-filed when reached */
+#define WHEEL_MAX_DELTA  (1ull << (WHEEL_LEVELS * WHEEL_SLOT_BITS))
+
+/* Timer is not in any wheel slot */
+#define WHEEL_NONE       ((uint32_t)0xffffffff)
+
+/* Timer has been removed from a slot by the scanner and is being processed */
+#define WHEEL_PENDING    ((uint32_t)0xfffffffe)
+
+/* Number of locks that serialize wheel operations on a timer */
+#define WHEEL_NUM_LOCKS  1024
+
 #include <odp/visibility_begin.h>
 
 /* Fill in timeout header field offsets for inline functions */
@@ -167,11 +193,80 @@ typedef struct {
 
 } _odp_timer_t;
 
+typedef struct ODP_ALIGNED_CACHE {
+	odp_spinlock_t lock;
+
+	/* First timer in the slot, or WHEEL_NONE */
+	uint32_t head;
+
+} wheel_slot_t;
+
+typedef struct {
+	/* Wheel tick when the slot, where the timer is filed, is processed */
+	uint64_t tick;
+
+	/* Slot list links */
+	uint32_t next;
+	uint32_t prev;
+
+	/* Slot index, WHEEL_NONE or WHEEL_PENDING */
+	odp_atomic_u32_t slot;
+
+} wheel_node_t;
+
+typedef struct {
+	/* Next wheel tick to be processed. Slots of earlier ticks have been processed already. */
+	odp_atomic_u64_t next_tick;
+
+	/* Bit per non-empty slot on each level */
+	uint64_t bitmap[WHEEL_LEVELS];
+
+	/* Serializes wheel scans */
+	odp_spinlock_t scan_lock;
+
+	/* Wheel linkage of each timer */
+	wheel_node_t *node;
+
+	/* Serialize wheel operations per timer. Lock order: timer lock, slot lock. */
+	_odp_atomic_flag_t locks[WHEEL_NUM_LOCKS];
+
+	wheel_slot_t slot[WHEEL_NUM_SLOTS];
+
+} timer_wheel_t;
+
+/* Expired timeout events waiting for delivery to destination queues */
+typedef struct {
+	struct timer_pool_s *tp;
+	uint32_t num;
+	odp_queue_t queue[EXPIRE_BURST];
+	odp_event_t event[EXPIRE_BURST];
+	uint64_t exp_tck[EXPIRE_BURST];
+
+	/* Lateness statistics of the scan */
+	uint32_t num_expired;
+	uint32_t expire_hist[ODP_TIMER_POOL_STATS_HIST_BINS];
+	uint32_t enq_hist[ODP_TIMER_POOL_STATS_HIST_BINS];
+
+} expire_burst_t;
+
+/* POSIX timer thread of a timer pool */
+typedef struct {
+	struct timer_pool_s *tp;
+	timer_t timerid;
+	pthread_t thr_pthread; /* pthread_t of timer thread */
+	pid_t thr_pid; /* gettid() for timer thread */
+	odp_atomic_u32_t thr_ready; /* thread ready from warm up */
+	int cpu; /* CPU the thread is pinned to, or -1 */
+	uint32_t shard; /* Index of timer index range processed by the thread */
+
+} posix_thread_t;
+
 typedef struct timer_pool_s {
 	/* Put frequently accessed fields in the first cache line */
 	uint64_t nsec_per_scan;
 	odp_time_t start_time;
 	odp_atomic_u64_t cur_tick;/* Current tick value */
+	odp_atomic_u64_t next_deadline;/* Earliest expiration of active timers (inline timer) */
 	uint64_t min_rel_tck;
 	uint64_t max_rel_tck;
 	tick_buf_t *tick_buf; /* Expiration tick and timeout buffer */
@@ -183,17 +278,23 @@ typedef struct timer_pool_s {
 	uint32_t tp_idx;/* Index into timer_pool array */
 	odp_timer_pool_param_t param;
 	char name[ODP_TIMER_POOL_NAME_LEN];
-	timer_t timerid;
 	int notify_overrun;
 	int owner;
-	pthread_t thr_pthread; /* pthread_t of timer thread */
-	pid_t thr_pid; /* gettid() for timer thread */
+	odp_atomic_u64_t overruns; /* Number of missed scan ticks */
+	struct {
+		odp_atomic_u64_t num_expired;
+		odp_atomic_u64_t expire_lateness[ODP_TIMER_POOL_STATS_HIST_BINS];
+		odp_atomic_u64_t enq_lateness[ODP_TIMER_POOL_STATS_HIST_BINS];
+	} stats;
 	int thr_warm_up; /* number of warm up rounds */
-	odp_atomic_u32_t thr_ready; /* thread ready from warm up */
-	int thr_exit; /* request to exit for timer thread */
+	int thr_exit; /* request to exit for timer threads */
+	uint32_t num_thr; /* number of POSIX timer threads */
+	posix_thread_t thr[MAX_POSIX_THREADS];
 	double base_freq;
 	uint64_t max_multiplier;
 	uint8_t periodic;
+	/* Timing wheel, or NULL when all timers are scanned */
+	timer_wheel_t *wheel;
 #if !USE_128BIT_ATOMICS
 	/* Multiple locks per cache line! */
 	_odp_atomic_flag_t locks[NUM_LOCKS] ODP_ALIGNED_CACHE;
@@ -216,6 +317,10 @@ typedef struct timer_global_t {
 	uint64_t highest_res_hz;
 	uint64_t max_base_hz;
 	uint64_t poll_interval_nsec;
+	uint32_t wheel_min_timers;
+	int posix_threads;
+	int num_posix_cpus;
+	int posix_cpu[MAX_POSIX_THREADS];
 	int num_timer_pools;
 	uint8_t timer_pool_used[MAX_TIMER_POOLS];
 	odp_time_t destroy_time[MAX_TIMER_POOLS];
@@ -331,18 +436,24 @@ static void block_sigalarm(void)
 
 static void posix_timer_stop(timer_pool_t *tp)
 {
+	uint32_t i;
 	int ret;
 
 	/* Stop POSIX timer signals */
-	if (timer_delete(tp->timerid) != 0)
-		_ODP_ABORT("timer_delete() returned error: %s\n", strerror(errno));
+	for (i = 0; i < tp->num_thr; i++) {
+		if (timer_delete(tp->thr[i].timerid) != 0)
+			_ODP_ABORT("timer_delete() returned error: %s\n", strerror(errno));
+	}
 
-	/* Stop the thread */
+	/* Stop the threads */
 	_ODP_DBG("stop\n");
 	tp->thr_exit = 1;
-	ret = pthread_join(tp->thr_pthread, NULL);
-	if (ret != 0)
-		_ODP_ABORT("Unable to join thread, err %d\n", ret);
+
+	for (i = 0; i < tp->num_thr; i++) {
+		ret = pthread_join(tp->thr[i].thr_pthread, NULL);
+		if (ret != 0)
+			_ODP_ABORT("Unable to join thread, err %d\n", ret);
+	}
 }
 
 static void odp_timer_pool_del(timer_pool_t *tp)
@@ -428,6 +539,147 @@ static inline odp_timer_t timer_alloc(timer_pool_t *tp, odp_queue_t queue, const
 	return hdl;
 }
 
+/******************************************************************************
+ * Timing wheel
+ *
+ * Active timers are filed into wheel slots by their expiration time. Each scan
+ * processes only those slots whose time has passed. Timers in higher level
+ * slots are re-filed into lower levels (cascaded) when their slot is reached.
+ *
+ * Timer cancel and restart to a later time do not touch the wheel. The timer is
+ * re-checked when its old slot is processed: inactive timers are dropped and
+ * timers with a later expiration time are re-filed.
+ *****************************************************************************/
+
+static inline void wheel_timer_lock(timer_wheel_t *wheel, uint32_t idx)
+{
+	_odp_atomic_flag_t *flag = &wheel->locks[idx % WHEEL_NUM_LOCKS];
+
+	while (_odp_atomic_flag_tas(flag))
+		while (_odp_atomic_flag_load(flag))
+			odp_cpu_pause();
+}
+
+static inline void wheel_timer_unlock(timer_wheel_t *wheel, uint32_t idx)
+{
+	_odp_atomic_flag_clear(&wheel->locks[idx % WHEEL_NUM_LOCKS]);
+}
+
+/* Remove timer from slot list. Slot lock must be held. */
+static inline void wheel_unlink(timer_wheel_t *wheel, uint32_t slot_idx, uint32_t level,
+				uint32_t idx)
+{
+	wheel_slot_t *slot = &wheel->slot[slot_idx];
+	wheel_node_t *node = &wheel->node[idx];
+
+	if (node->prev != WHEEL_NONE)
+		wheel->node[node->prev].next = node->next;
+	else
+		slot->head = node->next;
+
+	if (node->next != WHEEL_NONE)
+		wheel->node[node->next].prev = node->prev;
+
+	if (slot->head == WHEEL_NONE)
+		__atomic_fetch_and(&wheel->bitmap[level], ~(1ull << (slot_idx & WHEEL_SLOT_MASK)),
+				   __ATOMIC_RELAXED);
+
+	odp_atomic_store_u32(&node->slot, WHEEL_NONE);
+}
+
+/* File timer into the wheel slot of expiration wheel tick 'exp_wt'. Timer lock must be held
+ * and the timer must not be in any slot. */
+static void wheel_file(timer_wheel_t *wheel, uint32_t idx, uint64_t exp_wt)
+{
+	wheel_node_t *node = &wheel->node[idx];
+	wheel_slot_t *slot;
+	uint64_t next_tick, wt, delta, tick;
+	uint32_t level, shift, slot_idx;
+
+	while (1) {
+		next_tick = odp_atomic_load_acq_u64(&wheel->next_tick);
+		wt = exp_wt < next_tick ? next_tick : exp_wt;
+		delta = wt - next_tick;
+		level = 0;
+		shift = 0;
+		tick = wt;
+
+		if (delta >= WHEEL_SLOTS) {
+			if (odp_unlikely(delta >= WHEEL_MAX_DELTA)) {
+				delta = WHEEL_MAX_DELTA - 1;
+				wt = next_tick + delta;
+			}
+
+			level = (63 - __builtin_clzll(delta)) / WHEEL_SLOT_BITS;
+			shift = level * WHEEL_SLOT_BITS;
+			tick = wt & ~((1ull << shift) - 1);
+		}
+
+		slot_idx = level * WHEEL_SLOTS + ((wt >> shift) & WHEEL_SLOT_MASK);
+		slot = &wheel->slot[slot_idx];
+
+		odp_spinlock_lock(&slot->lock);
+
+		node->tick = tick;
+		node->prev = WHEEL_NONE;
+		node->next = slot->head;
+		if (slot->head != WHEEL_NONE)
+			wheel->node[slot->head].prev = idx;
+		slot->head = idx;
+		odp_atomic_store_u32(&node->slot, slot_idx);
+
+		__atomic_fetch_or(&wheel->bitmap[level], 1ull << (slot_idx & WHEEL_SLOT_MASK),
+				  __ATOMIC_RELAXED);
+
+		/* Pairs with the barrier in wheel scan between next tick update and bitmap read.
+		 * Either the scanner sees the bit, or this sees the new next tick value. */
+		odp_mb_full();
+
+		if (odp_likely(tick >= odp_atomic_load_u64(&wheel->next_tick))) {
+			odp_spinlock_unlock(&slot->lock);
+			return;
+		}
+
+		/* Scanner passed the slot meanwhile, retry with the new next tick */
+		wheel_unlink(wheel, slot_idx, level, idx);
+		odp_spinlock_unlock(&slot->lock);
+	}
+}
+
+/* Update wheel after timer expiration tick has been set */
+static void wheel_timer_reset(timer_pool_t *tp, uint32_t idx, uint64_t abs_tck)
+{
+	timer_wheel_t *wheel = tp->wheel;
+	wheel_node_t *node = &wheel->node[idx];
+	uint64_t exp_wt = abs_tck / tp->nsec_per_scan;
+	uint32_t slot_idx;
+
+	wheel_timer_lock(wheel, idx);
+
+	slot_idx = odp_atomic_load_u32(&node->slot);
+
+	if (slot_idx == WHEEL_NONE) {
+		wheel_file(wheel, idx, exp_wt);
+	} else if (slot_idx != WHEEL_PENDING && exp_wt < node->tick) {
+		/* Timer expires before its current slot is processed. Move it to an earlier slot,
+		 * unless scanner is processing it already. */
+		wheel_slot_t *slot = &wheel->slot[slot_idx];
+		int moved = 0;
+
+		odp_spinlock_lock(&slot->lock);
+		if (odp_atomic_load_u32(&node->slot) == slot_idx) {
+			wheel_unlink(wheel, slot_idx, slot_idx / WHEEL_SLOTS, idx);
+			moved = 1;
+		}
+		odp_spinlock_unlock(&slot->lock);
+
+		if (moved)
+			wheel_file(wheel, idx, exp_wt);
+	}
+
+	wheel_timer_unlock(wheel, idx);
+}
+
 static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 			timer_pool_t *tp)
 {
@@ -532,6 +784,16 @@ static bool timer_reset(uint32_t idx, uint64_t abs_tck, odp_event_t *tmo_event,
 		/* Return old timeout event */
 		*tmo_event = old_event;
 	}
+
+	if (tp->wheel && success)
+		wheel_timer_reset(tp, idx, abs_tck);
+
+	if (timer_global->use_inline_timers && success) {
+		/* Expiration tick update must be visible to a scan that resets the deadline */
+		odp_mb_full();
+		odp_atomic_min_u64(&tp->next_deadline, abs_tck);
+	}
+
 	return success;
 }
 
@@ -662,9 +924,132 @@ static odp_event_t timer_cancel(timer_pool_t *tp, uint32_t idx)
 	return old_event;
 }
 
-static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
+static inline uint64_t time_nsec(timer_pool_t *tp, odp_time_t now)
+{
+	odp_time_t start = tp->start_time;
+
+	return odp_time_diff_ns(now, start);
+}
+
+static inline uint64_t current_nsec(timer_pool_t *tp)
+{
+	odp_time_t now;
+
+	now = odp_time_global();
+
+	return time_nsec(tp, now);
+}
+
+/* Lateness histogram bin of a timeout */
+static inline uint32_t lateness_bin(uint64_t exp_tck, uint64_t nsec)
+{
+	uint32_t bin;
+
+	if (nsec <= exp_tck)
+		return 0;
+
+	bin = 64 - __builtin_clzll(nsec - exp_tck);
+
+	return bin < ODP_TIMER_POOL_STATS_HIST_BINS ? bin : ODP_TIMER_POOL_STATS_HIST_BINS - 1;
+}
+
+static inline void expire_enq(odp_queue_t queue, odp_event_t event[], int num)
+{
+	int ret, i;
+	int done = 0;
+
+	while (done < num) {
+		ret = odp_queue_enq_multi(queue, &event[done], num - done);
+
+		if (odp_unlikely(ret <= 0)) {
+			for (i = done; i < num; i++)
+				_odp_event_free(event[i]);
+
+			_ODP_ABORT("Failed to enqueue timeout events (%d)\n", ret);
+		}
+
+		done += ret;
+	}
+}
+
+/* Deliver collected timeout events with one enqueue per destination queue. Events to the same
+ * queue are delivered in the order they expired. */
+static void expire_burst_flush(expire_burst_t *burst)
+{
+	odp_event_t event[EXPIRE_BURST];
+	odp_queue_t queue;
+	uint64_t nsec;
+	uint32_t i, num_ev, num_left;
+	uint32_t num = burst->num;
+
+	if (num == 0)
+		return;
+
+	while (num) {
+		queue = burst->queue[0];
+		num_ev = 0;
+		num_left = 0;
+
+		for (i = 0; i < num; i++) {
+			if (burst->queue[i] == queue) {
+				event[num_ev++] = burst->event[i];
+			} else {
+				burst->queue[num_left] = burst->queue[i];
+				burst->event[num_left] = burst->event[i];
+				num_left++;
+			}
+		}
+
+		expire_enq(queue, event, num_ev);
+		num = num_left;
+	}
+
+	nsec = current_nsec(burst->tp);
+
+	for (i = 0; i < burst->num; i++)
+		burst->enq_hist[lateness_bin(burst->exp_tck[i], nsec)]++;
+
+	burst->num = 0;
+}
+
+static inline void expire_burst_init(expire_burst_t *burst, timer_pool_t *tp)
+{
+	burst->tp = tp;
+	burst->num = 0;
+	burst->num_expired = 0;
+	memset(burst->expire_hist, 0, sizeof(burst->expire_hist));
+	memset(burst->enq_hist, 0, sizeof(burst->enq_hist));
+}
+
+/* Deliver remaining timeout events and update timer pool statistics */
+static void expire_burst_finish(expire_burst_t *burst)
+{
+	timer_pool_t *tp = burst->tp;
+	uint32_t i;
+
+	expire_burst_flush(burst);
+
+	if (burst->num_expired == 0)
+		return;
+
+	odp_atomic_add_u64(&tp->stats.num_expired, burst->num_expired);
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++) {
+		if (burst->expire_hist[i])
+			odp_atomic_add_u64(&tp->stats.expire_lateness[i], burst->expire_hist[i]);
+
+		if (burst->enq_hist[i])
+			odp_atomic_add_u64(&tp->stats.enq_lateness[i], burst->enq_hist[i]);
+	}
+}
+
+/* Returns non-zero when the timer could not be checked due to a concurrent update. Timeout
+ * event of an expired timer is added into the burst, which is flushed when full. */
+static inline int timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick,
+			       expire_burst_t *burst)
 {
 	uint64_t exp_tck;
+	int busy = 0;
 	odp_queue_t queue = ODP_QUEUE_INVALID;
 	_odp_timer_t *tim = &tp->timers[idx];
 	tick_buf_t *tb = &tp->tick_buf[idx];
@@ -700,6 +1085,8 @@ static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
 						   &old.tb_u128, new.tb_u128);
 		if (succ)
 			tmo_event = old.tmo_event;
+		else
+			busy = 1;
 		/* Else CAS failed, something changed => skip timer
 		 * this tick, it will be checked again next tick */
 	}
@@ -707,7 +1094,7 @@ static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
 #else
 	/* Try to take a related lock */
 	if (_odp_atomic_flag_tas(IDX2LOCK(tp, idx)))
-		return;
+		return 1;
 
 	/* Proper check for timer expired */
 	exp_tck = tb->exp_tck.v;
@@ -743,23 +1130,152 @@ static inline void timer_expire(timer_pool_t *tp, uint32_t idx, uint64_t tick)
 		}
 		/* Else ignore events of other types */
 		/* Post the timeout to the destination queue */
-		int rc = odp_queue_enq(queue, tmo_event);
+		burst->queue[burst->num] = queue;
+		burst->event[burst->num] = tmo_event;
+		burst->exp_tck[burst->num] = exp_tck;
+		burst->num++;
+		burst->num_expired++;
+		burst->expire_hist[lateness_bin(exp_tck, tick)]++;
+
+		if (odp_unlikely(burst->num == EXPIRE_BURST))
+			expire_burst_flush(burst);
+	}
+
+	return busy;
+}
+
+/* Check a timer that was removed from a wheel slot: expire, re-file or drop it */
+static inline void wheel_timer_run(timer_pool_t *tp, uint32_t idx, uint64_t tick,
+				   expire_burst_t *burst)
+{
+	timer_wheel_t *wheel = tp->wheel;
+	wheel_node_t *node = &wheel->node[idx];
+	uint64_t exp_tck;
 
-		if (odp_unlikely(rc != 0)) {
-			_odp_event_free(tmo_event);
-			_ODP_ABORT("Failed to enqueue timeout event (%d)\n", rc);
+	wheel_timer_lock(wheel, idx);
+
+	exp_tck = odp_atomic_load_u64(&tp->tick_buf[idx].exp_tck);
+
+	if (exp_tck & TMO_INACTIVE) {
+		/* Cancelled, expired or freed timer */
+		odp_atomic_store_u32(&node->slot, WHEEL_NONE);
+		wheel_timer_unlock(wheel, idx);
+		return;
+	}
+
+	if (exp_tck > tick) {
+		wheel_file(wheel, idx, exp_tck / tp->nsec_per_scan);
+		wheel_timer_unlock(wheel, idx);
+		return;
+	}
+
+	odp_atomic_store_u32(&node->slot, WHEEL_NONE);
+	wheel_timer_unlock(wheel, idx);
+
+	/* A concurrent timer restart files the timer again. If the timer could not be checked,
+	 * retry on the next scan (unless it was filed meanwhile). */
+	if (odp_unlikely(timer_expire(tp, idx, tick, burst))) {
+		wheel_timer_lock(wheel, idx);
+		if (odp_atomic_load_u32(&node->slot) == WHEEL_NONE)
+			wheel_file(wheel, idx, 0);
+		wheel_timer_unlock(wheel, idx);
+	}
+}
+
+/* Process all timers of a wheel slot */
+static void wheel_slot_run(timer_pool_t *tp, uint32_t slot_idx, uint64_t tick,
+			   expire_burst_t *burst)
+{
+	timer_wheel_t *wheel = tp->wheel;
+	wheel_slot_t *slot = &wheel->slot[slot_idx];
+	uint32_t idx, first;
+
+	odp_spinlock_lock(&slot->lock);
+
+	first = slot->head;
+	slot->head = WHEEL_NONE;
+	__atomic_fetch_and(&wheel->bitmap[slot_idx / WHEEL_SLOTS],
+			   ~(1ull << (slot_idx & WHEEL_SLOT_MASK)), __ATOMIC_RELAXED);
+
+	/* Timer restart does not touch timers that are being processed */
+	for (idx = first; idx != WHEEL_NONE; idx = wheel->node[idx].next)
+		odp_atomic_store_u32(&wheel->node[idx].slot, WHEEL_PENDING);
+
+	odp_spinlock_unlock(&slot->lock);
+
+	idx = first;
+	while (idx != WHEEL_NONE) {
+		uint32_t next = wheel->node[idx].next;
+
+		wheel_timer_run(tp, idx, tick, burst);
+		idx = next;
+	}
+}
+
+static void timer_wheel_scan(timer_pool_t *tp, uint64_t tick, expire_burst_t *burst)
+{
+	timer_wheel_t *wheel = tp->wheel;
+	uint64_t now_wt = tick / tp->nsec_per_scan;
+	uint64_t t, end, bits, mask;
+	uint32_t level, shift, lo, hi;
+
+	/* Another thread is scanning. Remaining slots are processed on the next scan. */
+	if (!odp_spinlock_trylock(&wheel->scan_lock))
+		return;
+
+	t = odp_atomic_load_u64(&wheel->next_tick);
+
+	while (t <= now_wt) {
+		/* Process at most until the end of current level 0 round */
+		end = (t | WHEEL_SLOT_MASK) + 1;
+		if (end > now_wt + 1)
+			end = now_wt + 1;
+
+		/* After this, timers are filed only into slots of 'end' or later */
+		odp_atomic_store_rel_u64(&wheel->next_tick, end);
+		odp_mb_full();
+
+		/* Cascade higher level slots that start at tick t */
+		for (level = 1; level < WHEEL_LEVELS; level++) {
+			shift = level * WHEEL_SLOT_BITS;
+
+			if (t & ((1ull << shift) - 1))
+				break;
+
+			lo = (t >> shift) & WHEEL_SLOT_MASK;
+			bits = __atomic_load_n(&wheel->bitmap[level], __ATOMIC_RELAXED);
+
+			if (bits & (1ull << lo))
+				wheel_slot_run(tp, level * WHEEL_SLOTS + lo, tick, burst);
+		}
+
+		lo = t & WHEEL_SLOT_MASK;
+		hi = (end - 1) & WHEEL_SLOT_MASK;
+		mask = (UINT64_MAX << lo) & (UINT64_MAX >> (WHEEL_SLOT_MASK - hi));
+		bits = __atomic_load_n(&wheel->bitmap[0], __ATOMIC_RELAXED) & mask;
+
+		while (bits) {
+			uint32_t i = __builtin_ctzll(bits);
+
+			bits &= bits - 1;
+			wheel_slot_run(tp, i, tick, burst);
 		}
+
+		t = end;
 	}
+
+	odp_spinlock_unlock(&wheel->scan_lock);
 }
 
-static inline void timer_pool_scan(timer_pool_t *tp, uint64_t tick)
+/* Returns the earliest expiration tick of timers that did not expire */
+static inline uint64_t timer_pool_scan_range(timer_pool_t *tp, uint64_t tick, uint32_t first,
+					     uint32_t last, expire_burst_t *burst)
 {
 	tick_buf_t *array = &tp->tick_buf[0];
-	uint32_t high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+	uint64_t next = UINT64_MAX;
 	uint32_t i;
 
-	_ODP_ASSERT(high_wm <= tp->param.num_timers);
-	for (i = 0; i < high_wm; i++) {
+	for (i = first; i < last; i++) {
 		/* As a rare occurrence, we can outsmart the HW prefetcher
 		 * and the compiler (GCC -fprefetch-loop-arrays) with some
 		 * tuned manual prefetching (32x16=512B ahead), seems to
@@ -769,36 +1285,69 @@ static inline void timer_pool_scan(timer_pool_t *tp, uint64_t tick)
 		uint64_t exp_tck = array[i].exp_tck.v;
 
 		if (odp_unlikely(exp_tck <= tick)) {
-			/* Attempt to expire timer */
-			timer_expire(tp, i, tick);
+			/* Attempt to expire timer. Retry a busy timer on the next scan. */
+			if (odp_unlikely(timer_expire(tp, i, tick, burst)))
+				next = tick;
+		} else if (exp_tck < next) {
+			/* Inactive and unused timers have larger values than any real tick */
+			next = exp_tck;
 		}
 	}
-}
 
-/******************************************************************************
- * Inline timer processing
- *****************************************************************************/
+	return next;
+}
 
-static inline uint64_t time_nsec(timer_pool_t *tp, odp_time_t now)
+static inline int timer_wheel_empty(timer_wheel_t *wheel)
 {
-	odp_time_t start = tp->start_time;
+	uint32_t level;
 
-	return odp_time_diff_ns(now, start);
+	for (level = 0; level < WHEEL_LEVELS; level++) {
+		if (__atomic_load_n(&wheel->bitmap[level], __ATOMIC_RELAXED))
+			return 0;
+	}
+
+	return 1;
 }
 
-static inline uint64_t current_nsec(timer_pool_t *tp)
+/* Scan a timer pool and update its next deadline (inline timer) */
+static inline void timer_pool_scan(timer_pool_t *tp, uint64_t tick)
 {
-	odp_time_t now;
+	expire_burst_t burst;
+	uint64_t next;
+	uint32_t high_wm;
 
-	now = odp_time_global();
+	expire_burst_init(&burst, tp);
 
-	return time_nsec(tp, now);
+	/* Timers started from now on lower the deadline themselves */
+	odp_atomic_store_u64(&tp->next_deadline, UINT64_MAX);
+	odp_mb_full();
+
+	if (tp->wheel) {
+		timer_wheel_scan(tp, tick, &burst);
+
+		/* Non-empty wheel is checked on every scan tick */
+		next = UINT64_MAX;
+		if (!timer_wheel_empty(tp->wheel))
+			next = (tick / tp->nsec_per_scan + 1) * tp->nsec_per_scan;
+	} else {
+		high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+
+		_ODP_ASSERT(high_wm <= tp->param.num_timers);
+		next = timer_pool_scan_range(tp, tick, 0, high_wm, &burst);
+	}
+
+	expire_burst_finish(&burst);
+	odp_atomic_min_u64(&tp->next_deadline, next);
 }
 
+/******************************************************************************
+ * Inline timer processing
+ *****************************************************************************/
+
 static inline void timer_pool_scan_inline(int num, odp_time_t now)
 {
 	timer_pool_t *tp;
-	uint64_t new_tick, old_tick, nsec;
+	uint64_t new_tick, old_tick, nsec, deadline, due_tick;
 	int64_t diff;
 	int i;
 
@@ -820,6 +1369,12 @@ static inline void timer_pool_scan_inline(int num, odp_time_t now)
 		}
 
 		nsec     = time_nsec(tp, now);
+		deadline = odp_atomic_load_u64(&tp->next_deadline);
+
+		/* Skip pools that have no timers to expire yet */
+		if (nsec < deadline)
+			continue;
+
 		new_tick = nsec / tp->nsec_per_scan;
 		old_tick = odp_atomic_load_u64(&tp->cur_tick);
 		diff = new_tick - old_tick;
@@ -828,15 +1383,22 @@ static inline void timer_pool_scan_inline(int num, odp_time_t now)
 			continue;
 
 		if (odp_atomic_cas_u64(&tp->cur_tick, &old_tick, new_tick)) {
-			if (tp->notify_overrun && diff > 1) {
-				if (old_tick == 0) {
-					_ODP_DBG("Timer pool (%s) missed %" PRIi64 " scans in start up\n",
-						 tp->name, diff - 1);
-				} else {
+			/* Scans before the deadline tick were skipped on purpose */
+			due_tick = deadline / tp->nsec_per_scan;
+			if (due_tick > old_tick)
+				diff = new_tick - due_tick;
+
+			if (odp_unlikely(diff > 1 && old_tick)) {
+				odp_atomic_add_u64(&tp->overruns, diff - 1);
+
+				if (tp->notify_overrun) {
 					_ODP_DBG("Timer pool (%s) resolution too high: %" PRIi64 " scans missed\n",
 						 tp->name, diff - 1);
 					tp->notify_overrun = 0;
 				}
+			} else if (tp->notify_overrun && diff > 1) {
+				_ODP_DBG("Timer pool (%s) missed %" PRIi64 " scans in start up\n",
+					 tp->name, diff - 1);
 			}
 			timer_pool_scan(tp, nsec);
 		}
@@ -891,33 +1453,54 @@ void _odp_timer_run_inline(int dec)
  * Functions that use Linux/POSIX per-process timers and related facilities
  *****************************************************************************/
 
-static inline void timer_run_posix(timer_pool_t *tp)
+static inline void timer_run_posix(posix_thread_t *thr)
 {
+	timer_pool_t *tp = thr->tp;
+	expire_burst_t burst;
 	uint64_t nsec;
+	uint32_t high_wm, first, last;
 	int overrun;
 
-	if (tp->notify_overrun) {
-		overrun = timer_getoverrun(tp->timerid);
-		if (overrun) {
+	/* All shards run on the same period, count overruns from the first one only */
+	overrun = thr->shard == 0 ? timer_getoverrun(thr->timerid) : 0;
+	if (odp_unlikely(overrun > 0)) {
+		odp_atomic_add_u64(&tp->overruns, overrun);
+
+		if (tp->notify_overrun) {
 			_ODP_DBG("\n\t%d ticks overrun on timer pool \"%s\", timer resolution too high\n",
 				 overrun, tp->name);
 			tp->notify_overrun = 0;
 		}
 	}
 
-	_odp_timer_t *array = &tp->timers[0];
+	nsec = current_nsec(tp);
+	expire_burst_init(&burst, tp);
+
+	if (tp->wheel) {
+		timer_wheel_scan(tp, nsec, &burst);
+		expire_burst_finish(&burst);
+		return;
+	}
+
+	/* Each thread scans its own share of the allocated timer index range */
+	high_wm = odp_atomic_load_acq_u32(&tp->high_wm);
+	first = ((uint64_t)high_wm * thr->shard) / tp->num_thr;
+	last  = ((uint64_t)high_wm * (thr->shard + 1)) / tp->num_thr;
+
+	_odp_timer_t *array = &tp->timers[first];
 	uint32_t i;
 	/* Prefetch initial cache lines (match 32 above) */
 	for (i = 0; i < 32; i += ODP_CACHE_LINE_SIZE / sizeof(array[0]))
 		__builtin_prefetch(&array[i], 0, 0);
 
-	nsec = current_nsec(tp);
-	timer_pool_scan(tp, nsec);
+	timer_pool_scan_range(tp, nsec, first, last, &burst);
+	expire_burst_finish(&burst);
 }
 
 static void *timer_thread(void *arg)
 {
-	timer_pool_t *tp = (timer_pool_t *)arg;
+	posix_thread_t *thr = (posix_thread_t *)arg;
+	timer_pool_t *tp = thr->tp;
 	sigset_t sigset;
 	int ret;
 	struct timespec tmo;
@@ -935,27 +1518,27 @@ static void *timer_thread(void *arg)
 
 	/* Signal that this thread has started */
 	odp_mb_full();
-	tp->thr_pid = (pid_t)syscall(SYS_gettid);
+	thr->thr_pid = (pid_t)syscall(SYS_gettid);
 	odp_mb_full();
 
 	while (1) {
 		ret = sigtimedwait(&sigset, &si, &tmo);
 
 		if (tp->thr_exit) {
-			tp->thr_pid = 0;
+			thr->thr_pid = 0;
 			return NULL;
 		}
 
 		if (ret <= 0)
 			continue;
 
-		timer_run_posix(tp);
+		timer_run_posix(thr);
 
 		if (num < warm_up) {
 			num++;
 
 			if (num == warm_up)
-				odp_atomic_store_rel_u32(&tp->thr_ready, 1);
+				odp_atomic_store_rel_u32(&thr->thr_ready, 1);
 		}
 	}
 
@@ -1037,43 +1620,52 @@ timer_res_init_done:
 	return 0;
 }
 
-static void posix_timer_start(timer_pool_t *tp)
+static void posix_thread_start(timer_pool_t *tp, posix_thread_t *thr)
 {
 	struct sigevent   sigev;
 	struct itimerspec ispec;
+	pthread_attr_t attr;
 	uint64_t res, sec, nsec;
 	int ret;
 
-	_ODP_DBG("Creating POSIX timer for timer pool %s, period %" PRIu64 " ns\n",
-		 tp->name, tp->param.res_ns);
-
 	res  = tp->param.res_ns;
 	sec  = res / ODP_TIME_SEC_IN_NS;
 	nsec = res - sec * ODP_TIME_SEC_IN_NS;
 
-	tp->thr_pid = 0;
-	tp->thr_warm_up = 1;
+	thr->tp = tp;
+	thr->thr_pid = 0;
+	odp_atomic_init_u32(&thr->thr_ready, 0);
 
-	/* 20ms warm up */
-	if (res < (20 * ODP_TIME_MSEC_IN_NS))
-		tp->thr_warm_up = (20 * ODP_TIME_MSEC_IN_NS) / res;
+	pthread_attr_init(&attr);
 
-	odp_atomic_init_u32(&tp->thr_ready, 0);
-	ret = pthread_create(&tp->thr_pthread, NULL, timer_thread, tp);
+	if (thr->cpu >= 0) {
+		cpu_set_t cpu_set;
+
+		CPU_ZERO(&cpu_set);
+		CPU_SET(thr->cpu, &cpu_set);
+		ret = pthread_attr_setaffinity_np(&attr, sizeof(cpu_set_t), &cpu_set);
+		if (ret)
+			_ODP_ABORT("Unable to set timer thread affinity to CPU %i: %d\n",
+				   thr->cpu, ret);
+	}
+
+	ret = pthread_create(&thr->thr_pthread, &attr, timer_thread, thr);
 	if (ret)
 		_ODP_ABORT("Unable to create timer thread: %d\n", ret);
 
-	/* wait thread set tp->thr_pid */
-	while (tp->thr_pid == 0)
+	pthread_attr_destroy(&attr);
+
+	/* wait thread set thr->thr_pid */
+	while (thr->thr_pid == 0)
 		sched_yield();
 
 	memset(&sigev, 0, sizeof(sigev));
 	sigev.sigev_notify          = SIGEV_THREAD_ID;
 	sigev.sigev_value.sival_ptr = tp;
-	sigev._sigev_un._tid = tp->thr_pid;
+	sigev._sigev_un._tid = thr->thr_pid;
 	sigev.sigev_signo = SIGALRM;
 
-	if (timer_create(CLOCK_MONOTONIC, &sigev, &tp->timerid))
+	if (timer_create(CLOCK_MONOTONIC, &sigev, &thr->timerid))
 		_ODP_ABORT("timer_create() returned error %s\n", strerror(errno));
 
 	memset(&ispec, 0, sizeof(ispec));
@@ -1082,20 +1674,69 @@ static void posix_timer_start(timer_pool_t *tp)
 	ispec.it_value.tv_sec     = (time_t)sec;
 	ispec.it_value.tv_nsec    = (long)nsec;
 
-	if (timer_settime(tp->timerid, 0, &ispec, NULL))
+	if (timer_settime(thr->timerid, 0, &ispec, NULL))
 		_ODP_ABORT("timer_settime() returned error %s\n", strerror(errno));
+}
+
+static void posix_timer_start(timer_pool_t *tp)
+{
+	uint64_t res;
+	uint32_t i, num_thr;
+	int num_cpu = timer_global->num_posix_cpus;
+
+	/* Timing wheel is scanned by one thread at a time */
+	num_thr = tp->wheel ? 1 : timer_global->posix_threads;
+
+	/* Each thread needs some timers to process */
+	if (num_thr > tp->param.num_timers)
+		num_thr = tp->param.num_timers;
 
-	/* Wait response from timer thread that warm up signals have been
+	_ODP_DBG("Creating %u POSIX timer(s) for timer pool %s, period %" PRIu64 " ns\n",
+		 num_thr, tp->name, tp->param.res_ns);
+
+	res = tp->param.res_ns;
+	tp->thr_warm_up = 1;
+
+	/* 20ms warm up */
+	if (res < (20 * ODP_TIME_MSEC_IN_NS))
+		tp->thr_warm_up = (20 * ODP_TIME_MSEC_IN_NS) / res;
+
+	tp->num_thr = num_thr;
+
+	for (i = 0; i < num_thr; i++) {
+		tp->thr[i].shard = i;
+		tp->thr[i].cpu = num_cpu ? timer_global->posix_cpu[i % num_cpu] : -1;
+		posix_thread_start(tp, &tp->thr[i]);
+	}
+
+	/* Wait response from timer threads that warm up signals have been
 	 * processed. Warm up helps avoiding overrun on the first timeout. */
-	while (odp_atomic_load_acq_u32(&tp->thr_ready) == 0)
-		sched_yield();
+	for (i = 0; i < num_thr; i++) {
+		while (odp_atomic_load_acq_u32(&tp->thr[i].thr_ready) == 0)
+			sched_yield();
+	}
+
+	/* Overruns during start up are not counted */
+	odp_atomic_store_u64(&tp->overruns, 0);
+}
+
+static void timer_pool_stats_init(timer_pool_t *tp)
+{
+	uint32_t i;
+
+	odp_atomic_init_u64(&tp->stats.num_expired, 0);
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++) {
+		odp_atomic_init_u64(&tp->stats.expire_lateness[i], 0);
+		odp_atomic_init_u64(&tp->stats.enq_lateness[i], 0);
+	}
 }
 
 static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_param_t *param)
 {
 	uint32_t i;
 	int tp_idx;
-	size_t sz0, sz1, sz2;
+	size_t sz0, sz1, sz2, sz3, sz4;
 	uint64_t tp_size;
 	uint64_t res_ns, nsec_per_scan;
 	odp_shm_t shm;
@@ -1106,6 +1747,8 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 	uint64_t max_multiplier = 0;
 	uint32_t flags = 0;
 	int periodic = (param->timer_type == ODP_TIMER_TYPE_PERIODIC) ? 1 : 0;
+	int use_wheel = timer_global->wheel_min_timers &&
+			param->num_timers >= timer_global->wheel_min_timers;
 
 	if (param->res_ns)
 		res_ns = param->res_ns;
@@ -1192,7 +1835,15 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 	sz0 = _ODP_ROUNDUP_CACHE_LINE(sizeof(timer_pool_t));
 	sz1 = _ODP_ROUNDUP_CACHE_LINE(sizeof(tick_buf_t) * param->num_timers);
 	sz2 = _ODP_ROUNDUP_CACHE_LINE(sizeof(_odp_timer_t) * param->num_timers);
-	tp_size = sz0 + sz1 + sz2;
+	sz3 = 0;
+	sz4 = 0;
+
+	if (use_wheel) {
+		sz3 = _ODP_ROUNDUP_CACHE_LINE(sizeof(timer_wheel_t));
+		sz4 = _ODP_ROUNDUP_CACHE_LINE(sizeof(wheel_node_t) * param->num_timers);
+	}
+
+	tp_size = sz0 + sz1 + sz2 + sz3 + sz4;
 
 	shm = odp_shm_reserve(name, tp_size, ODP_CACHE_LINE_SIZE, flags);
 
@@ -1215,6 +1866,9 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 	tp->nsec_per_scan = nsec_per_scan;
 
 	odp_atomic_init_u64(&tp->cur_tick, 0);
+	odp_atomic_init_u64(&tp->next_deadline, UINT64_MAX);
+	odp_atomic_init_u64(&tp->overruns, 0);
+	timer_pool_stats_init(tp);
 
 	if (name == NULL) {
 		tp->name[0] = 0;
@@ -1243,6 +1897,34 @@ static odp_timer_pool_t timer_pool_new(const char *name, const odp_timer_pool_pa
 
 	tp->tick_buf = (void *)((char *)odp_shm_addr(shm) + sz0);
 	tp->timers = (void *)((char *)odp_shm_addr(shm) + sz0 + sz1);
+	tp->wheel = NULL;
+
+	if (use_wheel) {
+		timer_wheel_t *wheel = (void *)((char *)odp_shm_addr(shm) + sz0 + sz1 + sz2);
+
+		wheel->node = (void *)((char *)odp_shm_addr(shm) + sz0 + sz1 + sz2 + sz3);
+		odp_atomic_init_u64(&wheel->next_tick, 0);
+		odp_spinlock_init(&wheel->scan_lock);
+
+		for (i = 0; i < WHEEL_LEVELS; i++)
+			wheel->bitmap[i] = 0;
+
+		for (i = 0; i < WHEEL_NUM_LOCKS; i++)
+			_odp_atomic_flag_clear(&wheel->locks[i]);
+
+		for (i = 0; i < WHEEL_NUM_SLOTS; i++) {
+			odp_spinlock_init(&wheel->slot[i].lock);
+			wheel->slot[i].head = WHEEL_NONE;
+		}
+
+		for (i = 0; i < param->num_timers; i++) {
+			wheel->node[i].next = WHEEL_NONE;
+			wheel->node[i].prev = WHEEL_NONE;
+			odp_atomic_init_u32(&wheel->node[i].slot, WHEEL_NONE);
+		}
+
+		tp->wheel = wheel;
+	}
 
 #if !USE_128BIT_ATOMICS
 	for (i = 0; i < NUM_LOCKS; i++)
@@ -1513,6 +2195,7 @@ int odp_timer_pool_info(odp_timer_pool_t tpid, odp_timer_pool_info_t *tp_info)
 	tp_info->cur_timers = tp->num_alloc;
 	tp_info->hwm_timers = odp_atomic_load_u32(&tp->high_wm);
 	tp_info->name = tp->name;
+	tp_info->overruns = odp_atomic_load_u64(&tp->overruns);
 
 	/* One API timer tick is one nsec. Leave source clock information to zero
 	 * as there is no direct link between a source clock signal and a timer tick. */
@@ -1522,6 +2205,40 @@ int odp_timer_pool_info(odp_timer_pool_t tpid, odp_timer_pool_info_t *tp_info)
 	return 0;
 }
 
+int odp_timer_pool_stats(odp_timer_pool_t tpid, odp_timer_pool_stats_t *stats)
+{
+	timer_pool_t *tp;
+	uint32_t i;
+
+	if (odp_unlikely(tpid == ODP_TIMER_POOL_INVALID)) {
+		_ODP_ERR("Invalid timer pool.\n");
+		return -1;
+	}
+
+	tp = timer_pool_from_hdl(tpid);
+
+	stats->num_expired = odp_atomic_load_u64(&tp->stats.num_expired);
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++) {
+		stats->expire_lateness[i] = odp_atomic_load_u64(&tp->stats.expire_lateness[i]);
+		stats->enq_lateness[i] = odp_atomic_load_u64(&tp->stats.enq_lateness[i]);
+	}
+
+	return 0;
+}
+
+int odp_timer_pool_stats_reset(odp_timer_pool_t tpid)
+{
+	if (odp_unlikely(tpid == ODP_TIMER_POOL_INVALID)) {
+		_ODP_ERR("Invalid timer pool.\n");
+		return -1;
+	}
+
+	timer_pool_stats_init(timer_pool_from_hdl(tpid));
+
+	return 0;
+}
+
 uint64_t odp_timer_pool_to_u64(odp_timer_pool_t tpid)
 {
 	return _odp_pri(tpid);
@@ -1881,8 +2598,10 @@ void odp_timeout_free(odp_timeout_t tmo)
 void odp_timer_pool_print(odp_timer_pool_t timer_pool)
 {
 	timer_pool_t *tp;
+	uint64_t expire, enq;
+	uint32_t i;
 	int len = 0;
-	int max_len = 512;
+	int max_len = 2048;
 	int n = max_len - 1;
 	char str[max_len];
 
@@ -1904,6 +2623,25 @@ void odp_timer_pool_print(odp_timer_pool_t timer_pool)
 	len += _odp_snprint(&str[len], n - len, "  inline timers  %i\n",
 			    timer_global->use_inline_timers);
 	len += _odp_snprint(&str[len], n - len, "  periodic       %i\n", tp->periodic);
+	len += _odp_snprint(&str[len], n - len, "  timing wheel   %i\n", tp->wheel != NULL);
+	len += _odp_snprint(&str[len], n - len, "  timer threads  %u\n", tp->num_thr);
+	len += _odp_snprint(&str[len], n - len, "  overruns       %" PRIu64 "\n",
+			    odp_atomic_load_u64(&tp->overruns));
+	len += _odp_snprint(&str[len], n - len, "  num expired    %" PRIu64 "\n",
+			    odp_atomic_load_u64(&tp->stats.num_expired));
+	len += _odp_snprint(&str[len], n - len, "  lateness (nsec)       expire      enqueue\n");
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++) {
+		expire = odp_atomic_load_u64(&tp->stats.expire_lateness[i]);
+		enq = odp_atomic_load_u64(&tp->stats.enq_lateness[i]);
+
+		if (expire == 0 && enq == 0)
+			continue;
+
+		len += _odp_snprint(&str[len], n - len, "    >= %-10" PRIu64 " %12" PRIu64 " %12"
+				    PRIu64 "\n", i ? (uint64_t)1 << (i - 1) : 0, expire, enq);
+	}
+
 	str[len] = 0;
 
 	_ODP_PRINT("%s\n", str);
@@ -1993,6 +2731,7 @@ int _odp_timer_init_global(const odp_init_t *params)
 	odp_time_t time;
 	const char *conf_str;
 	uint32_t i;
+	int j, num;
 	int val = 0;
 
 	if (params && params->not_used.feat.timer) {
@@ -2064,6 +2803,45 @@ int _odp_timer_init_global(const odp_init_t *params)
 	}
 	timer_global->thread_type = val;
 	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.wheel_min_timers";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		goto error;
+	}
+	if (val < 0) {
+		_ODP_ERR("Bad value %s = %i\n", conf_str, val);
+		goto error;
+	}
+	timer_global->wheel_min_timers = val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.posix_threads";
+	if (!_odp_libconfig_lookup_int(conf_str, &val)) {
+		_ODP_ERR("Config option '%s' not found.\n", conf_str);
+		goto error;
+	}
+	if (val < 1 || val > MAX_POSIX_THREADS) {
+		_ODP_ERR("Bad value %s = %i\n", conf_str, val);
+		goto error;
+	}
+	timer_global->posix_threads = val;
+	_ODP_PRINT("  %s: %i\n", conf_str, val);
+
+	conf_str =  "timer.posix_thread_cpus";
+	num = _odp_libconfig_lookup_array(conf_str, timer_global->posix_cpu, MAX_POSIX_THREADS);
+	for (j = 0; j < num; j++) {
+		if (timer_global->posix_cpu[j] < 0 || timer_global->posix_cpu[j] >= CPU_SETSIZE) {
+			_ODP_ERR("Bad value %s[%i] = %i\n", conf_str, j,
+				 timer_global->posix_cpu[j]);
+			goto error;
+		}
+	}
+	timer_global->num_posix_cpus = num;
+	_ODP_PRINT("  %s: [", conf_str);
+	for (j = 0; j < num; j++)
+		_ODP_PRINT("%s%i", j ? ", " : "", timer_global->posix_cpu[j]);
+	_ODP_PRINT("]\n");
 	_ODP_PRINT("\n");
 
 	if (!timer_global->use_inline_timers) {
@@ -19,6 +19,8 @@
  * with "pcap:" and be in the format;
  *
  * pcap:in=test.pcap:out=test_out.pcap:loops=10
+ * pcap:in=test.pcap:mmap=1:rate=1000000
+ * pcap:out=test_out.pcap:bufsize=4096:rotate_size=1024
  *
  *   in      the name of the input pcap file. If no input file is given
  *           attempts to receive from the pktio will just return no
@@ -32,17 +34,47 @@
  *   loops   the number of times to iterate through the input file, set
  *           to 0 to loop indefinitely. The default value is 1. Looping is
  *           only supported in thread mode (ODP_MEM_MODEL_THREAD).
+ *   mmap    set to 1 to replay the input file in memory mapped mode. The
+ *           file is mapped into memory and indexed once on open, instead of
+ *           reading it through libpcap packet by packet. Packets are
+ *           copied into pool packets in bursts. This mode supports
+ *           multiple input queues. Packets are spread between queues by
+ *           flow hash when hashing is enabled in input queue parameters,
+ *           otherwise in round robin order. Only classic pcap file format
+ *           is supported (not pcapng).
+ *   rate    replay rate in packets per second (mmap mode only). The rate is
+ *           divided evenly between input queues. The default value 0
+ *           means no rate limit.
+ *   pace    set to 1 to replay packets with the same relative timing as
+ *           recorded in the input file timestamps (mmap mode only).
+ *   bufsize write buffer size in kilobytes. When set, the output file is
+ *           written in buffered mode: transmitted packets are copied into
+ *           large write buffers, which a background thread writes into the
+ *           file. Packets are dropped (and counted as output discards) when
+ *           all buffers are waiting to be written. A partially filled buffer
+ *           is written after 100 ms. Buffered mode is only supported in
+ *           thread mode (ODP_MEM_MODEL_THREAD).
+ *   rotate_size
+ *           start a new output file when the current file would exceed this
+ *           many megabytes (buffered mode only). Files after the first one
+ *           are named by appending .1, .2, ... to the output file name.
+ *   rotate_time
+ *           start a new output file after this many seconds (buffered mode
+ *           only).
  *
  * The total length of the string is limited by PKTIO_NAME_LEN.
  */
 
 #include <odp_posix_extensions.h>
 
+#include <odp/api/byteorder.h>
 #include <odp/api/debug.h>
+#include <odp/api/hash.h>
 #include <odp/api/hints.h>
 #include <odp/api/packet.h>
 #include <odp/api/packet_io.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/time.h>
 
 #include <odp/api/plat/packet_inlines.h>
 
@@ -52,13 +84,102 @@
 #include <odp_global_data.h>
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
+#include <odp_pool_internal.h>
 
 #include <protocols/eth.h>
+#include <protocols/ip.h>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
 #include <pcap/pcap.h>
 #include <pcap/bpf.h>
+#include <pthread.h>
 #include <stdint.h>
+#include <stdio.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/* Maximum number of input queues in mmap mode */
+#define PCAP_MAX_QUEUES 16
+
+/* Pcap file format */
+#define PCAP_MAGIC_USEC 0xa1b2c3d4
+#define PCAP_MAGIC_NSEC 0xa1b23c4d
+#define PCAP_FILE_HDR_LEN 24
+#define PCAP_REC_HDR_LEN  16
+
+/* Buffered output mode */
+#define PCAP_WR_NUM_BUF   8
+#define PCAP_WR_BUF_ALIGN 4096
+#define PCAP_WR_FLUSH_NS  (100 * ODP_TIME_MSEC_IN_NS)
+/* Minimum interval between output file open retries */
+#define PCAP_WR_REOPEN_NS ODP_TIME_SEC_IN_NS
+
+/* Input file record in mmap mode */
+typedef struct {
+	const uint8_t *data;	/**< packet data in the mapped file */
+	uint32_t len;		/**< captured length */
+	uint64_t ts_ns;		/**< timestamp relative to the first record */
+} pcap_rec_t;
+
+/* Pcap record header */
+typedef struct {
+	uint32_t ts_sec;
+	uint32_t ts_usec;
+	uint32_t caplen;
+	uint32_t len;
+} pcap_rec_hdr_t;
+
+ODP_STATIC_ASSERT(sizeof(pcap_rec_hdr_t) == PCAP_REC_HDR_LEN, "PCAP_REC_HDR_LEN mismatch");
+
+/* Output file writer in buffered mode. Data path fills buffer 'head' and
+ * writer thread writes buffers from 'tail' up to (but not including) 'head'.
+ * Indexes increment freely and are used modulo PCAP_WR_NUM_BUF. */
+typedef struct {
+	pthread_t thread;
+	odp_bool_t thread_created;
+	pthread_mutex_t mutex;
+	pthread_cond_t cond;
+	uint32_t head;
+	uint32_t tail;
+	int stop;
+	uint8_t *buf[PCAP_WR_NUM_BUF];
+	uint32_t buf_len[PCAP_WR_NUM_BUF];
+	uint32_t buf_size;
+	/* Time when the current buffer received its first packet */
+	uint64_t fill_start_ns;
+	pktio_entry_t *pktio_entry;
+
+	/* Owned by writer thread */
+	int fd;
+	uint32_t file_idx;
+	uint64_t file_len;
+	uint64_t file_start_ns;
+	uint64_t reopen_ns;
+	uint64_t rotate_size;
+	uint64_t rotate_ns;
+
+	odp_atomic_u64_t write_errors;
+} pcap_writer_t;
+
+/* Input queue in mmap mode */
+typedef struct ODP_ALIGNED_CACHE {
+	odp_ticketlock_t lock;
+	uint32_t *idx;		/**< record indexes of this queue */
+	uint32_t num;		/**< number of records */
+	uint32_t pos;		/**< next record */
+	int loop_cnt;		/**< number of loops completed */
+	uint64_t rate;		/**< packet rate of this queue */
+	odp_time_t start;	/**< pacing start time */
+	uint64_t ts_base;	/**< record timestamp at pacing start */
+	uint64_t num_paced;	/**< packets received since pacing start */
+	uint64_t in_octets;
+	uint64_t in_packets;
+} pcap_rxq_t;
 
 typedef struct {
 	char *fname_rx;		/**< name of pcap file for rx */
@@ -71,6 +192,28 @@ typedef struct {
 	int loops;		/**< number of times to loop rx pcap */
 	int loop_cnt;		/**< number of loops completed */
 	odp_bool_t promisc;	/**< promiscuous mode state */
+	odp_bool_t mmap;	/**< memory mapped replay mode */
+	odp_bool_t pace;	/**< replay using file timestamps */
+	uint64_t rate;		/**< replay rate in packets per second */
+	uint8_t *map;		/**< mapped input file */
+	size_t map_len;		/**< length of the mapping */
+	pcap_rec_t *rec;	/**< input file records */
+	uint32_t num_rec;	/**< number of records */
+	uint32_t *rec_idx;	/**< record index storage of input queues */
+	uint32_t seg_len;	/**< pool segment length */
+	uint32_t num_rxq;	/**< number of configured input queues */
+	odp_bool_t hash_enable;	/**< spread packets by flow hash */
+	uint32_t wr_buf_kb;	/**< write buffer size in buffered output mode */
+	uint32_t rotate_mb;	/**< output file rotation size */
+	uint32_t rotate_sec;	/**< output file rotation interval */
+	pcap_writer_t *wr;	/**< writer in buffered output mode */
+	/** Input queue setup in use */
+	struct {
+		uint32_t num_rxq;
+		odp_bool_t hash_enable;
+		odp_bool_t valid;
+	} rxq_conf;
+	pcap_rxq_t rxq[PCAP_MAX_QUEUES];
 } pkt_pcap_t;
 
 ODP_STATIC_ASSERT(PKTIO_PRIVATE_SIZE >= sizeof(pkt_pcap_t),
@@ -112,9 +255,31 @@ static int _pcapif_parse_devname(pkt_pcap_t *pcap, const char *devname)
 				_ODP_ERR("invalid loop count\n");
 				return -1;
 			}
+		} else if (strncmp(tok, "mmap=", 5) == 0) {
+			pcap->mmap = atoi(tok + 5) != 0;
+		} else if (strncmp(tok, "rate=", 5) == 0) {
+			pcap->rate = strtoull(tok + 5, NULL, 10);
+		} else if (strncmp(tok, "pace=", 5) == 0) {
+			pcap->pace = atoi(tok + 5) != 0;
+		} else if (strncmp(tok, "bufsize=", 8) == 0) {
+			pcap->wr_buf_kb = strtoul(tok + 8, NULL, 10);
+		} else if (strncmp(tok, "rotate_size=", 12) == 0) {
+			pcap->rotate_mb = strtoul(tok + 12, NULL, 10);
+		} else if (strncmp(tok, "rotate_time=", 12) == 0) {
+			pcap->rotate_sec = strtoul(tok + 12, NULL, 10);
 		}
 	}
 
+	if ((pcap->rate || pcap->pace) && !pcap->mmap) {
+		_ODP_ERR("rate and pace options require mmap mode\n");
+		return -1;
+	}
+
+	if ((pcap->rotate_mb || pcap->rotate_sec) && !pcap->wr_buf_kb) {
+		_ODP_ERR("rotate options require buffered output (bufsize)\n");
+		return -1;
+	}
+
 	return 0;
 }
 
@@ -138,6 +303,119 @@ static int _pcapif_init_rx(pkt_pcap_t *pcap)
 	return 0;
 }
 
+static inline uint32_t _pcapif_read_u32(const uint8_t *ptr, odp_bool_t big_endian)
+{
+	uint32_t val;
+
+	memcpy(&val, ptr, sizeof(val));
+
+	return big_endian ? odp_be_to_cpu_32(val) : odp_le_to_cpu_32(val);
+}
+
+/* Map input file into memory and index its records */
+static int _pcapif_init_rx_mmap(pkt_pcap_t *pcap)
+{
+	struct stat st;
+	uint32_t magic, linktype, num;
+	uint64_t off, first_ts = 0;
+	odp_bool_t big_endian, nsec;
+	int fd;
+
+	fd = open(pcap->fname_rx, O_RDONLY);
+	if (fd < 0) {
+		_ODP_ERR("failed to open pcap file %s (%s)\n", pcap->fname_rx, strerror(errno));
+		return -1;
+	}
+
+	if (fstat(fd, &st) != 0 || st.st_size < PCAP_FILE_HDR_LEN) {
+		_ODP_ERR("bad pcap file %s\n", pcap->fname_rx);
+		close(fd);
+		return -1;
+	}
+
+	pcap->map_len = st.st_size;
+	pcap->map = mmap(NULL, pcap->map_len, PROT_READ, MAP_PRIVATE | MAP_POPULATE, fd, 0);
+	close(fd);
+
+	if (pcap->map == MAP_FAILED) {
+		_ODP_ERR("failed to map pcap file %s (%s)\n", pcap->fname_rx, strerror(errno));
+		pcap->map = NULL;
+		return -1;
+	}
+
+	magic = _pcapif_read_u32(pcap->map, false);
+	big_endian = magic != PCAP_MAGIC_USEC && magic != PCAP_MAGIC_NSEC;
+	if (big_endian)
+		magic = _pcapif_read_u32(pcap->map, true);
+
+	if (magic != PCAP_MAGIC_USEC && magic != PCAP_MAGIC_NSEC) {
+		_ODP_ERR("unsupported file format (magic 0x%x), pcap file required\n", magic);
+		return -1;
+	}
+
+	nsec = magic == PCAP_MAGIC_NSEC;
+
+	linktype = _pcapif_read_u32(pcap->map + 20, big_endian);
+	if (linktype != DLT_EN10MB) {
+		_ODP_ERR("unsupported datalink type: %u\n", linktype);
+		return -1;
+	}
+
+	/* First pass counts records, second pass fills the index */
+	for (int pass = 0; pass < 2; pass++) {
+		off = PCAP_FILE_HDR_LEN;
+		num = 0;
+
+		while (off + PCAP_REC_HDR_LEN <= pcap->map_len) {
+			const uint8_t *hdr = pcap->map + off;
+			uint32_t len = _pcapif_read_u32(hdr + 8, big_endian);
+			uint64_t ts;
+
+			if (off + PCAP_REC_HDR_LEN + len > pcap->map_len) {
+				if (pass == 0)
+					_ODP_DBG("truncated record at offset %" PRIu64 "\n", off);
+				break;
+			}
+
+			if (pass) {
+				ts = _pcapif_read_u32(hdr, big_endian) * ODP_TIME_SEC_IN_NS;
+				ts += (uint64_t)_pcapif_read_u32(hdr + 4, big_endian) *
+				      (nsec ? 1 : ODP_TIME_USEC_IN_NS);
+
+				if (num == 0)
+					first_ts = ts;
+
+				pcap->rec[num].data = hdr + PCAP_REC_HDR_LEN;
+				pcap->rec[num].len = len;
+				/* Timestamps are expected to be in order */
+				pcap->rec[num].ts_ns = ts > first_ts ? ts - first_ts : 0;
+			}
+
+			off += PCAP_REC_HDR_LEN + len;
+			num++;
+		}
+
+		if (pass == 0) {
+			if (num == 0)
+				break;
+
+			pcap->rec = malloc(num * sizeof(pcap_rec_t));
+			if (!pcap->rec) {
+				_ODP_ERR("record index alloc failed\n");
+				return -1;
+			}
+		}
+
+		pcap->num_rec = num;
+	}
+
+	pcap->seg_len = _odp_pool_entry(pcap->pool)->seg_len;
+
+	_ODP_DBG("pcap file %s: %u records\n", pcap->fname_rx, pcap->num_rec);
+
+	return 0;
+}
+
 static int _pcapif_init_tx(pkt_pcap_t *pcap)
 {
 	pcap_t *tx = pcap->rx;
@@ -163,6 +441,259 @@ static int _pcapif_init_tx(pkt_pcap_t *pcap)
 	return pcap_dump_flush(pcap->tx_dump);
 }
 
+static int _pcapif_wr_open_file(pcap_writer_t *wr, const char *fname)
+{
+	char name[PKTIO_NAME_LEN + 16];
+	struct {
+		uint32_t magic;
+		uint16_t version_major;
+		uint16_t version_minor;
+		int32_t thiszone;
+		uint32_t sigfigs;
+		uint32_t snaplen;
+		uint32_t linktype;
+	} hdr = {PCAP_MAGIC_USEC, 2, 4, 0, 0, PKTIO_PCAP_MTU_MAX, DLT_EN10MB};
+
+	ODP_STATIC_ASSERT(sizeof(hdr) == PCAP_FILE_HDR_LEN, "PCAP_FILE_HDR_LEN mismatch");
+
+	if (wr->file_idx)
+		snprintf(name, sizeof(name), "%s.%" PRIu32, fname, wr->file_idx);
+	else
+		snprintf(name, sizeof(name), "%s", fname);
+
+	wr->fd = open(name, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (wr->fd < 0) {
+		_ODP_ERR("failed to open dump file %s (%s)\n", name, strerror(errno));
+		return -1;
+	}
+
+	if (write(wr->fd, &hdr, sizeof(hdr)) != sizeof(hdr)) {
+		_ODP_ERR("failed to write dump file header %s\n", name);
+		close(wr->fd);
+		wr->fd = -1;
+		return -1;
+	}
+
+	wr->file_len = sizeof(hdr);
+	wr->file_start_ns = odp_time_global_ns();
+
+	return 0;
+}
+
+/* Write a buffer into the output file. Called only by the writer thread. */
+static void _pcapif_wr_write(pcap_writer_t *wr, const uint8_t *buf, uint32_t len)
+{
+	pkt_pcap_t *pcap = pkt_priv(wr->pktio_entry);
+	uint32_t done = 0;
+
+	if (wr->fd >= 0 &&
+	    ((wr->rotate_size && wr->file_len > PCAP_FILE_HDR_LEN &&
+	      wr->file_len + len > wr->rotate_size) ||
+	     (wr->rotate_ns && odp_time_global_ns() - wr->file_start_ns >= wr->rotate_ns))) {
+		close(wr->fd);
+		wr->fd = -1;
+		wr->file_idx++;
+		wr->reopen_ns = 0;
+	}
+
+	if (wr->fd < 0) {
+		uint64_t now = odp_time_global_ns();
+
+		/* Retry the same file index, at most once per interval. Data written
+		 * meanwhile is dropped. */
+		if (wr->reopen_ns == 0 || now - wr->reopen_ns >= PCAP_WR_REOPEN_NS) {
+			wr->reopen_ns = now;
+			(void)_pcapif_wr_open_file(wr, pcap->fname_tx);
+		}
+
+		if (wr->fd < 0) {
+			odp_atomic_inc_u64(&wr->write_errors);
+			return;
+		}
+	}
+
+	while (done < len) {
+		ssize_t ret = write(wr->fd, buf + done, len - done);
+
+		if (ret < 0) {
+			if (errno == EINTR)
+				continue;
+
+			_ODP_ERR("dump file write failed (%s)\n", strerror(errno));
+			odp_atomic_inc_u64(&wr->write_errors);
+			return;
+		}
+
+		done += ret;
+	}
+
+	wr->file_len += len;
+}
+
+/* Pass the current buffer to the writer thread. Called with mutex locked.
+ * Fails when there is no free buffer to continue with. */
+static int _pcapif_wr_switch(pcap_writer_t *wr)
+{
+	if (wr->head + 1 - wr->tail >= PCAP_WR_NUM_BUF)
+		return -1;
+
+	wr->head++;
+	wr->buf_len[wr->head % PCAP_WR_NUM_BUF] = 0;
+	pthread_cond_broadcast(&wr->cond);
+
+	return 0;
+}
+
+static void *_pcapif_wr_thread(void *arg)
+{
+	pcap_writer_t *wr = arg;
+	pktio_entry_t *pktio_entry = wr->pktio_entry;
+
+	pthread_mutex_lock(&wr->mutex);
+
+	while (1) {
+		uint32_t idx;
+
+		if (wr->tail == wr->head) {
+			struct timespec abstime;
+			int ret;
+
+			if (wr->stop)
+				break;
+
+			clock_gettime(CLOCK_REALTIME, &abstime);
+			abstime.tv_nsec += PCAP_WR_FLUSH_NS;
+			if (abstime.tv_nsec >= (long)ODP_TIME_SEC_IN_NS) {
+				abstime.tv_sec++;
+				abstime.tv_nsec -= ODP_TIME_SEC_IN_NS;
+			}
+
+			ret = pthread_cond_timedwait(&wr->cond, &wr->mutex, &abstime);
+			if (ret != ETIMEDOUT)
+				continue;
+
+			/* Flush a partially filled buffer. Lock order is the
+			 * same as in the data path. */
+			pthread_mutex_unlock(&wr->mutex);
+			odp_ticketlock_lock(&pktio_entry->txl);
+			pthread_mutex_lock(&wr->mutex);
+
+			if (wr->buf_len[wr->head % PCAP_WR_NUM_BUF] &&
+			    odp_time_global_ns() - wr->fill_start_ns >= PCAP_WR_FLUSH_NS)
+				(void)_pcapif_wr_switch(wr);
+
+			odp_ticketlock_unlock(&pktio_entry->txl);
+			continue;
+		}
+
+		idx = wr->tail % PCAP_WR_NUM_BUF;
+		pthread_mutex_unlock(&wr->mutex);
+
+		_pcapif_wr_write(wr, wr->buf[idx], wr->buf_len[idx]);
+
+		pthread_mutex_lock(&wr->mutex);
+		wr->tail++;
+		pthread_cond_broadcast(&wr->cond);
+	}
+
+	pthread_mutex_unlock(&wr->mutex);
+
+	return NULL;
+}
+
+static void _pcapif_wr_term(pkt_pcap_t *pcap)
+{
+	pcap_writer_t *wr = pcap->wr;
+
+	if (!wr)
+		return;
+
+	if (wr->thread_created) {
+		pthread_mutex_lock(&wr->mutex);
+
+		/* Write also the last, partially filled buffer */
+		if (wr->buf_len[wr->head % PCAP_WR_NUM_BUF]) {
+			while (_pcapif_wr_switch(wr))
+				pthread_cond_wait(&wr->cond, &wr->mutex);
+		}
+
+		wr->stop = 1;
+		pthread_cond_broadcast(&wr->cond);
+		pthread_mutex_unlock(&wr->mutex);
+
+		pthread_join(wr->thread, NULL);
+	}
+
+	if (wr->fd >= 0)
+		close(wr->fd);
+
+	for (int i = 0; i < PCAP_WR_NUM_BUF; i++)
+		free(wr->buf[i]);
+
+	pthread_cond_destroy(&wr->cond);
+	pthread_mutex_destroy(&wr->mutex);
+	free(wr);
+	pcap->wr = NULL;
+}
+
+static int _pcapif_init_tx_buffered(pktio_entry_t *pktio_entry)
+{
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+	pcap_writer_t *wr;
+	uint32_t buf_size = pcap->wr_buf_kb * 1024;
+
+	/* Buffers and writer thread are process local */
+	if (odp_global_ro.init_param.mem_model == ODP_MEM_MODEL_PROCESS) {
+		_ODP_ERR("buffered output not supported in process mode\n");
+		return -1;
+	}
+
+	/* Buffer must hold at least one maximum size packet */
+	if (buf_size < PCAP_REC_HDR_LEN + PKTIO_PCAP_MTU_MAX)
+		buf_size = PCAP_REC_HDR_LEN + PKTIO_PCAP_MTU_MAX;
+
+	buf_size = _ODP_ROUNDUP_ALIGN(buf_size, PCAP_WR_BUF_ALIGN);
+
+	wr = calloc(1, sizeof(pcap_writer_t));
+	if (!wr) {
+		_ODP_ERR("writer alloc failed\n");
+		return -1;
+	}
+
+	pcap->wr = wr;
+	wr->fd = -1;
+	wr->buf_size = buf_size;
+	wr->pktio_entry = pktio_entry;
+	wr->rotate_size = (uint64_t)pcap->rotate_mb * 1024 * 1024;
+	wr->rotate_ns = pcap->rotate_sec * ODP_TIME_SEC_IN_NS;
+	odp_atomic_init_u64(&wr->write_errors, 0);
+	pthread_mutex_init(&wr->mutex, NULL);
+	pthread_cond_init(&wr->cond, NULL);
+
+	for (int i = 0; i < PCAP_WR_NUM_BUF; i++) {
+		if (posix_memalign((void **)&wr->buf[i], PCAP_WR_BUF_ALIGN, buf_size)) {
+			_ODP_ERR("write buffer alloc failed\n");
+			goto error;
+		}
+	}
+
+	if (_pcapif_wr_open_file(wr, pcap->fname_tx))
+		goto error;
+
+	if (pthread_create(&wr->thread, NULL, _pcapif_wr_thread, wr)) {
+		_ODP_ERR("writer thread create failed\n");
+		goto error;
+	}
+
+	wr->thread_created = true;
+
+	return 0;
+
+error:
+	_pcapif_wr_term(pcap);
+	return -1;
+}
+
 static int pcapif_promisc_mode_set(pktio_entry_t *pktio_entry,
 				   odp_bool_t enable)
 {
@@ -211,6 +742,8 @@ static int pcapif_init(odp_pktio_t id ODP_UNUSED, pktio_entry_t *pktio_entry,
 	int ret;
 
 	memset(pcap, 0, sizeof(pkt_pcap_t));
+	for (int i = 0; i < PCAP_MAX_QUEUES; i++)
+		odp_ticketlock_init(&pcap->rxq[i].lock);
 	pcap->loop_cnt = 1;
 	pcap->loops = 1;
 	pcap->pool = pool;
@@ -219,12 +752,13 @@ static int pcapif_init(odp_pktio_t id ODP_UNUSED, pktio_entry_t *pktio_entry,
 	ret = _pcapif_parse_devname(pcap, devname);
 
 	if (ret == 0 && pcap->fname_rx)
-		ret = _pcapif_init_rx(pcap);
+		ret = pcap->mmap ? _pcapif_init_rx_mmap(pcap) : _pcapif_init_rx(pcap);
 
 	if (ret == 0 && pcap->fname_tx)
-		ret = _pcapif_init_tx(pcap);
+		ret = pcap->wr_buf_kb ? _pcapif_init_tx_buffered(pktio_entry) :
+					_pcapif_init_tx(pcap);
 
-	if (ret == 0 && (!pcap->rx && !pcap->tx_dump))
+	if (ret == 0 && (!pcap->rx && !pcap->map && !pcap->tx_dump && !pcap->wr))
 		ret = -1;
 
 	(void)pcapif_stats_reset(pktio_entry);
@@ -239,6 +773,8 @@ static int pcapif_close(pktio_entry_t *pktio_entry)
 {
 	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
 
+	_pcapif_wr_term(pcap);
+
 	if (pcap->tx_dump)
 		pcap_dump_close(pcap->tx_dump);
 
@@ -248,6 +784,11 @@ static int pcapif_close(pktio_entry_t *pktio_entry)
 	if (pcap->rx)
 		pcap_close(pcap->rx);
 
+	if (pcap->map)
+		munmap(pcap->map, pcap->map_len);
+
+	free(pcap->rec);
+	free(pcap->rec_idx);
 	free(pcap->fname_rx);
 	free(pcap->fname_tx);
 
@@ -277,6 +818,50 @@ static int _pcapif_reopen(pkt_pcap_t *pcap)
 	return 0;
 }
 
+/* Parse and classify a received packet. Returns 0 when packet is accepted and
+ * <0 when packet was dropped. */
+static inline int _pcapif_parse_pkt(pktio_entry_t *pktio_entry, odp_packet_t *pkt,
+				    odp_packet_hdr_t **pkt_hdr, const uint8_t *data,
+				    uint32_t pkt_len, int cls_enabled)
+{
+	const odp_proto_layer_t layer = pktio_entry->parse_layer;
+	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
+	int ret;
+
+	if (!layer)
+		return 0;
+
+	ret = _odp_packet_parse_common(*pkt_hdr, data, pkt_len, pkt_len, layer, opt);
+	if (ret)
+		odp_atomic_inc_u64(&pktio_entry->stats_extra.in_errors);
+
+	if (ret < 0) {
+		odp_packet_free(*pkt);
+		return -1;
+	}
+
+	if (cls_enabled) {
+		odp_pool_t new_pool;
+
+		ret = _odp_cls_classify_packet(pktio_entry, data, &new_pool, *pkt_hdr);
+		if (ret < 0)
+			odp_atomic_inc_u64(&pktio_entry->stats_extra.in_discards);
+
+		if (ret) {
+			odp_packet_free(*pkt);
+			return -1;
+		}
+
+		if (odp_unlikely(_odp_pktio_packet_to_pool(pkt, pkt_hdr, new_pool))) {
+			odp_packet_free(*pkt);
+			odp_atomic_inc_u64(&pktio_entry->stats_extra.in_discards);
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			   odp_packet_t pkts[], int num)
 {
@@ -295,7 +880,6 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	int num_cls = 0;
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
 	uint16_t frame_offset = pktio_entry->pktin_frame_offset;
-	const odp_proto_layer_t layer = pktio_entry->parse_layer;
 	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
 
 	odp_ticketlock_lock(&pktio_entry->rxl);
@@ -338,38 +922,9 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			break;
 		}
 
-		if (layer) {
-			ret = _odp_packet_parse_common(pkt_hdr, data, pkt_len,
-						       pkt_len, layer, opt);
-			if (ret)
-				odp_atomic_inc_u64(&pktio_entry->stats_extra.in_errors);
-
-			if (ret < 0) {
-				odp_packet_free(pkt);
-				continue;
-			}
-
-			if (cls_enabled) {
-				odp_pool_t new_pool;
-
-				ret = _odp_cls_classify_packet(pktio_entry, data,
-							       &new_pool, pkt_hdr);
-				if (ret < 0)
-					odp_atomic_inc_u64(&pktio_entry->stats_extra.in_discards);
-
-				if (ret) {
-					odp_packet_free(pkt);
-					continue;
-				}
-
-				if (odp_unlikely(_odp_pktio_packet_to_pool(
-					    &pkt, &pkt_hdr, new_pool))) {
-					odp_packet_free(pkt);
-					odp_atomic_inc_u64(&pktio_entry->stats_extra.in_discards);
-					continue;
-				}
-			}
-		}
+		if (_pcapif_parse_pkt(pktio_entry, &pkt, &pkt_hdr, data, pkt_len,
+				      cls_enabled))
+			continue;
 
 		packet_set_ts(pkt_hdr, ts);
 		pkt_hdr->input = pktio_entry->handle;
@@ -400,6 +955,183 @@ static int pcapif_recv_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	return num_pkts;
 }
 
+/* Same filter as libpcap mode uses when not in promiscuous mode */
+static inline odp_bool_t _pcapif_rec_filtered(const pcap_rec_t *rec)
+{
+	if (rec->len < _ODP_ETHHDR_LEN)
+		return true;
+
+	return !(rec->data[0] & 0x1) && memcmp(rec->data, pcap_mac, _ODP_ETHADDR_LEN) != 0;
+}
+
+static int pcapif_recv_mmap(pktio_entry_t *pktio_entry, int index,
+			    odp_packet_t pkts[], int num)
+{
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+	pcap_rxq_t *rxq = &pcap->rxq[index];
+	const pcap_rec_t *rec[num];
+	uint32_t rec_off[num];
+	odp_packet_t pkt_tbl[num];
+	odp_time_t now;
+	uint64_t elapsed;
+	uint32_t max_len = 0;
+	uint32_t scan, consumed;
+	uint64_t octets = 0;
+	const odp_bool_t promisc = pcap->promisc;
+	int i, n, num_alloc;
+	int num_pkts = 0;
+	int num_cls = 0;
+	const int cls_enabled = pktio_cls_enabled(pktio_entry);
+	uint16_t frame_offset = pktio_entry->pktin_frame_offset;
+	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
+	odp_time_t *ts = NULL;
+
+	if (opt.bit.ts_all || opt.bit.ts_ptp)
+		ts = &now;
+
+	odp_ticketlock_lock(&rxq->lock);
+
+	if (odp_unlikely(rxq->num == 0))
+		goto unlock;
+
+	now = odp_time_global();
+
+	/* End of records, start the next loop if within loop limit */
+	if (rxq->pos == rxq->num) {
+		if (pcap->loops != 0 && rxq->loop_cnt + 1 >= pcap->loops)
+			goto unlock;
+
+		rxq->loop_cnt++;
+		rxq->pos = 0;
+
+		/* Rate limit counts packets since start, both restart together */
+		if (pcap->pace) {
+			rxq->start = now;
+			rxq->num_paced = 0;
+			rxq->ts_base = pcap->rec[rxq->idx[0]].ts_ns;
+		}
+	}
+
+	/* Records are gathered up to the end of the current loop */
+	n = _ODP_MIN((uint32_t)num, rxq->num - rxq->pos);
+	elapsed = odp_time_diff_ns(now, rxq->start);
+
+	if (pcap->rate) {
+		uint64_t allowed = (elapsed / ODP_TIME_USEC_IN_NS) * rxq->rate /
+				   (ODP_TIME_SEC_IN_NS / ODP_TIME_USEC_IN_NS);
+
+		if (allowed <= rxq->num_paced)
+			goto unlock;
+
+		if (allowed - rxq->num_paced < (uint64_t)n)
+			n = allowed - rxq->num_paced;
+	}
+
+	/* Promiscuous mode filter is applied here instead of on queue setup, so that
+	 * mode changes take effect without rebuilding the queues. Filtered records
+	 * consume replay rate and time like received ones. */
+	for (scan = 0, i = 0; scan < (uint32_t)n; scan++) {
+		const pcap_rec_t *r = &pcap->rec[rxq->idx[rxq->pos + scan]];
+
+		if (pcap->pace && r->ts_ns > rxq->ts_base &&
+		    r->ts_ns - rxq->ts_base > elapsed)
+			break;
+
+		if (!promisc && _pcapif_rec_filtered(r))
+			continue;
+
+		rec[i] = r;
+		rec_off[i] = scan;
+		i++;
+		if (r->len > max_len)
+			max_len = r->len;
+	}
+
+	n = i;
+	if (n == 0) {
+		rxq->pos += scan;
+		rxq->num_paced += scan;
+		goto unlock;
+	}
+
+	if (max_len + frame_offset <= pcap->seg_len) {
+		/* Allocate all packets in a single call and trim to size */
+		num_alloc = _odp_packet_alloc_multi(pcap->pool, max_len + frame_offset,
+						    pkt_tbl, n);
+	} else {
+		for (num_alloc = 0; num_alloc < n; num_alloc++) {
+			if (_odp_packet_alloc_multi(pcap->pool, rec[num_alloc]->len + frame_offset,
+						    &pkt_tbl[num_alloc], 1) != 1)
+				break;
+		}
+		max_len = 0;
+	}
+
+	/* Records without a packet are left for the next call */
+	consumed = num_alloc < n ? rec_off[num_alloc] : scan;
+	rxq->pos += consumed;
+	rxq->num_paced += consumed;
+
+	for (i = 0; i < num_alloc; i++) {
+		odp_packet_t pkt = pkt_tbl[i];
+		odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+		uint32_t pkt_len = rec[i]->len;
+		const uint8_t *data = rec[i]->data;
+
+		if (frame_offset)
+			pull_head(pkt_hdr, frame_offset);
+
+		if (max_len > pkt_len)
+			pull_tail(pkt_hdr, max_len - pkt_len);
+
+		if (odp_packet_copy_from_mem(pkt, 0, pkt_len, data) != 0) {
+			_ODP_ERR("failed to copy packet data\n");
+			odp_packet_free(pkt);
+			continue;
+		}
+
+		if (_pcapif_parse_pkt(pktio_entry, &pkt, &pkt_hdr, data, pkt_len,
+				      cls_enabled))
+			continue;
+
+		packet_set_ts(pkt_hdr, ts);
+		pkt_hdr->input = pktio_entry->handle;
+
+		if (!pkt_hdr->p.flags.all.error) {
+			octets += pkt_len;
+			rxq->in_packets++;
+		}
+
+		/* Enqueue packets directly to classifier destination queue */
+		if (cls_enabled) {
+			pkts[num_cls++] = pkt;
+			num_cls = _odp_cls_enq(pkts, num_cls, (i + 1 == num_alloc));
+		} else {
+			pkts[num_pkts++] = pkt;
+		}
+	}
+
+	/* Enqueue remaining classified packets */
+	if (odp_unlikely(num_cls))
+		_odp_cls_enq(pkts, num_cls, true);
+
+	rxq->in_octets += octets;
+
+unlock:
+	odp_ticketlock_unlock(&rxq->lock);
+
+	return num_pkts;
+}
+
+static int pcapif_recv(pktio_entry_t *pktio_entry, int index,
+		       odp_packet_t pkts[], int num)
+{
+	if (pkt_priv(pktio_entry)->mmap)
+		return pcapif_recv_mmap(pktio_entry, index, pkts, num);
+
+	return pcapif_recv_pkt(pktio_entry, index, pkts, num);
+}
+
 static int _pcapif_dump_pkt(pkt_pcap_t *pcap, odp_packet_t pkt)
 {
 	struct pcap_pkthdr hdr;
@@ -421,15 +1153,62 @@ static int _pcapif_dump_pkt(pkt_pcap_t *pcap, odp_packet_t pkt)
 	return 0;
 }
 
+/* Copy a packet into the current write buffer. Returns 0 on success and <0
+ * when the packet was dropped. Called with txl locked. */
+static int _pcapif_buf_pkt(pcap_writer_t *wr, odp_packet_t pkt,
+			   const struct timeval *tv)
+{
+	uint32_t idx = wr->head % PCAP_WR_NUM_BUF;
+	uint32_t pkt_len = odp_packet_len(pkt);
+	pcap_rec_hdr_t hdr;
+	uint8_t *ptr;
+
+	if (wr->buf_len[idx] + PCAP_REC_HDR_LEN + pkt_len > wr->buf_size) {
+		int ret;
+
+		pthread_mutex_lock(&wr->mutex);
+		ret = _pcapif_wr_switch(wr);
+		pthread_mutex_unlock(&wr->mutex);
+
+		if (ret)
+			return -1;
+
+		idx = wr->head % PCAP_WR_NUM_BUF;
+	}
+
+	if (wr->buf_len[idx] == 0)
+		wr->fill_start_ns = odp_time_global_ns();
+
+	hdr.ts_sec = tv->tv_sec;
+	hdr.ts_usec = tv->tv_usec;
+	hdr.caplen = pkt_len;
+	hdr.len = pkt_len;
+
+	ptr = wr->buf[idx] + wr->buf_len[idx];
+	memcpy(ptr, &hdr, PCAP_REC_HDR_LEN);
+
+	if (odp_packet_copy_to_mem(pkt, 0, pkt_len, ptr + PCAP_REC_HDR_LEN) != 0)
+		return -1;
+
+	wr->buf_len[idx] += PCAP_REC_HDR_LEN + pkt_len;
+
+	return 0;
+}
+
 static int pcapif_send_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			   const odp_packet_t pkts[], int num)
 {
 	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
 	int i;
+	int num_drop = 0;
 	uint8_t tx_ts_enabled = _odp_pktio_tx_ts_enabled(pktio_entry);
+	struct timeval tv;
 
 	odp_ticketlock_lock(&pktio_entry->txl);
 
+	if (pcap->wr)
+		(void)gettimeofday(&tv, NULL);
+
 	for (i = 0; i < num; ++i) {
 		uint32_t pkt_len = odp_packet_len(pkts[i]);
 
@@ -441,8 +1220,17 @@ static int pcapif_send_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 			break;
 		}
 
-		if (_pcapif_dump_pkt(pcap, pkts[i]) != 0)
+		if (pcap->wr) {
+			/* Packets that do not fit into write buffers are
+			 * dropped, data path never waits for the file writes */
+			if (odp_unlikely(_pcapif_buf_pkt(pcap->wr, pkts[i], &tv))) {
+				num_drop++;
+				odp_packet_free(pkts[i]);
+				continue;
+			}
+		} else if (_pcapif_dump_pkt(pcap, pkts[i]) != 0) {
 			break;
+		}
 
 		pktio_entry->stats.out_octets += pkt_len;
 
@@ -452,13 +1240,177 @@ static int pcapif_send_pkt(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 		odp_packet_free(pkts[i]);
 	}
 
-	pktio_entry->stats.out_packets += i;
+	pktio_entry->stats.out_packets += i - num_drop;
+	pktio_entry->stats.out_discards += num_drop;
 
 	odp_ticketlock_unlock(&pktio_entry->txl);
 
 	return i;
 }
 
+/* Hash of IP addresses and TCP/UDP ports */
+static uint32_t _pcapif_flow_hash(const uint8_t *data, uint32_t len)
+{
+	const _odp_ethhdr_t *eth = (const _odp_ethhdr_t *)(uintptr_t)data;
+	uint32_t tuple[9];
+	uint32_t tuple_len = 0;
+	uint32_t offset = _ODP_ETHHDR_LEN;
+	uint32_t l4_offset = 0;
+	uint16_t type;
+	uint8_t proto = 0;
+
+	if (len < _ODP_ETHHDR_LEN)
+		return 0;
+
+	type = odp_be_to_cpu_16(eth->type);
+
+	while ((type == _ODP_ETHTYPE_VLAN || type == _ODP_ETHTYPE_VLAN_OUTER) &&
+	       len >= offset + _ODP_VLANHDR_LEN) {
+		const _odp_vlanhdr_t *vlan = (const _odp_vlanhdr_t *)(uintptr_t)(data + offset);
+
+		type = odp_be_to_cpu_16(vlan->type);
+		offset += _ODP_VLANHDR_LEN;
+	}
+
+	if (type == _ODP_ETHTYPE_IPV4 && len >= offset + _ODP_IPV4HDR_LEN) {
+		const _odp_ipv4hdr_t *ip = (const _odp_ipv4hdr_t *)(uintptr_t)(data + offset);
+
+		memcpy(tuple, &ip->src_addr, 8);
+		tuple_len = 8;
+		proto = ip->proto;
+
+		if (!_ODP_IPV4HDR_IS_FRAGMENT(odp_be_to_cpu_16(ip->frag_offset)))
+			l4_offset = offset + _ODP_IPV4HDR_IHL(ip->ver_ihl) * 4;
+	} else if (type == _ODP_ETHTYPE_IPV6 && len >= offset + _ODP_IPV6HDR_LEN) {
+		const _odp_ipv6hdr_t *ip = (const _odp_ipv6hdr_t *)(uintptr_t)(data + offset);
+
+		memcpy(tuple, &ip->src_addr, 32);
+		tuple_len = 32;
+		proto = ip->next_hdr;
+		l4_offset = offset + _ODP_IPV6HDR_LEN;
+	}
+
+	/* Source and destination ports */
+	if (l4_offset && (proto == _ODP_IPPROTO_TCP || proto == _ODP_IPPROTO_UDP) &&
+	    len >= l4_offset + 4) {
+		memcpy((uint8_t *)tuple + tuple_len, data + l4_offset, 4);
+		tuple_len += 4;
+	}
+
+	if (tuple_len == 0)
+		return 0;
+
+	return odp_hash_crc32c(tuple, tuple_len, 0);
+}
+
+/* Input queue of a record */
+static uint32_t _pcapif_rec_queue(pkt_pcap_t *pcap, uint32_t i, uint32_t *rr)
+{
+	const pcap_rec_t *rec = &pcap->rec[i];
+	uint32_t num_rxq = pcap->rxq_conf.num_rxq;
+
+	if (num_rxq == 1)
+		return 0;
+
+	if (pcap->rxq_conf.hash_enable)
+		return _pcapif_flow_hash(rec->data, rec->len) % num_rxq;
+
+	return (*rr)++ % num_rxq;
+}
+
+/* Divide records between input queues */
+static int _pcapif_rxq_setup(pkt_pcap_t *pcap)
+{
+	uint32_t num[PCAP_MAX_QUEUES] = {0};
+	uint32_t num_rxq = pcap->num_rxq ? pcap->num_rxq : 1;
+	uint32_t i, q, off, rr;
+
+	free(pcap->rec_idx);
+	pcap->rec_idx = NULL;
+
+	pcap->rxq_conf.num_rxq = num_rxq;
+	pcap->rxq_conf.hash_enable = pcap->hash_enable;
+	pcap->rxq_conf.valid = true;
+
+	if (pcap->num_rec) {
+		pcap->rec_idx = malloc(pcap->num_rec * sizeof(uint32_t));
+		if (!pcap->rec_idx) {
+			_ODP_ERR("queue index alloc failed\n");
+			pcap->rxq_conf.valid = false;
+			return -1;
+		}
+	}
+
+	rr = 0;
+	for (i = 0; i < pcap->num_rec; i++)
+		num[_pcapif_rec_queue(pcap, i, &rr)]++;
+
+	off = 0;
+	for (q = 0; q < PCAP_MAX_QUEUES; q++) {
+		pcap_rxq_t *rxq = &pcap->rxq[q];
+
+		rxq->idx = pcap->rec_idx ? &pcap->rec_idx[off] : NULL;
+		rxq->num = 0;
+		rxq->pos = 0;
+		rxq->loop_cnt = 0;
+		off += num[q];
+	}
+
+	rr = 0;
+	for (i = 0; i < pcap->num_rec; i++) {
+		q = _pcapif_rec_queue(pcap, i, &rr);
+		pcap->rxq[q].idx[pcap->rxq[q].num++] = i;
+	}
+
+	return 0;
+}
+
+static int pcapif_start(pktio_entry_t *pktio_entry)
+{
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+	uint32_t num_rxq = pcap->num_rxq ? pcap->num_rxq : 1;
+	odp_time_t now;
+
+	if (!pcap->map)
+		return 0;
+
+	/* Queue setup is kept over stop/start, unless its parameters changed */
+	if (!pcap->rxq_conf.valid || pcap->rxq_conf.num_rxq != num_rxq ||
+	    pcap->rxq_conf.hash_enable != pcap->hash_enable) {
+		if (_pcapif_rxq_setup(pcap))
+			return -1;
+	}
+
+	now = odp_time_global();
+
+	for (uint32_t q = 0; q < num_rxq; q++) {
+		pcap_rxq_t *rxq = &pcap->rxq[q];
+
+		rxq->rate = pcap->rate / num_rxq;
+		if (pcap->rate && rxq->rate == 0)
+			rxq->rate = 1;
+
+		rxq->start = now;
+		rxq->num_paced = 0;
+		rxq->ts_base = 0;
+		if (rxq->pos < rxq->num)
+			rxq->ts_base = pcap->rec[rxq->idx[rxq->pos]].ts_ns;
+	}
+
+	return 0;
+}
+
+static int pcapif_input_queues_config(pktio_entry_t *pktio_entry,
+				      const odp_pktin_queue_param_t *param)
+{
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+
+	pcap->num_rxq = param->num_queues;
+	pcap->hash_enable = param->hash_enable;
+
+	return 0;
+}
+
 static uint32_t pcapif_mtu_get(pktio_entry_t *pktio_entry ODP_UNUSED)
 {
 	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
@@ -484,12 +1436,12 @@ static int pcapif_mac_addr_get(pktio_entry_t *pktio_entry ODP_UNUSED,
 	return _ODP_ETHADDR_LEN;
 }
 
-static int pcapif_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
+static int pcapif_capability(pktio_entry_t *pktio_entry,
 			     odp_pktio_capability_t *capa)
 {
 	memset(capa, 0, sizeof(odp_pktio_capability_t));
 
-	capa->max_input_queues  = 1;
+	capa->max_input_queues  = pkt_priv(pktio_entry)->mmap ? PCAP_MAX_QUEUES : 1;
 	capa->max_output_queues = 1;
 	capa->set_op.op.promisc_mode = 1;
 	capa->set_op.op.maxlen = 1;
@@ -516,6 +1468,8 @@ static int pcapif_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	capa->stats.pktio.counter.in_errors = 1;
 	capa->stats.pktio.counter.out_octets = 1;
 	capa->stats.pktio.counter.out_packets = 1;
+	capa->stats.pktio.counter.out_discards = 1;
+	capa->stats.pktio.counter.out_errors = 1;
 
 	return 0;
 }
@@ -527,14 +1481,37 @@ static int pcapif_promisc_mode_get(pktio_entry_t *pktio_entry)
 
 static int pcapif_stats_reset(pktio_entry_t *pktio_entry)
 {
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+
 	memset(&pktio_entry->stats, 0, sizeof(odp_pktio_stats_t));
+
+	for (int i = 0; i < PCAP_MAX_QUEUES; i++) {
+		pcap->rxq[i].in_octets = 0;
+		pcap->rxq[i].in_packets = 0;
+	}
+
+	if (pcap->wr)
+		odp_atomic_store_u64(&pcap->wr->write_errors, 0);
+
 	return 0;
 }
 
 static int pcapif_stats(pktio_entry_t *pktio_entry,
 			odp_pktio_stats_t *stats)
 {
+	pkt_pcap_t *pcap = pkt_priv(pktio_entry);
+
 	memcpy(stats, &pktio_entry->stats, sizeof(odp_pktio_stats_t));
+
+	for (int i = 0; i < PCAP_MAX_QUEUES; i++) {
+		stats->in_octets += pcap->rxq[i].in_octets;
+		stats->in_packets += pcap->rxq[i].in_packets;
+	}
+
+	/* Failed buffer writes */
+	if (pcap->wr)
+		stats->out_errors += odp_atomic_load_u64(&pcap->wr->write_errors);
+
 	return 0;
 }
 
@@ -571,9 +1548,10 @@ const pktio_if_ops_t _odp_pcap_pktio_ops = {
 	.init_local = NULL,
 	.open = pcapif_init,
 	.close = pcapif_close,
+	.start = pcapif_start,
 	.stats = pcapif_stats,
 	.stats_reset = pcapif_stats_reset,
-	.recv = pcapif_recv_pkt,
+	.recv = pcapif_recv,
 	.send = pcapif_send_pkt,
 	.maxlen_get = pcapif_mtu_get,
 	.maxlen_set = pcapif_mtu_set,
@@ -586,7 +1564,7 @@ const pktio_if_ops_t _odp_pcap_pktio_ops = {
 	.pktio_ts_from_ns = NULL,
 	.pktio_time = NULL,
 	.config = NULL,
-	.input_queues_config = NULL,
+	.input_queues_config = pcapif_input_queues_config,
 	.output_queues_config = NULL,
 	.link_status = pcapif_link_status,
 	.link_info = pcapif_link_info
@@ -11,9 +11,12 @@
 #include <odp/api/hints.h>
 #include <odp/api/packet.h>
 #include <odp/api/packet_io.h>
+#include <odp/api/sync.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/time.h>
 
 #include <odp/api/plat/packet_inlines.h>
+#include <odp/api/plat/time_inlines.h>
 
 #include <odp_socket_common.h>
 #include <odp_parse_internal.h>
@@ -24,6 +27,7 @@
 #include <odp_classification_datamodel.h>
 #include <odp_classification_internal.h>
 #include <odp_global_data.h>
+#include <odp_libconfig_internal.h>
 #include <odp_macros_internal.h>
 
 #include <protocols/eth.h>
@@ -42,9 +46,10 @@
 #include <sys/ioctl.h>
 #include <errno.h>
 #include <time.h>
+#include <linux/filter.h>
 #include <linux/if_packet.h>
 
-/* VLAN flags in tpacket2_hdr status */
+/* VLAN flags in tpacket3_hdr status */
 #ifdef TP_STATUS_VLAN_TPID_VALID
 #define VLAN_VALID (TP_STATUS_VLAN_VALID | TP_STATUS_VLAN_TPID_VALID)
 #else
@@ -55,6 +60,25 @@
 #define FRAME_MEM_SIZE (4 * 1024 * 1024)
 #define BLOCK_SIZE     (4 * 1024)
 
+/* Minimum block size of a TPACKET_V3 Rx ring */
+#define RX_BLOCK_SIZE   (64 * 1024)
+/* Timeout (in msec) after which kernel retires a partially filled Rx block */
+#define RX_BLOCK_TMO_MS 1
+
+/* Maximum number of input and output queues. Each queue has its own socket
+ * and ring. */
+#define MAX_RX_QUEUES 16
+#define MAX_TX_QUEUES 16
+
+#define CONF_BASE_STR      "pktio_socket_mmap"
+#define FANOUT_MODE_STR    "fanout_mode"
+#define QDISC_BYPASS_STR   "qdisc_bypass"
+#define TX_BATCH_STR       "tx_batch"
+#define TX_BATCH_TMO_STR   "tx_batch_tmo_nsec"
+
+ODP_STATIC_ASSERT(MAX_RX_QUEUES <= ODP_PKTIN_MAX_QUEUES, "MAX_RX_QUEUES too large");
+ODP_STATIC_ASSERT(MAX_TX_QUEUES <= ODP_PKTOUT_MAX_QUEUES, "MAX_TX_QUEUES too large");
+
 /** packet mmap ring */
 struct ring {
 	odp_ticketlock_t lock;
@@ -70,27 +94,50 @@ struct ring {
 	size_t mm_len;
 	size_t rd_len;
 	int flen;
+	/* Frames passed to the ring, but not yet notified to kernel */
+	uint32_t pending;
+	/* Global time (nsec) of the oldest pending frame, 0 when none */
+	odp_atomic_u64_t pending_ts;
 
 	struct tpacket_req req;
-};
+} ODP_ALIGNED_CACHE;
 
 ODP_STATIC_ASSERT(offsetof(struct ring, mm_space) <= ODP_CACHE_LINE_SIZE,
 		  "ERR_STRUCT_RING");
 
+/** TPACKET_V3 packet mmap ring for Rx */
+struct rx_ring {
+	odp_ticketlock_t lock;
+	int sock;
+	/* Current block and number of packets left in it */
+	uint32_t block_idx;
+	uint32_t pkts_left;
+	/* Next packet of the current block */
+	struct tpacket3_hdr *pkt;
+	uint8_t *mm_space;
+	size_t mm_len;
+
+	struct tpacket_req3 req;
+} ODP_ALIGNED_CACHE;
+
 /** Packet socket using mmap rings for both Rx and Tx */
 typedef struct {
-	/** Packet mmap ring for Rx */
-	struct ring rx_ring ODP_ALIGNED_CACHE;
-	/** Packet mmap ring for Tx */
-	struct ring tx_ring ODP_ALIGNED_CACHE;
+	/** Packet mmap rings for Rx, one socket per input queue */
+	struct rx_ring rx_ring[MAX_RX_QUEUES];
+	/** Packet mmap rings for Tx, one socket per output queue */
+	struct ring tx_ring[MAX_TX_QUEUES];
 
+	/** Socket for interface control, does not receive packets */
 	int sockfd ODP_ALIGNED_CACHE;
+	/** Number of open Rx and Tx sockets */
+	uint32_t num_rx;
+	uint32_t num_tx;
+	odp_bool_t lockless_rx;
+	odp_bool_t lockless_tx;
 	odp_pool_t pool;
 	int mtu; /**< maximum transmission unit */
 	uint32_t mtu_max; /**< maximum supported MTU value */
 	size_t frame_offset; /**< frame start offset from start of pkt buf */
-	uint8_t *mmap_base;
-	unsigned int mmap_len;
 	unsigned char if_mac[ETH_ALEN];
 	struct sockaddr_ll ll;
 } pkt_sock_mmap_t;
@@ -104,11 +151,13 @@ static inline pkt_sock_mmap_t *pkt_priv(pktio_entry_t *pktio_entry)
 }
 
 static int disable_pktio; /** !0 this pktio disabled, 0 enabled */
+static int fanout_mode; /** PACKET_FANOUT_* mode used with multiple input queues */
+static int qdisc_bypass; /** !0 Tx sockets bypass qdisc layer */
+static uint32_t tx_batch; /** Tx frames buffered before kernel is notified */
+static uint64_t tx_batch_tmo; /** Max time (nsec) Tx frames stay pending */
 
-static int mmap_pkt_socket(void)
+static int mmap_pkt_socket(int ver)
 {
-	int ver = TPACKET_V2;
-
 	int ret, sock = socket(PF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
 
 	if (sock == -1) {
@@ -131,15 +180,66 @@ static inline unsigned next_frame(unsigned cur_frame, unsigned frame_count)
 	return odp_unlikely(cur_frame + 1 >= frame_count) ? 0 : cur_frame + 1;
 }
 
-static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
+static inline struct tpacket_block_desc *rx_block_desc(struct rx_ring *ring,
+							  uint32_t idx)
+{
+	return (struct tpacket_block_desc *)(uintptr_t)
+		(ring->mm_space + (size_t)idx * ring->req.tp_block_size);
+}
+
+static inline void rx_block_release(struct rx_ring *ring)
+{
+	struct tpacket_block_desc *bd = rx_block_desc(ring, ring->block_idx);
+
+	/* Packet data must not be accessed after the block is returned */
+	odp_mb_release();
+	bd->hdr.bh1.block_status = TP_STATUS_KERNEL;
+	ring->block_idx = next_frame(ring->block_idx, ring->req.tp_block_nr);
+}
+
+/* Start consuming the next block, if kernel has passed it to user space */
+static inline int rx_block_get(struct rx_ring *ring)
+{
+	struct tpacket_block_desc *bd = rx_block_desc(ring, ring->block_idx);
+
+	if (!(bd->hdr.bh1.block_status & TP_STATUS_USER))
+		return 0;
+
+	odp_mb_acquire();
+
+	ring->pkts_left = bd->hdr.bh1.num_pkts;
+	if (odp_unlikely(ring->pkts_left == 0)) {
+		rx_block_release(ring);
+		return 0;
+	}
+
+	ring->pkt = (struct tpacket3_hdr *)(uintptr_t)
+		((uint8_t *)bd + bd->hdr.bh1.offset_to_first_pkt);
+
+	return 1;
+}
+
+/* Move to the next packet. Block is returned to kernel after its last packet. */
+static inline void rx_pkt_next(struct rx_ring *ring)
+{
+	if (--ring->pkts_left) {
+		ring->pkt = (struct tpacket3_hdr *)(uintptr_t)
+			((uint8_t *)ring->pkt + ring->pkt->tp_next_offset);
+		return;
+	}
+
+	rx_block_release(ring);
+}
+
+static inline unsigned pkt_mmap_v3_rx(pktio_entry_t *pktio_entry,
 				      pkt_sock_mmap_t *pkt_sock,
+				      struct rx_ring *ring,
 				      odp_packet_t pkt_table[], unsigned num,
 				      unsigned char if_mac[])
 {
 	odp_time_t ts_val;
 	odp_time_t *ts = NULL;
-	unsigned int frame_num, next_frame_num;
-	uint8_t *pkt_buf, *next_ptr;
+	uint8_t *pkt_buf;
 	int pkt_len;
 	uint32_t alloc_len;
 	struct ethhdr *eth_hdr;
@@ -147,35 +247,32 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 	unsigned int nb_rx = 0;
 	unsigned int nb_cls = 0;
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
-	struct ring *ring;
 	odp_pool_t pool = pkt_sock->pool;
 	uint16_t frame_offset = pktio_entry->pktin_frame_offset;
-	uint16_t vlan_len = 0;
+	uint16_t vlan_len;
 	const odp_proto_layer_t layer = pktio_entry->parse_layer;
 	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
 
 	if (opt.bit.ts_all || opt.bit.ts_ptp)
 		ts = &ts_val;
 
-	ring  = &pkt_sock->rx_ring;
-	frame_num = ring->frame_num;
-	next_ptr = ring->rd[frame_num].iov_base;
-
 	for (i = 0; i < num; i++) {
-		struct tpacket2_hdr *tp_hdr;
+		struct tpacket3_hdr *tp_hdr;
 		odp_packet_t pkt;
 		odp_packet_hdr_t *hdr;
 		int ret;
 
-		tp_hdr = (void *)next_ptr;
-
-		if (tp_hdr->tp_status == TP_STATUS_KERNEL)
+		if (ring->pkts_left == 0 && !rx_block_get(ring))
 			break;
 
-		next_frame_num = next_frame(frame_num, ring->rd_num);
-		next_ptr = ring->rd[next_frame_num].iov_base;
-		odp_prefetch(next_ptr);
-		odp_prefetch(next_ptr + ODP_CACHE_LINE_SIZE);
+		tp_hdr = ring->pkt;
+
+		if (ring->pkts_left > 1) {
+			uint8_t *next_ptr = (uint8_t *)tp_hdr + tp_hdr->tp_next_offset;
+
+			odp_prefetch(next_ptr);
+			odp_prefetch(next_ptr + ODP_CACHE_LINE_SIZE);
+		}
 
 		if (ts != NULL)
 			ts_val = odp_time_global();
@@ -184,13 +281,13 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		pkt_len = tp_hdr->tp_snaplen;
 
 		if (odp_unlikely(pkt_len > pkt_sock->mtu)) {
-			tp_hdr->tp_status = TP_STATUS_KERNEL;
-			frame_num = next_frame_num;
+			rx_pkt_next(ring);
 			_ODP_DBG("dropped oversized packet\n");
 			continue;
 		}
 
 		/* Check if packet had a VLAN header */
+		vlan_len = 0;
 		if ((tp_hdr->tp_status & VLAN_VALID) == VLAN_VALID)
 			vlan_len = 4;
 
@@ -199,7 +296,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 
 		if (odp_unlikely(ret != 1)) {
 			/* Stop receiving packets when pool is empty. Leave
-			 * the current frame into the ring. */
+			 * the current packet into the ring. */
 			break;
 		}
 
@@ -208,8 +305,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		if (odp_unlikely(ethaddrs_equal(if_mac,
 						eth_hdr->h_source))) {
 			odp_packet_free(pkt);
-			tp_hdr->tp_status = TP_STATUS_KERNEL;
-			frame_num = next_frame_num;
+			rx_pkt_next(ring);
 			continue;
 		}
 
@@ -224,8 +320,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		ret = odp_packet_copy_from_mem(pkt, 0, pkt_len, pkt_buf);
 		if (ret != 0) {
 			odp_packet_free(pkt);
-			tp_hdr->tp_status = TP_STATUS_KERNEL;
-			frame_num = next_frame_num;
+			rx_pkt_next(ring);
 			continue;
 		}
 
@@ -243,7 +338,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 				(mac + 2 * _ODP_ETHADDR_LEN);
 
 			#ifdef TP_STATUS_VLAN_TPID_VALID
-			*type = odp_cpu_to_be_16(tp_hdr->tp_vlan_tpid);
+			*type = odp_cpu_to_be_16(tp_hdr->hv1.tp_vlan_tpid);
 			#else
 			/* Fallback for old kernels (< v3.14) */
 			uint16_t *type2;
@@ -262,7 +357,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 			#endif
 
 			tci   = type + 1;
-			*tci  = odp_cpu_to_be_16(tp_hdr->tp_vlan_tci);
+			*tci  = odp_cpu_to_be_16(tp_hdr->hv1.tp_vlan_tci);
 		}
 
 		if (layer) {
@@ -273,8 +368,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 
 			if (ret < 0) {
 				odp_packet_free(pkt);
-				tp_hdr->tp_status = TP_STATUS_KERNEL;
-				frame_num = next_frame_num;
+				rx_pkt_next(ring);
 				continue;
 			}
 
@@ -288,16 +382,14 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 
 				if (ret) {
 					odp_packet_free(pkt);
-					tp_hdr->tp_status = TP_STATUS_KERNEL;
-					frame_num = next_frame_num;
+					rx_pkt_next(ring);
 					continue;
 				}
 
 				if (odp_unlikely(_odp_pktio_packet_to_pool(
 					    &pkt, &hdr, new_pool))) {
 					odp_packet_free(pkt);
-					tp_hdr->tp_status = TP_STATUS_KERNEL;
-					frame_num = next_frame_num;
+					rx_pkt_next(ring);
 					odp_atomic_inc_u64(&pktio_entry->stats_extra.in_discards);
 					continue;
 				}
@@ -307,8 +399,7 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 		hdr->input = pktio_entry->handle;
 		packet_set_ts(hdr, ts);
 
-		tp_hdr->tp_status = TP_STATUS_KERNEL;
-		frame_num = next_frame_num;
+		rx_pkt_next(ring);
 
 		if (cls_enabled) {
 			/* Enqueue packets directly to classifier destination queue */
@@ -323,16 +414,15 @@ static inline unsigned pkt_mmap_v2_rx(pktio_entry_t *pktio_entry,
 	if (odp_unlikely(nb_cls))
 		_odp_cls_enq(pkt_table, nb_cls, true);
 
-	ring->frame_num = frame_num;
-
 	return nb_rx;
 }
 
-static inline int pkt_mmap_v2_tx(pktio_entry_t *pktio_entry, int sock,
-				 struct ring *ring,
+static inline int pkt_mmap_v2_tx(pktio_entry_t *pktio_entry, struct ring *ring,
 				 const odp_packet_t pkt_table[], uint32_t num)
 {
 	uint32_t i, pkt_len, num_tx, tp_status;
+	const uint32_t num_req = num;
+	int sock = ring->sock;
 	uint32_t first_frame_num, frame_num, next_frame_num, frame_count;
 	int ret;
 	uint8_t *buf;
@@ -388,10 +478,44 @@ static inline int pkt_mmap_v2_tx(pktio_entry_t *pktio_entry, int sock,
 	num    = i;
 	num_tx = num;
 
-	/* Ping kernel to send packets */
+	if (tx_batch > 1 && !tx_ts_enabled) {
+		/* Packets are accepted when copied into the ring. Kernel is
+		 * notified when enough frames are pending or the ring is full.
+		 * Frames that kernel could not send yet are retried on the
+		 * next notification. */
+		uint64_t now = odp_time_global_ns();
+		uint64_t first = 0;
+
+		ring->frame_num = frame_num;
+		ring->pending += num;
+
+		/* Timestamp is set only after the frames are in the ring, so that
+		 * a concurrent flush that clears it has notified kernel about
+		 * them. On failure, 'first' is the timestamp of older frames. */
+		if (num)
+			(void)odp_atomic_cas_rel_u64(&ring->pending_ts, &first, now);
+		else
+			first = odp_atomic_load_u64(&ring->pending_ts);
+
+		if (ring->pending >= tx_batch || num < num_req ||
+		    (first && now - first >= tx_batch_tmo)) {
+			ret = send(sock, NULL, 0, MSG_DONTWAIT);
+			if (odp_unlikely(ret < 0 && errno != EWOULDBLOCK))
+				_ODP_ERR("Socket mmap: send failed, ret %i, errno %i\n",
+					 ret, errno);
+			ring->pending = 0;
+			odp_atomic_store_u64(&ring->pending_ts, 0);
+		}
+
+		odp_packet_free_multi(pkt_table, num);
+		return num;
+	}
+
+	/* Ping kernel to send packets (including any pending ones) */
 	ret = send(sock, NULL, 0, MSG_DONTWAIT);
 
 	ring->frame_num = frame_num;
+	ring->pending = 0;
 
 	if (odp_unlikely(ret != total_len)) {
 		uint32_t frame_sum;
@@ -446,11 +570,10 @@ static int mmap_setup_ring(pkt_sock_mmap_t *pkt_sock, struct ring *ring,
 	uint32_t block_size, block_nr, frame_size, frame_nr;
 	uint32_t ring_size;
 	int flags;
-	int sock = pkt_sock->sockfd;
+	int sock = ring->sock;
 	int mtu = pkt_sock->mtu_max;
 	int ret = 0;
 
-	ring->sock = sock;
 	ring->type = type;
 	ring->version = TPACKET_V2;
 
@@ -505,64 +628,32 @@ static int mmap_setup_ring(pkt_sock_mmap_t *pkt_sock, struct ring *ring,
 	return 0;
 }
 
-static int mmap_sock(pkt_sock_mmap_t *pkt_sock)
+static int mmap_sock(struct ring *ring)
 {
 	int i;
-	int sock = pkt_sock->sockfd;
 
-	/* map rx + tx buffer to userspace : they are in this order */
-	pkt_sock->mmap_len =
-		pkt_sock->rx_ring.req.tp_block_size *
-		pkt_sock->rx_ring.req.tp_block_nr +
-		pkt_sock->tx_ring.req.tp_block_size *
-		pkt_sock->tx_ring.req.tp_block_nr;
+	/* map tx buffer to userspace */
+	ring->mm_len = ring->req.tp_block_size * ring->req.tp_block_nr;
 
-	pkt_sock->mmap_base =
-		mmap(NULL, pkt_sock->mmap_len, PROT_READ | PROT_WRITE,
-		     MAP_SHARED | MAP_LOCKED | MAP_POPULATE, sock, 0);
+	ring->mm_space =
+		mmap(NULL, ring->mm_len, PROT_READ | PROT_WRITE,
+		     MAP_SHARED | MAP_LOCKED | MAP_POPULATE, ring->sock, 0);
 
-	if (pkt_sock->mmap_base == MAP_FAILED) {
-		_ODP_ERR("mmap rx&tx buffer failed: %s\n", strerror(errno));
+	if (ring->mm_space == MAP_FAILED) {
+		_ODP_ERR("mmap tx buffer failed: %s\n", strerror(errno));
+		ring->mm_space = NULL;
 		return -1;
 	}
 
-	pkt_sock->rx_ring.mm_space = pkt_sock->mmap_base;
-	memset(pkt_sock->rx_ring.rd, 0, pkt_sock->rx_ring.rd_len);
-	for (i = 0; i < pkt_sock->rx_ring.rd_num; ++i) {
-		pkt_sock->rx_ring.rd[i].iov_base =
-			pkt_sock->rx_ring.mm_space
-			+ (i * pkt_sock->rx_ring.flen);
-		pkt_sock->rx_ring.rd[i].iov_len = pkt_sock->rx_ring.flen;
-	}
-
-	pkt_sock->tx_ring.mm_space =
-		pkt_sock->mmap_base + pkt_sock->rx_ring.mm_len;
-	memset(pkt_sock->tx_ring.rd, 0, pkt_sock->tx_ring.rd_len);
-	for (i = 0; i < pkt_sock->tx_ring.rd_num; ++i) {
-		pkt_sock->tx_ring.rd[i].iov_base =
-			pkt_sock->tx_ring.mm_space
-			+ (i * pkt_sock->tx_ring.flen);
-		pkt_sock->tx_ring.rd[i].iov_len = pkt_sock->tx_ring.flen;
+	memset(ring->rd, 0, ring->rd_len);
+	for (i = 0; i < ring->rd_num; ++i) {
+		ring->rd[i].iov_base = ring->mm_space + (i * ring->flen);
+		ring->rd[i].iov_len = ring->flen;
 	}
 
 	return 0;
 }
 
-static int mmap_unmap_sock(pkt_sock_mmap_t *pkt_sock)
-{
-	int ret = 0;
-
-	if (pkt_sock->rx_ring.shm != ODP_SHM_INVALID)
-		odp_shm_free(pkt_sock->rx_ring.shm);
-	if (pkt_sock->tx_ring.shm != ODP_SHM_INVALID)
-		odp_shm_free(pkt_sock->tx_ring.shm);
-
-	if (pkt_sock->mmap_base != MAP_FAILED)
-		ret = munmap(pkt_sock->mmap_base, pkt_sock->mmap_len);
-
-	return ret;
-}
-
 static int mmap_bind_sock(pkt_sock_mmap_t *pkt_sock, const char *netdev)
 {
 	int ret;
@@ -584,17 +675,299 @@ static int mmap_bind_sock(pkt_sock_mmap_t *pkt_sock, const char *netdev)
 	return 0;
 }
 
-static int sock_mmap_close(pktio_entry_t *entry)
+/* Attach a filter which drops all packets. Packets are received only through
+ * the per queue Rx sockets. */
+static int mmap_drop_all(int sock)
 {
-	pkt_sock_mmap_t *const pkt_sock = pkt_priv(entry);
-	int ret;
+	struct sock_filter code[] = { BPF_STMT(BPF_RET | BPF_K, 0) };
+	struct sock_fprog prog = { .len = _ODP_ARRAY_SIZE(code), .filter = code };
 
-	ret = mmap_unmap_sock(pkt_sock);
-	if (ret != 0) {
-		_ODP_ERR("mmap_unmap_sock() %s\n", strerror(errno));
+	if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == -1) {
+		_ODP_ERR("setsockopt(SO_ATTACH_FILTER): %s\n", strerror(errno));
 		return -1;
 	}
 
+	return 0;
+}
+
+static int mmap_setup_rx_ring(pkt_sock_mmap_t *pkt_sock, struct rx_ring *ring)
+{
+	uint32_t block_size, frame_size;
+	int mtu = pkt_sock->mtu_max;
+
+	frame_size = _ODP_ROUNDUP_POWER2_U32(mtu + TPACKET3_HDRLEN + TPACKET_ALIGNMENT);
+	block_size = RX_BLOCK_SIZE;
+	if (frame_size > block_size)
+		block_size = frame_size;
+
+	memset(&ring->req, 0, sizeof(ring->req));
+	ring->req.tp_block_size = block_size;
+	ring->req.tp_block_nr   = FRAME_MEM_SIZE / block_size;
+	ring->req.tp_frame_size = frame_size;
+	ring->req.tp_frame_nr   = (block_size / frame_size) * ring->req.tp_block_nr;
+	ring->req.tp_retire_blk_tov = RX_BLOCK_TMO_MS;
+
+	_ODP_DBG("  tp_block_size %u\n", ring->req.tp_block_size);
+	_ODP_DBG("  tp_block_nr   %u\n", ring->req.tp_block_nr);
+	_ODP_DBG("  tp_frame_size %u\n", ring->req.tp_frame_size);
+	_ODP_DBG("  tp_frame_nr   %u\n", ring->req.tp_frame_nr);
+
+	if (setsockopt(ring->sock, SOL_PACKET, PACKET_RX_RING, &ring->req,
+		       sizeof(ring->req)) == -1) {
+		_ODP_ERR("setsockopt(pkt mmap): %s\n", strerror(errno));
+		return -1;
+	}
+
+	ring->mm_len = (size_t)block_size * ring->req.tp_block_nr;
+	ring->mm_space = mmap(NULL, ring->mm_len, PROT_READ | PROT_WRITE,
+			      MAP_SHARED | MAP_LOCKED | MAP_POPULATE, ring->sock, 0);
+
+	if (ring->mm_space == MAP_FAILED) {
+		_ODP_ERR("mmap rx buffer failed: %s\n", strerror(errno));
+		ring->mm_space = NULL;
+		return -1;
+	}
+
+	ring->block_idx = 0;
+	ring->pkts_left = 0;
+	ring->pkt = NULL;
+
+	return 0;
+}
+
+static int mmap_fanout_join(int sock, int *fanout_id)
+{
+	int val;
+	int type = fanout_mode;
+	socklen_t len = sizeof(val);
+
+	if (fanout_mode == PACKET_FANOUT_HASH)
+		type |= PACKET_FANOUT_FLAG_DEFRAG;
+
+#ifdef PACKET_FANOUT_FLAG_UNIQUEID
+	/* Kernel selects an unused group ID for the first group member */
+	if (*fanout_id < 0) {
+		val = (type | PACKET_FANOUT_FLAG_UNIQUEID) << 16;
+
+		if (setsockopt(sock, SOL_PACKET, PACKET_FANOUT, &val, sizeof(val)) == -1 ||
+		    getsockopt(sock, SOL_PACKET, PACKET_FANOUT, &val, &len) == -1) {
+			_ODP_ERR("PACKET_FANOUT create: %s\n", strerror(errno));
+			return -1;
+		}
+
+		*fanout_id = val & 0xffff;
+		return 0;
+	}
+#else
+	(void)len;
+#endif
+
+	val = (*fanout_id & 0xffff) | (type << 16);
+
+	if (setsockopt(sock, SOL_PACKET, PACKET_FANOUT, &val, sizeof(val)) == -1) {
+		_ODP_ERR("PACKET_FANOUT join: %s\n", strerror(errno));
+		return -1;
+	}
+
+	return 0;
+}
+
+static void mmap_tx_close(pkt_sock_mmap_t *pkt_sock)
+{
+	for (uint32_t i = 0; i < pkt_sock->num_tx; i++) {
+		struct ring *ring = &pkt_sock->tx_ring[i];
+
+		if (ring->shm != ODP_SHM_INVALID)
+			odp_shm_free(ring->shm);
+
+		if (ring->mm_space && munmap(ring->mm_space, ring->mm_len) != 0)
+			_ODP_ERR("munmap(tx ring %u): %s\n", i, strerror(errno));
+
+		if (ring->sock != -1 && close(ring->sock) != 0)
+			_ODP_ERR("close(tx sock %u): %s\n", i, strerror(errno));
+
+		ring->shm = ODP_SHM_INVALID;
+		ring->mm_space = NULL;
+		ring->sock = -1;
+	}
+
+	pkt_sock->num_tx = 0;
+}
+
+/* Open a TPACKET_V2 socket with a Tx ring per output queue */
+static int mmap_tx_open(pktio_entry_t *pktio_entry, uint32_t num_tx)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+
+	for (uint32_t i = 0; i < num_tx; i++) {
+		struct ring *ring = &pkt_sock->tx_ring[i];
+
+		ring->shm = ODP_SHM_INVALID;
+		ring->mm_space = NULL;
+		ring->frame_num = 0;
+		ring->pending = 0;
+		odp_atomic_store_u64(&ring->pending_ts, 0);
+		pkt_sock->num_tx = i + 1;
+
+		_ODP_DBG("TX ring %u setup:\n", i);
+
+		ring->sock = mmap_pkt_socket(TPACKET_V2);
+		if (ring->sock == -1)
+			goto error;
+
+		if (mmap_drop_all(ring->sock))
+			goto error;
+
+#ifdef PACKET_QDISC_BYPASS
+		if (qdisc_bypass) {
+			int val = 1;
+
+			if (setsockopt(ring->sock, SOL_PACKET, PACKET_QDISC_BYPASS, &val,
+				       sizeof(val)) == -1) {
+				_ODP_ERR("setsockopt(PACKET_QDISC_BYPASS): %s\n",
+					 strerror(errno));
+				goto error;
+			}
+		}
+#endif
+
+		if (mmap_setup_ring(pkt_sock, ring, PACKET_TX_RING))
+			goto error;
+
+		if (mmap_sock(ring))
+			goto error;
+
+		if (bind(ring->sock, (struct sockaddr *)&pkt_sock->ll,
+			 sizeof(pkt_sock->ll)) == -1) {
+			_ODP_ERR("bind(to IF): %s\n", strerror(errno));
+			goto error;
+		}
+	}
+
+	return 0;
+
+error:
+	mmap_tx_close(pkt_sock);
+	return -1;
+}
+
+static void mmap_rx_close(pkt_sock_mmap_t *pkt_sock)
+{
+	for (uint32_t i = 0; i < pkt_sock->num_rx; i++) {
+		struct rx_ring *ring = &pkt_sock->rx_ring[i];
+
+		if (ring->mm_space && munmap(ring->mm_space, ring->mm_len) != 0)
+			_ODP_ERR("munmap(rx ring %u): %s\n", i, strerror(errno));
+
+		if (ring->sock != -1 && close(ring->sock) != 0)
+			_ODP_ERR("close(rx sock %u): %s\n", i, strerror(errno));
+
+		ring->mm_space = NULL;
+		ring->sock = -1;
+	}
+
+	pkt_sock->num_rx = 0;
+}
+
+/* Open a TPACKET_V3 socket per input queue. With multiple queues, sockets are
+ * joined into a fanout group, which spreads received packets between them. */
+static int mmap_rx_open(pktio_entry_t *pktio_entry, uint32_t num_rx)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+	int fanout_id = -1;
+
+#ifndef PACKET_FANOUT_FLAG_UNIQUEID
+	fanout_id = (getpid() + odp_pktio_index(pktio_entry->handle)) & 0xffff;
+#endif
+
+	for (uint32_t i = 0; i < num_rx; i++) {
+		struct rx_ring *ring = &pkt_sock->rx_ring[i];
+
+		ring->mm_space = NULL;
+		pkt_sock->num_rx = i + 1;
+
+		_ODP_DBG("RX ring %u setup:\n", i);
+
+		ring->sock = mmap_pkt_socket(TPACKET_V3);
+		if (ring->sock == -1)
+			goto error;
+
+		if (mmap_setup_rx_ring(pkt_sock, ring))
+			goto error;
+
+		if (bind(ring->sock, (struct sockaddr *)&pkt_sock->ll,
+			 sizeof(pkt_sock->ll)) == -1) {
+			_ODP_ERR("bind(to IF): %s\n", strerror(errno));
+			goto error;
+		}
+
+		if (num_rx > 1 && mmap_fanout_join(ring->sock, &fanout_id))
+			goto error;
+	}
+
+	return 0;
+
+error:
+	mmap_rx_close(pkt_sock);
+	return -1;
+}
+
+static int sock_mmap_start(pktio_entry_t *pktio_entry)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+	uint32_t num_rx = 0;
+	uint32_t num_tx = 0;
+
+	if (pktio_entry->param.in_mode != ODP_PKTIN_MODE_DISABLED)
+		num_rx = pktio_entry->num_in_queue ? pktio_entry->num_in_queue : 1;
+
+	if (pktio_entry->param.out_mode != ODP_PKTOUT_MODE_DISABLED)
+		num_tx = pktio_entry->num_out_queue ? pktio_entry->num_out_queue : 1;
+
+	/* Sockets are kept open over stop/start, unless the number of queues
+	 * has been changed. */
+	if (num_rx != pkt_sock->num_rx) {
+		mmap_rx_close(pkt_sock);
+		if (mmap_rx_open(pktio_entry, num_rx))
+			return -1;
+	}
+
+	if (num_tx != pkt_sock->num_tx) {
+		mmap_tx_close(pkt_sock);
+		if (mmap_tx_open(pktio_entry, num_tx))
+			return -1;
+	}
+
+	return 0;
+}
+
+static int sock_mmap_stop(pktio_entry_t *pktio_entry)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+
+	/* Notify kernel about frames still pending in Tx rings */
+	for (uint32_t i = 0; i < pkt_sock->num_tx; i++) {
+		struct ring *ring = &pkt_sock->tx_ring[i];
+
+		odp_ticketlock_lock(&ring->lock);
+		if (ring->pending) {
+			(void)send(ring->sock, NULL, 0, MSG_DONTWAIT);
+			ring->pending = 0;
+			odp_atomic_store_u64(&ring->pending_ts, 0);
+		}
+		odp_ticketlock_unlock(&ring->lock);
+	}
+
+	return 0;
+}
+
+static int sock_mmap_close(pktio_entry_t *entry)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(entry);
+
+	mmap_rx_close(pkt_sock);
+	mmap_tx_close(pkt_sock);
+
 	if (pkt_sock->sockfd != -1 && close(pkt_sock->sockfd) != 0) {
 		_ODP_ERR("close(sockfd): %s\n", strerror(errno));
 		return -1;
@@ -619,7 +992,6 @@ static int sock_mmap_open(odp_pktio_t id ODP_UNUSED,
 	memset(pkt_sock, 0, sizeof(*pkt_sock));
 	/* set sockfd to -1, because a valid socked might be initialized to 0 */
 	pkt_sock->sockfd = -1;
-	pkt_sock->mmap_base = MAP_FAILED;
 
 	if (pool == ODP_POOL_INVALID)
 		return -1;
@@ -628,14 +1000,23 @@ static int sock_mmap_open(odp_pktio_t id ODP_UNUSED,
 	pkt_sock->frame_offset = 0;
 
 	pkt_sock->pool = pool;
-	odp_ticketlock_init(&pkt_sock->rx_ring.lock);
-	odp_ticketlock_init(&pkt_sock->tx_ring.lock);
-	pkt_sock->rx_ring.shm = ODP_SHM_INVALID;
-	pkt_sock->tx_ring.shm = ODP_SHM_INVALID;
-	pkt_sock->sockfd = mmap_pkt_socket();
+	for (int i = 0; i < MAX_RX_QUEUES; i++) {
+		odp_ticketlock_init(&pkt_sock->rx_ring[i].lock);
+		pkt_sock->rx_ring[i].sock = -1;
+	}
+	for (int i = 0; i < MAX_TX_QUEUES; i++) {
+		odp_ticketlock_init(&pkt_sock->tx_ring[i].lock);
+		pkt_sock->tx_ring[i].sock = -1;
+		odp_atomic_init_u64(&pkt_sock->tx_ring[i].pending_ts, 0);
+	}
+	pkt_sock->sockfd = mmap_pkt_socket(TPACKET_V2);
 	if (pkt_sock->sockfd == -1)
 		goto error;
 
+	ret = mmap_drop_all(pkt_sock->sockfd);
+	if (ret != 0)
+		goto error;
+
 	ret = mmap_bind_sock(pkt_sock, netdev);
 	if (ret != 0)
 		goto error;
@@ -649,20 +1030,6 @@ static int sock_mmap_open(odp_pktio_t id ODP_UNUSED,
 
 	_ODP_DBG("MTU size: %i\n", pkt_sock->mtu);
 
-	_ODP_DBG("TX ring setup:\n");
-	ret = mmap_setup_ring(pkt_sock, &pkt_sock->tx_ring, PACKET_TX_RING);
-	if (ret != 0)
-		goto error;
-
-	_ODP_DBG("RX ring setup:\n");
-	ret = mmap_setup_ring(pkt_sock, &pkt_sock->rx_ring, PACKET_RX_RING);
-	if (ret != 0)
-		goto error;
-
-	ret = mmap_sock(pkt_sock);
-	if (ret != 0)
-		goto error;
-
 	ret = _odp_mac_addr_get_fd(pkt_sock->sockfd, netdev, pkt_sock->if_mac);
 	if (ret != 0)
 		goto error;
@@ -690,30 +1057,66 @@ error:
 	return -1;
 }
 
-static int sock_mmap_fd_set(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int sock_mmap_fd_set(pktio_entry_t *pktio_entry, int index,
 			    fd_set *readfds)
 {
 	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
 	int fd;
 
 	odp_ticketlock_lock(&pktio_entry->rxl);
-	fd = pkt_sock->sockfd;
+	fd = pkt_sock->rx_ring[index].sock;
 	FD_SET(fd, readfds);
 	odp_ticketlock_unlock(&pktio_entry->rxl);
 
 	return fd;
 }
 
-static int sock_mmap_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+/* Notify kernel about Tx frames that have been pending longer than the batch
+ * timeout. Called from the receive path, so that frames do not wait for the
+ * next send call when output traffic stops. Only the kick is done here. The
+ * pending frame count is owned by the output queue and may be left stale, which
+ * causes at most one early notification. */
+static inline void tx_pending_flush(pkt_sock_mmap_t *pkt_sock)
+{
+	uint64_t now = 0;
+
+	for (uint32_t i = 0; i < pkt_sock->num_tx; i++) {
+		struct ring *ring = &pkt_sock->tx_ring[i];
+		uint64_t first = odp_atomic_load_u64(&ring->pending_ts);
+
+		if (odp_likely(first == 0))
+			continue;
+
+		if (now == 0)
+			now = odp_time_global_ns();
+
+		if (now - first < tx_batch_tmo)
+			continue;
+
+		/* Only one thread notifies kernel */
+		if (odp_atomic_cas_acq_u64(&ring->pending_ts, &first, 0))
+			(void)send(ring->sock, NULL, 0, MSG_DONTWAIT);
+	}
+}
+
+static int sock_mmap_recv(pktio_entry_t *pktio_entry, int index,
 			  odp_packet_t pkt_table[], int num)
 {
 	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+	struct rx_ring *ring = &pkt_sock->rx_ring[index];
 	int ret;
 
-	odp_ticketlock_lock(&pkt_sock->rx_ring.lock);
-	ret = pkt_mmap_v2_rx(pktio_entry, pkt_sock, pkt_table, num,
+	if (tx_batch > 1)
+		tx_pending_flush(pkt_sock);
+
+	if (!pkt_sock->lockless_rx)
+		odp_ticketlock_lock(&ring->lock);
+
+	ret = pkt_mmap_v3_rx(pktio_entry, pkt_sock, ring, pkt_table, num,
 			     pkt_sock->if_mac);
-	odp_ticketlock_unlock(&pkt_sock->rx_ring.lock);
+
+	if (!pkt_sock->lockless_rx)
+		odp_ticketlock_unlock(&ring->lock);
 
 	return ret;
 }
@@ -803,16 +1206,20 @@ static int sock_mmap_recv_mq_tmo(pktio_entry_t *pktio_entry[], int index[],
 	}
 }
 
-static int sock_mmap_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int sock_mmap_send(pktio_entry_t *pktio_entry, int index,
 			  const odp_packet_t pkt_table[], int num)
 {
 	int ret;
 	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+	struct ring *ring = &pkt_sock->tx_ring[index];
+
+	if (!pkt_sock->lockless_tx)
+		odp_ticketlock_lock(&ring->lock);
 
-	odp_ticketlock_lock(&pkt_sock->tx_ring.lock);
-	ret = pkt_mmap_v2_tx(pktio_entry, pkt_sock->tx_ring.sock,
-			     &pkt_sock->tx_ring, pkt_table, num);
-	odp_ticketlock_unlock(&pkt_sock->tx_ring.lock);
+	ret = pkt_mmap_v2_tx(pktio_entry, ring, pkt_table, num);
+
+	if (!pkt_sock->lockless_tx)
+		odp_ticketlock_unlock(&ring->lock);
 
 	return ret;
 }
@@ -875,8 +1282,8 @@ static int sock_mmap_capability(pktio_entry_t *pktio_entry,
 
 	memset(capa, 0, sizeof(odp_pktio_capability_t));
 
-	capa->max_input_queues  = 1;
-	capa->max_output_queues = 1;
+	capa->max_input_queues  = MAX_RX_QUEUES;
+	capa->max_output_queues = MAX_TX_QUEUES;
 	capa->set_op.op.promisc_mode = 1;
 	capa->set_op.op.maxlen = 1;
 
@@ -938,6 +1345,81 @@ static int sock_mmap_extra_stat_counter(pktio_entry_t *pktio_entry, uint32_t id,
 					    pkt_priv(pktio_entry)->sockfd);
 }
 
+static void parse_options(void)
+{
+	int val;
+
+	fanout_mode = PACKET_FANOUT_HASH;
+	qdisc_bypass = 0;
+	tx_batch = 0;
+	tx_batch_tmo = 0;
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, QDISC_BYPASS_STR, &val)) {
+		_ODP_ERR("Unable to parse socket mmap qdisc bypass, using 0\n");
+	} else {
+		qdisc_bypass = !!val;
+#ifndef PACKET_QDISC_BYPASS
+		if (qdisc_bypass)
+			_ODP_ERR("PACKET_QDISC_BYPASS not supported, option ignored\n");
+		qdisc_bypass = 0;
+#endif
+	}
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, TX_BATCH_STR, &val) ||
+	    val < 0) {
+		_ODP_ERR("Unable to parse socket mmap tx batch, using 0\n");
+	} else {
+		tx_batch = val;
+	}
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, TX_BATCH_TMO_STR, &val) ||
+	    val < 0) {
+		_ODP_ERR("Unable to parse socket mmap tx batch timeout, using 0\n");
+	} else {
+		tx_batch_tmo = val;
+	}
+
+	if (!_odp_libconfig_lookup_ext_int(CONF_BASE_STR, NULL, FANOUT_MODE_STR, &val)) {
+		_ODP_ERR("Unable to parse socket mmap fanout mode, using hash\n");
+		return;
+	}
+
+	switch (val) {
+	case 0:
+		fanout_mode = PACKET_FANOUT_HASH;
+		break;
+	case 1:
+		fanout_mode = PACKET_FANOUT_CPU;
+		break;
+	case 2:
+		fanout_mode = PACKET_FANOUT_LB;
+		break;
+	default:
+		_ODP_ERR("Invalid socket mmap fanout mode (%i), using hash\n", val);
+	}
+}
+
+static int sock_mmap_input_queues_config(pktio_entry_t *pktio_entry,
+					 const odp_pktin_queue_param_t *param)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+
+	pkt_sock->lockless_rx = pktio_entry->param.in_mode == ODP_PKTIN_MODE_SCHED ||
+				param->op_mode == ODP_PKTIO_OP_MT_UNSAFE;
+
+	return 0;
+}
+
+static int sock_mmap_output_queues_config(pktio_entry_t *pktio_entry,
+					  const odp_pktout_queue_param_t *param)
+{
+	pkt_sock_mmap_t *const pkt_sock = pkt_priv(pktio_entry);
+
+	pkt_sock->lockless_tx = param->op_mode == ODP_PKTIO_OP_MT_UNSAFE;
+
+	return 0;
+}
+
 static int sock_mmap_init_global(void)
 {
 	if (getenv("ODP_PKTIO_DISABLE_SOCKET_MMAP")) {
@@ -947,6 +1429,7 @@ static int sock_mmap_init_global(void)
 	} else  {
 		_ODP_PRINT("PKTIO: initialized socket mmap,"
 				" use export ODP_PKTIO_DISABLE_SOCKET_MMAP=1 to disable.\n");
+		parse_options();
 	}
 	return 0;
 }
@@ -959,8 +1442,8 @@ const pktio_if_ops_t _odp_sock_mmap_pktio_ops = {
 	.term = NULL,
 	.open = sock_mmap_open,
 	.close = sock_mmap_close,
-	.start = NULL,
-	.stop = NULL,
+	.start = sock_mmap_start,
+	.stop = sock_mmap_stop,
 	.stats = sock_mmap_stats,
 	.stats_reset = sock_mmap_stats_reset,
 	.extra_stat_info = sock_mmap_extra_stat_info,
@@ -984,6 +1467,6 @@ const pktio_if_ops_t _odp_sock_mmap_pktio_ops = {
 	.pktio_ts_from_ns = NULL,
 	.pktio_time = NULL,
 	.config = NULL,
-	.input_queues_config = NULL,
-	.output_queues_config = NULL,
+	.input_queues_config = sock_mmap_input_queues_config,
+	.output_queues_config = sock_mmap_output_queues_config,
 };
@@ -26,6 +26,16 @@
  * TUN/TAP kernel module should be loaded to use this pktio.
  * There should be no device named 'iface' in the system.
  * The total length of the 'iface' is limited by IF_NAMESIZE.
+ *
+ * The device is created in multi-queue mode (IFF_MULTI_QUEUE) and a separate
+ * file descriptor is opened for each configured packet input and output
+ * queue. The kernel steers received flows between the descriptors of input
+ * queues. Descriptors used only for output are detached from receive steering
+ * (IFF_DETACH_QUEUE), since nothing would read them. An existing single queue
+ * device is opened in single queue mode, and then only one input and output
+ * queue is supported. Packets carry a virtio-net header (IFF_VNET_HDR), which
+ * is used for passing L4 checksum insertion requests to the kernel. Packet data
+ * is read and written directly into/from packet segments with readv()/writev().
  */
 
 #include <odp_posix_extensions.h>
@@ -35,6 +45,7 @@
 #include <odp/api/packet_io.h>
 #include <odp/api/random.h>
 #include <odp/api/ticketlock.h>
+#include <odp/api/chksum.h>
 
 #include <odp/api/plat/packet_inlines.h>
 
@@ -44,20 +55,51 @@
 #include <odp_packet_internal.h>
 #include <odp_packet_io_internal.h>
 #include <odp_classification_internal.h>
+#include <protocols/ip.h>
+#include <protocols/tcp.h>
+#include <protocols/udp.h>
 
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
+#include <stddef.h>
 #include <stdio.h>
 #include <stdbool.h>
 #include <sys/ioctl.h>
 #include <sys/socket.h>
 #include <sys/types.h>
+#include <sys/uio.h>
 #include <linux/if_tun.h>
+#include <linux/virtio_net.h>
+
+/* Maximum number of TAP queues (file descriptors) */
+#define TAP_MAX_QUEUES 16
+
+/* Maximum number of I/O vectors per packet, including virtio-net header */
+#define TAP_MAX_IOV 32
+
+/* TAP device flags, IFF_MULTI_QUEUE is added when supported by the device */
+#define TAP_IFF_FLAGS (IFF_TAP | IFF_NO_PI | IFF_VNET_HDR)
+
+typedef struct ODP_ALIGNED_CACHE {
+	/* Queue file descriptor */
+	int fd;
+	/* Descriptor is attached to kernel receive steering */
+	odp_bool_t attached;
+	/* Spare packet for the next read */
+	odp_packet_t spare;
+	odp_ticketlock_t rx_lock;
+	odp_ticketlock_t tx_lock;
+} tap_queue_t;
 
 typedef struct {
-	int fd;				/**< file descriptor for tap interface*/
+	tap_queue_t queue[TAP_MAX_QUEUES];	/**< TAP queues */
+	int num_queues;			/**< number of open queues */
+	int fd;				/**< file descriptor of the first queue */
 	int skfd;			/**< socket descriptor */
+	odp_bool_t multi_queue;		/**< device is in multi-queue mode */
+	odp_bool_t lockless_rx;		/**< no locking for rx */
+	odp_bool_t lockless_tx;		/**< no locking for tx */
 	uint32_t mtu;			/**< cached mtu */
 	uint32_t mtu_max;		/**< maximum supported MTU value */
 	unsigned char if_mac[ETH_ALEN];	/**< MAC address of pktio side (not a
@@ -104,25 +146,10 @@ static int mac_addr_set_fd(int fd, const char *name,
 	return 0;
 }
 
-static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
-			  pktio_entry_t *pktio_entry,
-			  const char *devname, odp_pool_t pool)
+static int tap_fd_open(const char *name, odp_bool_t multi_queue)
 {
-	int fd, skfd, flags;
-	uint32_t mtu;
+	int fd, flags, err;
 	struct ifreq ifr;
-	pkt_tap_t *tap = pkt_priv(pktio_entry);
-
-	if (strncmp(devname, "tap:", 4) != 0)
-		return -1;
-
-	/* Init pktio entry */
-	memset(tap, 0, sizeof(*tap));
-	tap->fd = -1;
-	tap->skfd = -1;
-
-	if (pool == ODP_POOL_INVALID)
-		return -1;
 
 	fd = open("/dev/net/tun", O_RDWR);
 	if (fd < 0) {
@@ -135,13 +162,23 @@ static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
 	 *        IFF_TAP   - TAP device
 	 *
 	 *        IFF_NO_PI - Do not provide packet information
+	 *        IFF_MULTI_QUEUE - Each fd attached to the device is a queue
+	 *        IFF_VNET_HDR - Packets are prefixed with a virtio-net header
 	 */
-	ifr.ifr_flags = IFF_TAP | IFF_NO_PI;
-	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", devname + 4);
+	ifr.ifr_flags = TAP_IFF_FLAGS | (multi_queue ? IFF_MULTI_QUEUE : 0);
+	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s", name);
 
 	if (ioctl(fd, TUNSETIFF, (void *)&ifr) < 0) {
-		_ODP_ERR("%s: creating tap device failed: %s\n", ifr.ifr_name, strerror(errno));
-		goto tap_err;
+		err = errno;
+
+		/* Existing single queue device rejects multi-queue mode. Caller
+		 * retries in single queue mode. */
+		if (!multi_queue || err != EINVAL)
+			_ODP_ERR("%s: creating tap device failed: %s\n", ifr.ifr_name,
+				 strerror(err));
+		close(fd);
+		errno = err;
+		return -1;
 	}
 
 	/* Set nonblocking mode on interface. */
@@ -156,6 +193,137 @@ static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
 		goto tap_err;
 	}
 
+	return fd;
+
+tap_err:
+	close(fd);
+	return -1;
+}
+
+static void tap_queue_init(tap_queue_t *queue, int fd)
+{
+	queue->fd = fd;
+	queue->attached = true;
+	queue->spare = ODP_PACKET_INVALID;
+	odp_ticketlock_init(&queue->rx_lock);
+	odp_ticketlock_init(&queue->tx_lock);
+}
+
+static int tap_queue_close(tap_queue_t *queue)
+{
+	int ret = 0;
+
+	if (queue->spare != ODP_PACKET_INVALID) {
+		odp_packet_free(queue->spare);
+		queue->spare = ODP_PACKET_INVALID;
+	}
+
+	if (queue->fd != -1 && close(queue->fd) != 0) {
+		_ODP_ERR("close(queue->fd): %s\n", strerror(errno));
+		ret = -1;
+	}
+
+	queue->fd = -1;
+
+	return ret;
+}
+
+/* Open or close queue file descriptors so that there is one per configured
+ * input/output queue. The first queue is never closed, since it keeps the
+ * device alive. Descriptors beyond the number of input queues are detached
+ * from receive steering, since packets steered to them would never be read.
+ * Detached descriptors can still be written. */
+static int tap_queues_setup(pktio_entry_t *pktio_entry)
+{
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
+	const char *name = pktio_entry->name + 4;
+	int num = _ODP_MAX(pktio_entry->num_in_queue, pktio_entry->num_out_queue);
+	int num_rx = pktio_entry->num_in_queue ? (int)pktio_entry->num_in_queue : 1;
+	struct ifreq ifr;
+	int fd;
+
+	if (num < 1)
+		num = 1;
+
+	if (num > 1 && !tap->multi_queue) {
+		_ODP_ERR("Single queue device, %d queues requested\n", num);
+		return -1;
+	}
+
+	while (tap->num_queues > num)
+		tap_queue_close(&tap->queue[--tap->num_queues]);
+
+	while (tap->num_queues < num) {
+		fd = tap_fd_open(name, tap->multi_queue);
+		if (fd < 0)
+			return -1;
+
+		tap_queue_init(&tap->queue[tap->num_queues++], fd);
+	}
+
+	for (int i = 0; i < tap->num_queues; i++) {
+		tap_queue_t *queue = &tap->queue[i];
+		odp_bool_t attach = i < num_rx;
+
+		if (queue->attached == attach)
+			continue;
+
+		memset(&ifr, 0, sizeof(ifr));
+		ifr.ifr_flags = attach ? IFF_ATTACH_QUEUE : IFF_DETACH_QUEUE;
+
+		if (ioctl(queue->fd, TUNSETQUEUE, (void *)&ifr) < 0) {
+			_ODP_ERR("ioctl(TUNSETQUEUE) failed: %s\n", strerror(errno));
+			return -1;
+		}
+
+		queue->attached = attach;
+	}
+
+	return 0;
+}
+
+static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
+			  pktio_entry_t *pktio_entry,
+			  const char *devname, odp_pool_t pool)
+{
+	int fd, skfd;
+	int vnet_hdr_sz = sizeof(struct virtio_net_hdr);
+	uint32_t mtu;
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
+
+	if (strncmp(devname, "tap:", 4) != 0)
+		return -1;
+
+	/* Init pktio entry */
+	memset(tap, 0, sizeof(*tap));
+	tap->fd = -1;
+	tap->skfd = -1;
+
+	if (pool == ODP_POOL_INVALID)
+		return -1;
+
+	tap->multi_queue = true;
+	fd = tap_fd_open(devname + 4, true);
+	if (fd < 0 && errno == EINVAL) {
+		tap->multi_queue = false;
+		fd = tap_fd_open(devname + 4, false);
+	}
+
+	if (fd < 0)
+		goto tap_alloc_err;
+
+	if (ioctl(fd, TUNSETVNETHDRSZ, &vnet_hdr_sz) < 0) {
+		_ODP_ERR("ioctl(TUNSETVNETHDRSZ) failed: %s\n", strerror(errno));
+		goto tap_err;
+	}
+
+	/* No receive side offloads (checksum/GSO), packets are received as
+	 * complete frames of at most MTU bytes. */
+	if (ioctl(fd, TUNSETOFFLOAD, 0) < 0) {
+		_ODP_ERR("ioctl(TUNSETOFFLOAD) failed: %s\n", strerror(errno));
+		goto tap_err;
+	}
+
 	if (gen_random_mac(tap->if_mac) < 0)
 		goto tap_err;
 
@@ -175,6 +343,8 @@ static int tap_pktio_open(odp_pktio_t id ODP_UNUSED,
 	if (mtu > tap->mtu_max)
 		tap->mtu_max =  mtu;
 
+	tap_queue_init(&tap->queue[0], fd);
+	tap->num_queues = 1;
 	tap->fd = fd;
 	tap->skfd = skfd;
 	tap->mtu = mtu;
@@ -184,6 +354,7 @@ sock_err:
 	close(skfd);
 tap_err:
 	close(fd);
+tap_alloc_err:
 	_ODP_ERR("Tap device alloc failed.\n");
 	return -1;
 }
@@ -193,6 +364,11 @@ static int tap_pktio_start(pktio_entry_t *pktio_entry)
 	struct ifreq ifr;
 	pkt_tap_t *tap = pkt_priv(pktio_entry);
 
+	if (tap_queues_setup(pktio_entry)) {
+		_ODP_ERR("Tap queue setup failed.\n");
+		return -1;
+	}
+
 	odp_memset(&ifr, 0, sizeof(ifr));
 	snprintf(ifr.ifr_name, IF_NAMESIZE, "%s",
 		 (char *)pktio_entry->name + 4);
@@ -240,6 +416,14 @@ static int tap_pktio_stop(pktio_entry_t *pktio_entry)
 		goto sock_err;
 	}
 
+	/* Packet length may change while stopped */
+	for (int i = 0; i < tap->num_queues; i++) {
+		if (tap->queue[i].spare != ODP_PACKET_INVALID) {
+			odp_packet_free(tap->queue[i].spare);
+			tap->queue[i].spare = ODP_PACKET_INVALID;
+		}
+	}
+
 	return 0;
 sock_err:
 	_ODP_ERR("Tap device open failed.\n");
@@ -251,11 +435,14 @@ static int tap_pktio_close(pktio_entry_t *pktio_entry)
 	int ret = 0;
 	pkt_tap_t *tap = pkt_priv(pktio_entry);
 
-	if (tap->fd != -1 && close(tap->fd) != 0) {
-		_ODP_ERR("close(tap->fd): %s\n", strerror(errno));
-		ret = -1;
+	for (int i = 0; i < tap->num_queues; i++) {
+		if (tap_queue_close(&tap->queue[i]))
+			ret = -1;
 	}
 
+	tap->num_queues = 0;
+	tap->fd = -1;
+
 	if (tap->skfd != -1 && close(tap->skfd) != 0) {
 		_ODP_ERR("close(tap->skfd): %s\n", strerror(errno));
 		ret = -1;
@@ -264,34 +451,65 @@ static int tap_pktio_close(pktio_entry_t *pktio_entry)
 	return ret;
 }
 
-static odp_packet_t pack_odp_pkt(pktio_entry_t *pktio_entry, const void *data,
-				 unsigned int len, odp_time_t *ts)
+/* Fill I/O vectors with packet segments. Returns number of vectors, or zero
+ * if the packet has too many segments. */
+static inline int tap_pkt_to_iov(odp_packet_t pkt, struct iovec iov[], int max_iov)
 {
-	odp_packet_t pkt;
-	odp_packet_hdr_t *pkt_hdr;
-	int num;
+	odp_packet_seg_t seg = odp_packet_first_seg(pkt);
+	int num_seg = odp_packet_num_segs(pkt);
+
+	if (odp_unlikely(num_seg > max_iov))
+		return 0;
+
+	for (int i = 0; i < num_seg; i++) {
+		iov[i].iov_base = odp_packet_seg_data(pkt, seg);
+		iov[i].iov_len = odp_packet_seg_data_len(pkt, seg);
+		seg = odp_packet_next_seg(pkt, seg);
+	}
+
+	return num_seg;
+}
+
+static odp_packet_t tap_pkt_alloc(pktio_entry_t *pktio_entry)
+{
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
 	uint16_t frame_offset = pktio_entry->pktin_frame_offset;
-	const odp_proto_layer_t layer = pktio_entry->parse_layer;
-	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
+	odp_packet_t pkt;
 
-	num = _odp_packet_alloc_multi(pkt_priv(pktio_entry)->pool,
-				      len + frame_offset, &pkt, 1);
-	if (num != 1)
+	if (_odp_packet_alloc_multi(tap->pool, tap->mtu + frame_offset, &pkt, 1) != 1)
 		return ODP_PACKET_INVALID;
 
-	pkt_hdr = packet_hdr(pkt);
-
 	if (frame_offset)
-		pull_head(pkt_hdr, frame_offset);
+		pull_head(packet_hdr(pkt), frame_offset);
 
-	if (odp_packet_copy_from_mem(pkt, 0, len, data) < 0) {
-		_ODP_ERR("failed to copy packet data\n");
-		odp_packet_free(pkt);
-		return ODP_PACKET_INVALID;
+	return pkt;
+}
+
+static odp_packet_t tap_pkt_finish(pktio_entry_t *pktio_entry, odp_packet_t pkt,
+				   uint32_t len, odp_time_t *ts)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	uint32_t trunc = odp_packet_len(pkt) - len;
+	const odp_proto_layer_t layer = pktio_entry->parse_layer;
+	const odp_pktin_config_opt_t opt = pktio_entry->config.pktin;
+	uint8_t *data;
+	uint32_t seg_len;
+
+	if (trunc) {
+		if (pkt_hdr->seg_count == 1) {
+			pull_tail(pkt_hdr, trunc);
+		} else if (odp_packet_trunc_tail(&pkt, trunc, NULL, NULL) < 0) {
+			odp_packet_free(pkt);
+			return ODP_PACKET_INVALID;
+		}
+		pkt_hdr = packet_hdr(pkt);
 	}
 
 	if (layer) {
-		if (_odp_packet_parse_common(pkt_hdr, data, len, len, layer,
+		data = odp_packet_data(pkt);
+		seg_len = odp_packet_seg_len(pkt);
+
+		if (_odp_packet_parse_common(pkt_hdr, data, len, seg_len, layer,
 					     opt) < 0) {
 			odp_packet_free(pkt);
 			return ODP_PACKET_INVALID;
@@ -320,14 +538,15 @@ static odp_packet_t pack_odp_pkt(pktio_entry_t *pktio_entry, const void *data,
 	return pkt;
 }
 
-static int tap_pktio_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int tap_pktio_recv(pktio_entry_t *pktio_entry, int index,
 			  odp_packet_t pkts[], int num)
 {
 	pkt_tap_t *tap = pkt_priv(pktio_entry);
+	tap_queue_t *queue = &tap->queue[index];
+	struct virtio_net_hdr vnet_hdr;
+	struct iovec iov[TAP_MAX_IOV];
 	ssize_t retval;
-	int i;
-	uint32_t mtu = tap->mtu;
-	uint8_t buf[mtu];
+	int i, num_iov;
 	odp_time_t ts_val;
 	odp_time_t *ts = NULL;
 	int num_rx = 0;
@@ -335,25 +554,58 @@ static int tap_pktio_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	const int cls_enabled = pktio_cls_enabled(pktio_entry);
 	odp_packet_t pkt;
 
-	odp_ticketlock_lock(&pktio_entry->rxl);
+	if (!tap->lockless_rx)
+		odp_ticketlock_lock(&queue->rx_lock);
 
 	if (pktio_entry->config.pktin.bit.ts_all ||
 	    pktio_entry->config.pktin.bit.ts_ptp)
 		ts = &ts_val;
 
+	iov[0].iov_base = &vnet_hdr;
+	iov[0].iov_len = sizeof(vnet_hdr);
+
 	for (i = 0; i < num; i++) {
+		/* Data is read directly into an MTU sized packet. A packet that
+		 * was not needed on the previous call is reused. */
+		pkt = queue->spare;
+		queue->spare = ODP_PACKET_INVALID;
+
+		if (pkt == ODP_PACKET_INVALID) {
+			pkt = tap_pkt_alloc(pktio_entry);
+			if (odp_unlikely(pkt == ODP_PACKET_INVALID))
+				break;
+		}
+
+		num_iov = tap_pkt_to_iov(pkt, &iov[1], TAP_MAX_IOV - 1);
+		if (odp_unlikely(num_iov == 0)) {
+			_ODP_ERR("too many packet segments\n");
+			odp_packet_free(pkt);
+			break;
+		}
+
 		do {
-			retval = read(tap->fd, buf, mtu);
+			retval = readv(queue->fd, iov, num_iov + 1);
 		} while (retval < 0 && errno == EINTR);
 
 		if (ts != NULL)
 			ts_val = odp_time_global();
 
-		if (retval < 0) {
+		if (retval <= (ssize_t)sizeof(vnet_hdr)) {
+			queue->spare = pkt;
 			break;
 		}
 
-		pkt = pack_odp_pkt(pktio_entry, buf, retval, ts);
+		/* Kernel returns the full frame length also when the frame did not
+		 * fit into the packet (e.g. MTU was increased outside of ODP) */
+		if (odp_unlikely((uint32_t)(retval - sizeof(vnet_hdr)) > odp_packet_len(pkt))) {
+			odp_atomic_inc_u64(&pktio_entry->stats_extra.in_errors);
+			queue->spare = pkt;
+			continue;
+		}
+
+		/* Receive offloads are not enabled, so the header does not
+		 * carry anything that would need handling. */
+		pkt = tap_pkt_finish(pktio_entry, pkt, retval - sizeof(vnet_hdr), ts);
 		if (pkt == ODP_PACKET_INVALID)
 			break;
 
@@ -370,21 +622,173 @@ static int tap_pktio_recv(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
 	if (odp_unlikely(num_cls))
 		_odp_cls_enq(pkts, num_cls, true);
 
-	odp_ticketlock_unlock(&pktio_entry->rxl);
+	if (!tap->lockless_rx)
+		odp_ticketlock_unlock(&queue->rx_lock);
 
 	return num_rx;
 }
 
-static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry,
+static inline int check_proto(void *l3_hdr, uint32_t l3_len,
+			      odp_bool_t *l3_proto_v4, uint8_t *l4_proto)
+{
+	uint8_t l3_proto_ver = _ODP_IPV4HDR_VER(*(uint8_t *)l3_hdr);
+
+	if (l3_proto_ver == _ODP_IPV4 && l3_len >= _ODP_IPV4HDR_LEN) {
+		_odp_ipv4hdr_t *ip = l3_hdr;
+		uint16_t frag_offset = odp_be_to_cpu_16(ip->frag_offset);
+
+		*l3_proto_v4 = 1;
+		if (!_ODP_IPV4HDR_IS_FRAGMENT(frag_offset))
+			*l4_proto = ip->proto;
+		else
+			*l4_proto = 255;
+
+		return 0;
+	} else if (l3_proto_ver == _ODP_IPV6 && l3_len >= _ODP_IPV6HDR_LEN) {
+		_odp_ipv6hdr_t *ipv6 = l3_hdr;
+
+		*l3_proto_v4 = 0;
+		*l4_proto = ipv6->next_hdr;
+
+		return 0;
+	}
+
+	return -1;
+}
+
+/* Ones' complement sum of the TCP/UDP pseudo header. Not inverted, since the
+ * kernel completes the checksum over the L4 header and payload. */
+static uint16_t phdr_csum(odp_bool_t ipv4, void *l3_hdr, uint8_t l4_proto,
+			  uint32_t l4_len)
+{
+	union {
+		struct ODP_PACKED {
+			odp_u32be_t src_addr;
+			odp_u32be_t dst_addr;
+			uint8_t zero;
+			uint8_t proto;
+			odp_u16be_t len;
+		} v4;
+		struct ODP_PACKED {
+			_odp_ipv6_addr_t src_addr;
+			_odp_ipv6_addr_t dst_addr;
+			odp_u32be_t len;
+			uint8_t zero[3];
+			uint8_t next_hdr;
+		} v6;
+	} phdr;
+
+	memset(&phdr, 0, sizeof(phdr));
+
+	if (ipv4) {
+		_odp_ipv4hdr_t *ip = l3_hdr;
+
+		phdr.v4.src_addr = ip->src_addr;
+		phdr.v4.dst_addr = ip->dst_addr;
+		phdr.v4.proto = l4_proto;
+		phdr.v4.len = odp_cpu_to_be_16(l4_len);
+
+		return odp_chksum_ones_comp16(&phdr, sizeof(phdr.v4));
+	}
+
+	_odp_ipv6hdr_t *ipv6 = l3_hdr;
+
+	phdr.v6.src_addr = ipv6->src_addr;
+	phdr.v6.dst_addr = ipv6->dst_addr;
+	phdr.v6.len = odp_cpu_to_be_32(l4_len);
+	phdr.v6.next_hdr = l4_proto;
+
+	return odp_chksum_ones_comp16(&phdr, sizeof(phdr.v6));
+}
+
+#define OL_TX_CHKSUM_PKT(_cfg, _ena, _proto, _ovr_set, _ovr) \
+	(_ena && _proto && (_ovr_set ? _ovr : _cfg))
+
+/* Insert IPv4 checksum in software and request TCP/UDP checksum insertion
+ * from the kernel through the virtio-net header. */
+static void tap_pkt_set_ol_tx(const odp_pktout_config_opt_t *pktout_cfg,
+			      odp_packet_t pkt, struct virtio_net_hdr *vnet_hdr)
+{
+	odp_packet_hdr_t *pkt_hdr = packet_hdr(pkt);
+	packet_parser_t *pkt_p = &pkt_hdr->p;
+	odp_bool_t l3_proto_v4 = false;
+	uint8_t l4_proto;
+	void *l3_hdr;
+	uint32_t l3_len, l4_len, ip_len, ip_hdr_len;
+	uint16_t csum_offset, csum;
+	odp_bool_t udp_chksum_pkt, tcp_chksum_pkt;
+
+	l3_hdr = odp_packet_l3_ptr(pkt, &l3_len);
+
+	if (l3_hdr == NULL ||
+	    check_proto(l3_hdr, l3_len, &l3_proto_v4, &l4_proto))
+		return;
+
+	if (OL_TX_CHKSUM_PKT(pktout_cfg->bit.ipv4_chksum,
+			     pktout_cfg->bit.ipv4_chksum_ena,
+			     l3_proto_v4,
+			     pkt_p->flags.l3_chksum_set,
+			     pkt_p->flags.l3_chksum))
+		_odp_packet_ipv4_chksum_insert(pkt);
+
+	if (pkt_p->l4_offset == ODP_PACKET_OFFSET_INVALID)
+		return;
+
+	udp_chksum_pkt = OL_TX_CHKSUM_PKT(pktout_cfg->bit.udp_chksum,
+					  pktout_cfg->bit.udp_chksum_ena,
+					  l4_proto == _ODP_IPPROTO_UDP,
+					  pkt_p->flags.l4_chksum_set,
+					  pkt_p->flags.l4_chksum);
+	tcp_chksum_pkt = OL_TX_CHKSUM_PKT(pktout_cfg->bit.tcp_chksum,
+					  pktout_cfg->bit.tcp_chksum_ena,
+					  l4_proto == _ODP_IPPROTO_TCP,
+					  pkt_p->flags.l4_chksum_set,
+					  pkt_p->flags.l4_chksum);
+
+	if (udp_chksum_pkt)
+		csum_offset = offsetof(_odp_udphdr_t, chksum);
+	else if (tcp_chksum_pkt)
+		csum_offset = offsetof(_odp_tcphdr_t, cksm);
+	else
+		return;
+
+	if (l3_proto_v4)
+		ip_len = odp_be_to_cpu_16(((_odp_ipv4hdr_t *)l3_hdr)->tot_len);
+	else
+		ip_len = odp_be_to_cpu_16(((_odp_ipv6hdr_t *)l3_hdr)->payload_len) +
+			 _ODP_IPV6HDR_LEN;
+
+	ip_hdr_len = pkt_p->l4_offset - pkt_p->l3_offset;
+	if (odp_unlikely(ip_len < ip_hdr_len))
+		return;
+
+	l4_len = ip_len - ip_hdr_len;
+	csum = phdr_csum(l3_proto_v4, l3_hdr, l4_proto, l4_len);
+
+	if (odp_packet_copy_from_mem(pkt, pkt_p->l4_offset + csum_offset,
+				     sizeof(csum), &csum) < 0)
+		return;
+
+	vnet_hdr->flags = VIRTIO_NET_HDR_F_NEEDS_CSUM;
+	vnet_hdr->csum_start = pkt_p->l4_offset;
+	vnet_hdr->csum_offset = csum_offset;
+}
+
+static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry, tap_queue_t *queue,
 				   const odp_packet_t pkts[], int num)
 {
 	pkt_tap_t *tap = pkt_priv(pktio_entry);
+	struct virtio_net_hdr vnet_hdr;
+	struct iovec iov[TAP_MAX_IOV];
 	ssize_t retval;
-	int i, n;
+	int i, n, num_iov;
 	uint32_t pkt_len;
 	uint32_t mtu = tap->mtu;
 	uint8_t tx_ts_enabled = _odp_pktio_tx_ts_enabled(pktio_entry);
-	uint8_t buf[mtu];
+	uint8_t chksum_enabled = pktio_entry->enabled.chksum_insert;
+
+	iov[0].iov_base = &vnet_hdr;
+	iov[0].iov_len = sizeof(vnet_hdr);
 
 	for (i = 0; i < num; i++) {
 		pkt_len = odp_packet_len(pkts[i]);
@@ -396,22 +800,30 @@ static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry,
 			break;
 		}
 
-		if (odp_packet_copy_to_mem(pkts[i], 0, pkt_len, buf) < 0) {
-			_ODP_ERR("failed to copy packet data\n");
+		memset(&vnet_hdr, 0, sizeof(vnet_hdr));
+
+		if (chksum_enabled)
+			tap_pkt_set_ol_tx(&pktio_entry->config.pktout, pkts[i], &vnet_hdr);
+
+		num_iov = tap_pkt_to_iov(pkts[i], &iov[1], TAP_MAX_IOV - 1);
+		if (odp_unlikely(num_iov == 0)) {
+			_ODP_ERR("too many packet segments\n");
+			if (i == 0)
+				return -1;
 			break;
 		}
 
 		do {
-			retval = write(tap->fd, buf, pkt_len);
+			retval = writev(queue->fd, iov, num_iov + 1);
 		} while (retval < 0 && errno == EINTR);
 
 		if (retval < 0) {
 			if (i == 0 && SOCK_ERR_REPORT(errno)) {
-				_ODP_ERR("write(): %s\n", strerror(errno));
+				_ODP_ERR("writev(): %s\n", strerror(errno));
 				return -1;
 			}
 			break;
-		} else if ((uint32_t)retval != pkt_len) {
+		} else if ((uint32_t)retval != pkt_len + sizeof(vnet_hdr)) {
 			_ODP_ERR("sent partial ethernet packet\n");
 			if (i == 0) {
 				return -1;
@@ -431,16 +843,20 @@ static int tap_pktio_send_lockless(pktio_entry_t *pktio_entry,
 	return i;
 }
 
-static int tap_pktio_send(pktio_entry_t *pktio_entry, int index ODP_UNUSED,
+static int tap_pktio_send(pktio_entry_t *pktio_entry, int index,
 			  const odp_packet_t pkts[], int num)
 {
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
+	tap_queue_t *queue = &tap->queue[index];
 	int ret;
 
-	odp_ticketlock_lock(&pktio_entry->txl);
+	if (!tap->lockless_tx)
+		odp_ticketlock_lock(&queue->tx_lock);
 
-	ret = tap_pktio_send_lockless(pktio_entry, pkts, num);
+	ret = tap_pktio_send_lockless(pktio_entry, queue, pkts, num);
 
-	odp_ticketlock_unlock(&pktio_entry->txl);
+	if (!tap->lockless_tx)
+		odp_ticketlock_unlock(&queue->tx_lock);
 
 	return ret;
 }
@@ -512,6 +928,36 @@ static int tap_link_info(pktio_entry_t *pktio_entry, odp_pktio_link_info_t *info
 	return _odp_link_info_fd(pkt_priv(pktio_entry)->skfd, pktio_entry->name + 4, info);
 }
 
+static int tap_input_queues_config(pktio_entry_t *pktio_entry,
+				   const odp_pktin_queue_param_t *param)
+{
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
+
+	tap->lockless_rx = pktio_entry->param.in_mode == ODP_PKTIN_MODE_SCHED ||
+			   param->op_mode == ODP_PKTIO_OP_MT_UNSAFE;
+
+	return 0;
+}
+
+static int tap_output_queues_config(pktio_entry_t *pktio_entry,
+				    const odp_pktout_queue_param_t *param)
+{
+	pkt_tap_t *tap = pkt_priv(pktio_entry);
+
+	tap->lockless_tx = param->op_mode == ODP_PKTIO_OP_MT_UNSAFE;
+
+	return 0;
+}
+
+static int tap_config(pktio_entry_t *pktio_entry, const odp_pktio_config_t *config)
+{
+	pktio_entry->enabled.chksum_insert = config->pktout.bit.ipv4_chksum_ena ||
+					     config->pktout.bit.udp_chksum_ena ||
+					     config->pktout.bit.tcp_chksum_ena;
+
+	return 0;
+}
+
 static int tap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 			  odp_pktio_capability_t *capa)
 {
@@ -519,8 +965,8 @@ static int tap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 
 	memset(capa, 0, sizeof(odp_pktio_capability_t));
 
-	capa->max_input_queues  = 1;
-	capa->max_output_queues = 1;
+	capa->max_input_queues  = tap->multi_queue ? TAP_MAX_QUEUES : 1;
+	capa->max_output_queues = tap->multi_queue ? TAP_MAX_QUEUES : 1;
 	capa->set_op.op.promisc_mode = 1;
 	capa->set_op.op.mac_addr = 1;
 	capa->set_op.op.maxlen = 1;
@@ -535,6 +981,15 @@ static int tap_capability(pktio_entry_t *pktio_entry ODP_UNUSED,
 	capa->config.pktin.bit.ts_all = 1;
 	capa->config.pktin.bit.ts_ptp = 1;
 
+	capa->config.pktout.bit.ipv4_chksum = 1;
+	capa->config.pktout.bit.tcp_chksum = 1;
+	capa->config.pktout.bit.udp_chksum = 1;
+	capa->config.pktout.bit.ipv4_chksum_ena =
+		capa->config.pktout.bit.ipv4_chksum;
+	capa->config.pktout.bit.udp_chksum_ena =
+		capa->config.pktout.bit.udp_chksum;
+	capa->config.pktout.bit.tcp_chksum_ena =
+		capa->config.pktout.bit.tcp_chksum;
 	capa->config.pktout.bit.ts_ena = 1;
 	capa->config.pktout.bit.tx_compl_ena = 1;
 	capa->tx_compl.mode_all = 1;
@@ -568,5 +1023,7 @@ const pktio_if_ops_t _odp_tap_pktio_ops = {
 	.pktio_ts_res = NULL,
 	.pktio_ts_from_ns = NULL,
 	.pktio_time = NULL,
-	.config = NULL
+	.config = tap_config,
+	.input_queues_config = tap_input_queues_config,
+	.output_queues_config = tap_output_queues_config,
 };
@@ -30,10 +30,127 @@ fi
 
 export ODP_PKTIO_TEST_DISABLE_START_STOP=1
 
+# Memory mapped input and buffered output modes are tested with odp_l2fwd, which
+# forwards packets of a pre-generated input capture into an output capture.
+PERF_DIR=$(dirname $0)/../../../../../../test/performance
+PATH=${TEST_DIR}/../performance:${PERF_DIR}:$PATH
+
+PCAP_IN=`find . ${TEST_DIR}/../performance ${PERF_DIR} -name udp64.pcap -print -quit 2> /dev/null`
+PCAP_OUT=vald_out.pcap
+L2FWD_TIME=2
+
+# Check that a capture file has a valid header and contains only complete
+# records. All records are expected to be of equal size. Sets NUM_REC.
+pcap_check()
+{
+	NUM_REC=0
+
+	if [ "$(od -An -t x4 -N 4 $1 | tr -d ' ')" != "a1b2c3d4" ]; then
+		echo "pcap: error: bad file header in $1"
+		return 1
+	fi
+
+	size=$(stat -c %s $1)
+	if [ $size -le 24 ]; then
+		return 0
+	fi
+
+	rec_len=$((16 + $(od -An -t u4 -j 32 -N 4 $1 | tr -d ' ')))
+	if [ $(((size - 24) % rec_len)) -ne 0 ]; then
+		echo "pcap: error: partial record in $1"
+		return 1
+	fi
+
+	NUM_REC=$(((size - 24) / rec_len))
+	return 0
+}
+
+run_l2fwd()
+{
+	rm -f ${PCAP_OUT}*
+	echo "pcap: odp_l2fwd -i $1"
+	odp_l2fwd${EXEEXT} -i $1 -m 1 -q 4 -c 1 -t ${L2FWD_TIME} > /dev/null
+}
+
+# Replay in mmap mode from four input queues with a rate limit
+run_mmap_test()
+{
+	rate=1000
+
+	run_l2fwd pcap:in=${PCAP_IN}:mmap=1:loops=0:rate=${rate}:out=${PCAP_OUT} || return 1
+	pcap_check ${PCAP_OUT} || return 1
+
+	echo "pcap: ${NUM_REC} packets forwarded"
+	if [ $NUM_REC -eq 0 ] || [ $NUM_REC -gt $((rate * (L2FWD_TIME + 1))) ]; then
+		echo "pcap: error: packet count does not match rate ${rate}"
+		return 1
+	fi
+
+	return 0
+}
+
+# Buffered output with size based rotation. Output files are read back after
+# pktio close: each file must be complete and within the rotation size.
+run_buffered_test()
+{
+	rate=20000
+	rotate_mb=1
+	total=0
+	num_files=0
+
+	run_l2fwd pcap:in=${PCAP_IN}:mmap=1:loops=0:rate=${rate}:out=${PCAP_OUT}:bufsize=64:rotate_size=${rotate_mb} || return 1
+
+	for f in ${PCAP_OUT}*; do
+		[ -f "$f" ] || continue
+		pcap_check $f || return 1
+
+		if [ $(stat -c %s $f) -gt $((rotate_mb * 1024 * 1024)) ]; then
+			echo "pcap: error: $f exceeds rotation size"
+			return 1
+		fi
+
+		if command -v tcpdump > /dev/null && ! tcpdump -r $f > /dev/null 2>&1; then
+			echo "pcap: error: tcpdump failed to read $f"
+			return 1
+		fi
+
+		num_files=$((num_files + 1))
+		total=$((total + NUM_REC))
+	done
+
+	echo "pcap: ${total} packets in ${num_files} files"
+	if [ $num_files -lt 2 ] || [ $total -eq 0 ]; then
+		echo "pcap: error: output was not rotated"
+		return 1
+	fi
+
+	return 0
+}
+
+run_l2fwd_tests()
+{
+	if [ -z "$(which odp_l2fwd${EXEEXT})" ] || [ ! -f "${PCAP_IN}" ]; then
+		echo "pcap: odp_l2fwd or udp64.pcap not found, skipping replay tests"
+		return 0
+	fi
+
+	run_mmap_test && run_buffered_test
+	ret=$?
+
+	rm -f ${PCAP_OUT}*
+	return $ret
+}
+
 PCAP_FNAME=vald.pcap
 export ODP_PKTIO_IF0="pcap:out=${PCAP_FNAME}"
 export ODP_PKTIO_IF1="pcap:in=${PCAP_FNAME}"
 pktio_main${EXEEXT} $*
 ret=$?
 rm -f ${PCAP_FNAME}
+
+if [ $ret -eq 0 ]; then
+	run_l2fwd_tests
+	ret=$?
+fi
+
 exit $ret
@@ -0,0 +1,26 @@
+#!/bin/bash
+set -e
+
+# Runs timer validation tests with a linux-generic test config file, which is
+# given as the first argument (e.g. timer-wheel.conf).
+
+if [ -z "$1" ]; then
+	echo "Usage: $0 <config file>"
+	exit 1
+fi
+
+echo 1000 | tee /proc/sys/vm/nr_hugepages
+mkdir -p /mnt/huge
+mount -t hugetlbfs nodev /mnt/huge
+
+"`dirname "$0"`"/build_${ARCH}.sh
+
+cd "$(dirname "$0")"/../..
+
+export ODP_CONFIG_FILE=`pwd`/platform/linux-generic/test/$1
+
+ODP_SCHEDULER=basic    ./test/validation/api/timer/timer_main
+ODP_SCHEDULER=sp       ./test/validation/api/timer/timer_main
+ODP_SCHEDULER=scalable ./test/validation/api/timer/timer_main
+
+umount /mnt/huge
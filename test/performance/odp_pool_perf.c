@@ -22,6 +22,12 @@
 #define STAT_ALLOC_OPS  0x10
 #define STAT_FREE_OPS   0x20
 #define STAT_TOTAL_OPS  0x40
+#define STAT_CACHE_OPS  0x80
+#define STAT_GLOBAL_OPS 0x100
+#define STAT_IN_USE     0x200
+
+#define MODE_ALLOC_FREE 0
+#define MODE_PROD_CONS  1
 
 typedef struct test_options_t {
 	uint32_t num_cpu;
@@ -33,6 +39,7 @@ typedef struct test_options_t {
 	uint32_t cache_size;
 	uint32_t stats_mode;
 	int      pool_type;
+	int      mode;
 
 } test_options_t;
 
@@ -49,7 +56,10 @@ typedef struct test_global_t {
 	test_options_t test_options;
 
 	odp_barrier_t barrier;
+	odp_atomic_u32_t worker_idx;
+	odp_atomic_u32_t producers_done;
 	odp_pool_t pool;
+	odp_queue_t queue[ODP_THREAD_COUNT_MAX / 2];
 	odp_cpumask_t cpumask;
 	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
 	test_stat_t stat[ODP_THREAD_COUNT_MAX];
@@ -77,9 +87,18 @@ static void print_usage(void)
 	       "                           0x10: alloc_ops\n"
 	       "                           0x20: free_ops\n"
 	       "                           0x40: total_ops\n"
+	       "                           0x80: cache_alloc_ops and cache_free_ops\n"
+	       "                          0x100: global_ops\n"
+	       "                          0x200: max_in_use\n"
 	       "  -t, --pool_type        0: Buffer pool (default)\n"
 	       "                         1: Packet pool\n"
 	       "  -C, --cache_size       Pool cache size (per thread)\n"
+	       "  -m, --mode             Test mode:\n"
+	       "                         0: Each thread allocates and frees events (default)\n"
+	       "                         1: Producer-consumer. Threads are paired. A producer thread\n"
+	       "                            allocates events and passes those through a plain queue\n"
+	       "                            to its consumer thread, which frees the events. The\n"
+	       "                            number of CPUs must be even.\n"
 	       "  -h, --help             This help\n"
 	       "\n");
 }
@@ -100,11 +119,12 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"stats_mode", required_argument, NULL, 'S'},
 		{"pool_type",  required_argument, NULL, 't'},
 		{"cache_size", required_argument, NULL, 'C'},
+		{"mode",       required_argument, NULL, 'm'},
 		{"help",       no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:e:r:b:n:s:S:t:C:h";
+	static const char *shortopts = "+c:e:r:b:n:s:S:t:C:m:h";
 
 	test_options->num_cpu    = 1;
 	test_options->num_event  = 1000;
@@ -115,6 +135,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 	test_options->stats_mode = 0;
 	test_options->pool_type  = 0;
 	test_options->cache_size = UINT32_MAX;
+	test_options->mode       = MODE_ALLOC_FREE;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
@@ -150,6 +171,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'C':
 			test_options->cache_size = atoi(optarg);
 			break;
+		case 'm':
+			test_options->mode = atoi(optarg);
+			break;
 		case 'h':
 			/* fall through */
 		default:
@@ -168,6 +192,11 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		ret = -1;
 	}
 
+	if (test_options->mode != MODE_ALLOC_FREE && test_options->mode != MODE_PROD_CONS) {
+		printf("Bad test mode: %i\n", test_options->mode);
+		ret = -1;
+	}
+
 	return ret;
 }
 
@@ -194,9 +223,20 @@ static int set_num_cpu(test_global_t *global)
 	/* Zero: all available workers */
 	if (num_cpu == 0) {
 		num_cpu = ret;
+
+		if (test_options->mode == MODE_PROD_CONS && (num_cpu % 2)) {
+			num_cpu--;
+			odp_cpumask_default_worker(&global->cpumask, num_cpu);
+		}
+
 		test_options->num_cpu = num_cpu;
 	}
 
+	if (test_options->mode == MODE_PROD_CONS && (num_cpu == 0 || (num_cpu % 2))) {
+		printf("Error: Producer-consumer mode needs an even number of CPUs.\n");
+		return -1;
+	}
+
 	odp_barrier_init(&global->barrier, num_cpu);
 
 	return 0;
@@ -240,6 +280,14 @@ static int create_pool(test_global_t *global)
 		stats.bit.free_ops = 1;
 	if (stats_mode & STAT_TOTAL_OPS)
 		stats.bit.total_ops = 1;
+	if (stats_mode & STAT_CACHE_OPS) {
+		stats.bit.cache_alloc_ops = 1;
+		stats.bit.cache_free_ops = 1;
+	}
+	if (stats_mode & STAT_GLOBAL_OPS)
+		stats.bit.global_ops = 1;
+	if (stats_mode & STAT_IN_USE)
+		stats.bit.max_in_use = 1;
 
 	printf("\nPool performance test\n");
 	printf("  num cpu    %u\n", num_cpu);
@@ -250,7 +298,9 @@ static int create_pool(test_global_t *global)
 	printf("  data size  %u\n", data_size);
 	printf("  cache size %u\n", cache_size);
 	printf("  stats mode 0x%x\n", stats_mode);
-	printf("  pool type  %s\n\n", packet_pool ? "packet" : "buffer");
+	printf("  pool type  %s\n", packet_pool ? "packet" : "buffer");
+	printf("  test mode  %s\n\n",
+	       test_options->mode == MODE_PROD_CONS ? "producer-consumer" : "alloc-free");
 
 	if (odp_pool_capability(&pool_capa)) {
 		printf("Error: Pool capa failed.\n");
@@ -325,6 +375,67 @@ static int create_pool(test_global_t *global)
 	return 0;
 }
 
+static int create_queues(test_global_t *global)
+{
+	odp_queue_capability_t queue_capa;
+	odp_queue_param_t queue_param;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_queue = test_options->num_cpu / 2;
+	uint32_t queue_size = test_options->num_event;
+
+	if (test_options->mode != MODE_PROD_CONS)
+		return 0;
+
+	if (odp_queue_capability(&queue_capa)) {
+		printf("Error: Queue capa failed.\n");
+		return -1;
+	}
+
+	if (num_queue > queue_capa.plain.max_num) {
+		printf("Error: max plain queues supported %u\n", queue_capa.plain.max_num);
+		return -1;
+	}
+
+	if (queue_capa.plain.max_size && queue_size > queue_capa.plain.max_size)
+		queue_size = queue_capa.plain.max_size;
+
+	odp_queue_param_init(&queue_param);
+	queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	queue_param.size = queue_size;
+
+	for (uint32_t i = 0; i < num_queue; i++) {
+		global->queue[i] = odp_queue_create("pool perf", &queue_param);
+
+		if (global->queue[i] == ODP_QUEUE_INVALID) {
+			printf("Error: Queue create failed.\n");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
+static int destroy_queues(test_global_t *global)
+{
+	odp_event_t ev;
+	int ret = 0;
+
+	for (uint32_t i = 0; i < ODP_THREAD_COUNT_MAX / 2; i++) {
+		if (global->queue[i] == ODP_QUEUE_INVALID)
+			continue;
+
+		while ((ev = odp_queue_deq(global->queue[i])) != ODP_EVENT_INVALID)
+			odp_event_free(ev);
+
+		if (odp_queue_destroy(global->queue[i])) {
+			printf("Error: Queue destroy failed.\n");
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
 static int test_buffer_pool(void *arg)
 {
 	int ret, thr;
@@ -491,6 +602,188 @@ static int test_packet_pool(void *arg)
 	return 0;
 }
 
+static inline int alloc_events(odp_pool_t pool, int packet_pool, uint32_t data_size,
+			       odp_event_t ev[], int num)
+{
+	int ret;
+
+	if (packet_pool) {
+		odp_packet_t pkt[num];
+
+		ret = odp_packet_alloc_multi(pool, data_size, pkt, num);
+		if (ret > 0)
+			odp_packet_to_event_multi(pkt, ev, ret);
+	} else {
+		odp_buffer_t buf[num];
+
+		ret = odp_buffer_alloc_multi(pool, buf, num);
+		if (ret > 0)
+			odp_buffer_to_event_multi(buf, ev, ret);
+	}
+
+	return ret;
+}
+
+static int run_producer(test_global_t *global, odp_queue_t queue)
+{
+	int ret, thr;
+	uint32_t num, num_enq, i, rounds;
+	uint64_t c1, c2, cycles, nsec;
+	uint64_t events, frees;
+	odp_time_t t1, t2;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_round = test_options->num_round;
+	uint32_t max_burst = test_options->max_burst;
+	uint32_t num_burst = test_options->num_burst;
+	uint32_t max_num = num_burst * max_burst;
+	uint32_t data_size = test_options->data_size;
+	int packet_pool = test_options->pool_type;
+	odp_pool_t pool = global->pool;
+	odp_event_t ev[max_num];
+
+	thr = odp_thread_id();
+	events = 0;
+	frees = 0;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	for (rounds = 0; rounds < num_round; rounds++) {
+		num = 0;
+
+		for (i = 0; i < num_burst; i++) {
+			ret = alloc_events(pool, packet_pool, data_size, &ev[num], max_burst);
+			if (odp_unlikely(ret < 0)) {
+				printf("Error: Alloc failed. Round %u\n", rounds);
+				if (num)
+					odp_event_free_multi(ev, num);
+
+				odp_atomic_inc_u32(&global->producers_done);
+				return -1;
+			}
+
+			num += ret;
+		}
+
+		if (odp_unlikely(num == 0))
+			continue;
+
+		events += num;
+		num_enq = 0;
+
+		/* Consumer frees events in the meanwhile, retry until all are passed on */
+		while (num_enq < num) {
+			ret = odp_queue_enq_multi(queue, &ev[num_enq], num - num_enq);
+
+			if (odp_unlikely(ret < 0)) {
+				printf("Error: Enqueue failed. Round %u\n", rounds);
+				odp_event_free_multi(&ev[num_enq], num - num_enq);
+				odp_atomic_inc_u32(&global->producers_done);
+				return -1;
+			}
+
+			num_enq += ret;
+		}
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	odp_atomic_inc_u32(&global->producers_done);
+
+	nsec   = odp_time_diff_ns(t2, t1);
+	cycles = odp_cpu_cycles_diff(c2, c1);
+
+	/* Update stats*/
+	global->stat[thr].rounds = rounds;
+	global->stat[thr].frees  = frees;
+	global->stat[thr].events = events;
+	global->stat[thr].nsec   = nsec;
+	global->stat[thr].cycles = cycles;
+
+	return 0;
+}
+
+static int run_consumer(test_global_t *global, odp_queue_t queue)
+{
+	int ret, thr;
+	uint32_t rounds;
+	uint64_t c1, c2, cycles, nsec;
+	uint64_t events, frees;
+	odp_time_t t1, t2;
+	test_options_t *test_options = &global->test_options;
+	uint32_t max_burst = test_options->max_burst;
+	uint32_t num_producer = test_options->num_cpu / 2;
+	odp_event_t ev[max_burst];
+
+	thr = odp_thread_id();
+	events = 0;
+	frees = 0;
+	rounds = 0;
+
+	/* Start all workers at the same time */
+	odp_barrier_wait(&global->barrier);
+
+	t1 = odp_time_local();
+	c1 = odp_cpu_cycles();
+
+	while (1) {
+		ret = odp_queue_deq_multi(queue, ev, max_burst);
+
+		if (odp_unlikely(ret <= 0)) {
+			if (ret < 0) {
+				printf("Error: Dequeue failed\n");
+				return -1;
+			}
+
+			/* Check for an empty queue after all producers have stopped */
+			if (odp_atomic_load_u32(&global->producers_done) == num_producer) {
+				ret = odp_queue_deq_multi(queue, ev, max_burst);
+				if (ret <= 0)
+					break;
+			} else {
+				continue;
+			}
+		}
+
+		odp_event_free_multi(ev, ret);
+		rounds++;
+		frees++;
+		events += ret;
+	}
+
+	c2 = odp_cpu_cycles();
+	t2 = odp_time_local();
+
+	nsec   = odp_time_diff_ns(t2, t1);
+	cycles = odp_cpu_cycles_diff(c2, c1);
+
+	/* Update stats*/
+	global->stat[thr].rounds = rounds;
+	global->stat[thr].frees  = frees;
+	global->stat[thr].events = events;
+	global->stat[thr].nsec   = nsec;
+	global->stat[thr].cycles = cycles;
+
+	return 0;
+}
+
+static int test_prod_cons(void *arg)
+{
+	test_global_t *global = arg;
+	uint32_t idx = odp_atomic_fetch_inc_u32(&global->worker_idx);
+	odp_queue_t queue = global->queue[idx / 2];
+
+	/* Even workers produce and odd workers consume events */
+	if (idx % 2)
+		return run_consumer(global, queue);
+
+	return run_producer(global, queue);
+}
+
 static int start_workers(test_global_t *global, odp_instance_t instance)
 {
 	odph_thread_common_param_t thr_common;
@@ -508,7 +801,9 @@ static int start_workers(test_global_t *global, odp_instance_t instance)
 	thr_param.arg = global;
 	thr_param.thr_type = ODP_THREAD_WORKER;
 
-	if (packet_pool)
+	if (test_options->mode == MODE_PROD_CONS)
+		thr_param.start = test_prod_cons;
+	else if (packet_pool)
 		thr_param.start = test_packet_pool;
 	else
 		thr_param.start = test_buffer_pool;
@@ -560,6 +855,10 @@ static void test_stats_perf(test_global_t *global)
 	printf("  alloc_ops                %" PRIu64 "\n", stats.alloc_ops);
 	printf("  free_ops                 %" PRIu64 "\n", stats.free_ops);
 	printf("  total_ops                %" PRIu64 "\n", stats.total_ops);
+	printf("  cache_alloc_ops          %" PRIu64 "\n", stats.cache_alloc_ops);
+	printf("  cache_free_ops           %" PRIu64 "\n", stats.cache_free_ops);
+	printf("  global_ops               %" PRIu64 "\n", stats.global_ops);
+	printf("  max_in_use               %" PRIu64 "\n", stats.max_in_use);
 	printf("  available                %" PRIu64 "\n", stats.available);
 	printf("  cache_available          %" PRIu64 "\n", stats.cache_available);
 	for (i = 0; i < num_thr; i++) {
@@ -695,6 +994,11 @@ int main(int argc, char **argv)
 
 	memset(global, 0, sizeof(test_global_t));
 	global->pool = ODP_POOL_INVALID;
+	odp_atomic_init_u32(&global->worker_idx, 0);
+	odp_atomic_init_u32(&global->producers_done, 0);
+
+	for (int i = 0; i < ODP_THREAD_COUNT_MAX / 2; i++)
+		global->queue[i] = ODP_QUEUE_INVALID;
 
 	if (parse_options(argc, argv, &global->test_options))
 		return -1;
@@ -707,6 +1011,9 @@ int main(int argc, char **argv)
 	if (create_pool(global))
 		return -1;
 
+	if (create_queues(global))
+		return -1;
+
 	/* Start workers */
 	start_workers(global, instance);
 
@@ -718,6 +1025,9 @@ int main(int argc, char **argv)
 
 	print_stat(global);
 
+	if (destroy_queues(global))
+		return -1;
+
 	if (odp_pool_destroy(global->pool)) {
 		printf("Error: Pool destroy failed.\n");
 		return -1;
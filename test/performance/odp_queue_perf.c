@@ -11,12 +11,11 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <getopt.h>
+#include <sys/resource.h>
 
 #include <odp_api.h>
 #include <odp/helper/odph_api.h>
 
-#define MAX_QUEUES (32 * 1024)
-
 typedef struct test_options_t {
 	uint32_t num_queue;
 	uint32_t num_event;
@@ -24,6 +23,7 @@ typedef struct test_options_t {
 	uint32_t max_burst;
 	odp_nonblocking_t nonblock;
 	int single;
+	int sched;
 	int num_cpu;
 
 } test_options_t;
@@ -44,7 +44,8 @@ typedef struct test_global_t {
 	odp_instance_t   instance;
 	odp_shm_t        shm;
 	odp_pool_t       pool;
-	odp_queue_t      queue[MAX_QUEUES];
+	odp_shm_t        queue_shm;
+	odp_queue_t      *queue;
 	odph_thread_t    thread_tbl[ODP_THREAD_COUNT_MAX];
 	test_stat_t      stat[ODP_THREAD_COUNT_MAX];
 
@@ -53,7 +54,7 @@ typedef struct test_global_t {
 static void print_usage(void)
 {
 	printf("\n"
-	       "Plain queue performance test\n"
+	       "Plain and scheduled queue performance test\n"
 	       "\n"
 	       "Usage: odp_queue_perf [options]\n"
 	       "\n"
@@ -65,6 +66,9 @@ static void print_usage(void)
 	       "  -l, --lockfree         Lockfree queues\n"
 	       "  -w, --waitfree         Waitfree queues\n"
 	       "  -s, --single           Single producer, single consumer\n"
+	       "  -S, --sched            Scheduled (parallel) queues. Events are received with\n"
+	       "                         odp_schedule_multi() and enqueued back to the source\n"
+	       "                         queue.\n"
 	       "  -h, --help             This help\n"
 	       "\n");
 }
@@ -84,11 +88,12 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"lockfree",   no_argument,       NULL, 'l'},
 		{"waitfree",   no_argument,       NULL, 'w'},
 		{"single",     no_argument,       NULL, 's'},
+		{"sched",      no_argument,       NULL, 'S'},
 		{"help",       no_argument,       NULL, 'h'},
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:q:e:b:r:lwsh";
+	static const char *shortopts = "+c:q:e:b:r:lwsSh";
 
 	test_options->num_cpu   = 1;
 	test_options->num_queue = 1;
@@ -97,6 +102,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 	test_options->num_round = 1000;
 	test_options->nonblock  = ODP_BLOCKING;
 	test_options->single    = 0;
+	test_options->sched     = 0;
 
 	while (1) {
 		opt = getopt_long(argc, argv, shortopts, longopts, &long_index);
@@ -129,6 +135,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 's':
 			test_options->single = 1;
 			break;
+		case 'S':
+			test_options->sched = 1;
+			break;
 		case 'h':
 			/* fall through */
 		default:
@@ -138,19 +147,35 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		}
 	}
 
-	if (test_options->num_queue > MAX_QUEUES) {
-		printf("Too many queues %u. Test maximum %u.\n",
-		       test_options->num_queue, MAX_QUEUES);
+	if (test_options->num_queue == 0) {
+		printf("Bad number of queues\n");
+		return -1;
+	}
+
+	if (test_options->sched && test_options->nonblock != ODP_BLOCKING) {
+		printf("Lockfree and waitfree options are for plain queues only\n");
 		return -1;
 	}
 
 	return ret;
 }
 
+/* Maximum resident set size of the process in kilobytes */
+static uint64_t max_rss_kb(void)
+{
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage))
+		return 0;
+
+	return usage.ru_maxrss;
+}
+
 static int create_queues(test_global_t *global)
 {
 	odp_pool_capability_t pool_capa;
 	odp_queue_capability_t queue_capa;
+	odp_schedule_capability_t sched_capa;
 	odp_pool_param_t pool_param;
 	odp_queue_param_t queue_param;
 	odp_pool_t pool;
@@ -161,14 +186,16 @@ static int create_queues(test_global_t *global)
 	uint32_t num_event = test_options->num_event;
 	uint32_t num_round = test_options->num_round;
 	uint32_t tot_event = num_queue * num_event;
-	int ret = 0;
 	odp_queue_t *queue = global->queue;
-	odp_event_t event[tot_event];
+	odp_event_t event;
+	odp_time_t t1, t2;
+	uint64_t rss;
 
 	printf("\nTesting %s queues\n",
-	       nonblock == ODP_BLOCKING ? "NORMAL" :
+	       test_options->sched ? "SCHEDULED" :
+	       (nonblock == ODP_BLOCKING ? "NORMAL" :
 	       (nonblock == ODP_NONBLOCKING_LF ? "LOCKFREE" :
-	       (nonblock == ODP_NONBLOCKING_WF ? "WAITFREE" : "???")));
+	       (nonblock == ODP_NONBLOCKING_WF ? "WAITFREE" : "???"))));
 	printf("  num rounds           %u\n", num_round);
 	printf("  num queues           %u\n", num_queue);
 	printf("  num events per queue %u\n", num_event);
@@ -177,9 +204,6 @@ static int create_queues(test_global_t *global)
 	for (i = 0; i < num_queue; i++)
 		queue[i] = ODP_QUEUE_INVALID;
 
-	for (i = 0; i < tot_event; i++)
-		event[i] = ODP_EVENT_INVALID;
-
 	if (odp_queue_capability(&queue_capa)) {
 		printf("Error: Queue capa failed.\n");
 		return -1;
@@ -190,7 +214,24 @@ static int create_queues(test_global_t *global)
 		return -1;
 	}
 
-	if (nonblock == ODP_BLOCKING) {
+	if (test_options->sched) {
+		if (odp_schedule_capability(&sched_capa)) {
+			printf("Error: Schedule capa failed.\n");
+			return -1;
+		}
+
+		if (num_queue > sched_capa.max_queues) {
+			printf("Max scheduled queues supported %u\n",
+			       sched_capa.max_queues);
+			return -1;
+		}
+
+		max_size = sched_capa.max_queue_size;
+		if (max_size && num_event > max_size) {
+			printf("Max scheduled queue size supported %u\n", max_size);
+			return -1;
+		}
+	} else if (nonblock == ODP_BLOCKING) {
 		if (num_queue > queue_capa.plain.max_num) {
 			printf("Max queues supported %u\n",
 			       queue_capa.plain.max_num);
@@ -268,11 +309,21 @@ static int create_queues(test_global_t *global)
 	queue_param.nonblocking = nonblock;
 	queue_param.size        = num_event;
 
+	if (test_options->sched) {
+		queue_param.type        = ODP_QUEUE_TYPE_SCHED;
+		queue_param.sched.prio  = odp_schedule_default_prio();
+		queue_param.sched.sync  = ODP_SCHED_SYNC_PARALLEL;
+		queue_param.sched.group = ODP_SCHED_GROUP_ALL;
+	}
+
 	if (test_options->single) {
 		queue_param.enq_mode = ODP_QUEUE_OP_MT_UNSAFE;
 		queue_param.deq_mode = ODP_QUEUE_OP_MT_UNSAFE;
 	}
 
+	rss = max_rss_kb();
+	t1 = odp_time_local_strict();
+
 	for (i = 0; i < num_queue; i++) {
 		queue[i] = odp_queue_create(NULL, &queue_param);
 
@@ -282,38 +333,32 @@ static int create_queues(test_global_t *global)
 		}
 	}
 
-	for (i = 0; i < tot_event; i++) {
-		event[i] = odp_buffer_to_event(odp_buffer_alloc(pool));
+	t2 = odp_time_local_strict();
+	rss = max_rss_kb() - rss;
 
-		if (event[i] == ODP_EVENT_INVALID) {
-			printf("Error: Event alloc failed %u.\n", i);
-			ret = -1;
-			goto free_events;
-		}
-	}
+	printf("  queue create         %.1f nsec per queue\n",
+	       (double)odp_time_diff_ns(t2, t1) / num_queue);
+	printf("  max RSS increase     %" PRIu64 " kB (%.1f bytes per queue)\n",
+	       rss, (1024.0 * rss) / num_queue);
 
 	for (i = 0; i < num_queue; i++) {
 		for (j = 0; j < num_event; j++) {
-			uint32_t id = i * num_event + j;
+			event = odp_buffer_to_event(odp_buffer_alloc(pool));
 
-			if (odp_queue_enq(queue[i], event[id])) {
-				printf("Error: Queue enq failed %u/%u\n", i, j);
-				ret = -1;
-				goto free_events;
+			if (event == ODP_EVENT_INVALID) {
+				printf("Error: Event alloc failed %u/%u.\n", i, j);
+				return -1;
 			}
 
-			event[id] = ODP_EVENT_INVALID;
+			if (odp_queue_enq(queue[i], event)) {
+				printf("Error: Queue enq failed %u/%u\n", i, j);
+				odp_event_free(event);
+				return -1;
+			}
 		}
 	}
 
-free_events:
-	/* Free events that were not stored into queues */
-	for (i = 0; i < tot_event; i++) {
-		if (event[i] != ODP_EVENT_INVALID)
-			odp_event_free(event[i]);
-	}
-
-	return ret;
+	return 0;
 }
 
 static int destroy_queues(test_global_t *global)
@@ -327,13 +372,21 @@ static int destroy_queues(test_global_t *global)
 	odp_queue_t *queue = global->queue;
 	odp_pool_t pool    = global->pool;
 
+	/* Free events that are left into scheduled queues */
+	if (test_options->sched) {
+		uint64_t wait = odp_schedule_wait_time(100 * ODP_TIME_MSEC_IN_NS);
+
+		while ((ev = odp_schedule(NULL, wait)) != ODP_EVENT_INVALID)
+			odp_event_free(ev);
+	}
+
 	for (i = 0; i < num_queue; i++) {
 		if (queue[i] == ODP_QUEUE_INVALID) {
 			printf("Error: Invalid queue handle (i: %u).\n", i);
 			break;
 		}
 
-		for (j = 0; j < num_event; j++) {
+		for (j = 0; j < num_event && !test_options->sched; j++) {
 			ev = odp_queue_deq(queue[i]);
 
 			if (ev != ODP_EVENT_INVALID)
@@ -374,6 +427,7 @@ static int run_test(void *arg)
 	int ret = 0;
 	uint32_t i = 0;
 	uint32_t max_burst = test_options->max_burst;
+	int sched = test_options->sched;
 	odp_event_t ev[max_burst];
 
 	stat = &global->stat[thr];
@@ -388,6 +442,14 @@ static int run_test(void *arg)
 		int num_enq = 0;
 
 		do {
+			if (sched) {
+				num_ev = odp_schedule_multi(&queue, ODP_SCHED_NO_WAIT, ev,
+							    max_burst);
+				if (num_ev == 0)
+					num_deq_retry++;
+				continue;
+			}
+
 			queue = global->queue[i++];
 
 			if (i == num_queue)
@@ -423,6 +485,17 @@ static int run_test(void *arg)
 	nsec   = odp_time_diff_ns(t2, t1);
 	cycles = odp_cpu_cycles_diff(c2, c1);
 
+	/* Return prescheduled events into queues for other threads and the final clean up */
+	if (sched) {
+		odp_schedule_pause();
+
+		while ((num_ev = odp_schedule_multi(&queue, ODP_SCHED_NO_WAIT, ev,
+						    max_burst)) > 0) {
+			if (odp_queue_enq_multi(queue, ev, num_ev) != num_ev)
+				ODPH_ABORT("odp_queue_enq_multi() failed\n");
+		}
+	}
+
 	stat->rounds = rounds;
 	stat->events = events;
 	stat->nsec   = nsec;
@@ -534,6 +607,8 @@ static void print_stat(test_global_t *global)
 	       events_ave / rounds_ave);
 	printf("  cycles per event:         %.3f\n",
 	       cycles_ave / events_ave);
+	printf("  nsec per event:           %.3f\n",
+	       nsec_ave / events_ave);
 	printf("  dequeue retries:          %" PRIu64 "\n", deq_retry_sum);
 	printf("  enqueue retries:          %" PRIu64 "\n", enq_retry_sum);
 	printf("  events per sec:           %.3f M\n\n",
@@ -564,7 +639,6 @@ int main(int argc, char **argv)
 	init.not_used.feat.compress = 1;
 	init.not_used.feat.crypto   = 1;
 	init.not_used.feat.ipsec    = 1;
-	init.not_used.feat.schedule = 1;
 	init.not_used.feat.timer    = 1;
 	init.not_used.feat.tm       = 1;
 
@@ -603,6 +677,21 @@ int main(int argc, char **argv)
 
 	global->instance = instance;
 
+	global->queue_shm = odp_shm_reserve("queue_perf_queues",
+					    global->options.num_queue * sizeof(odp_queue_t),
+					    ODP_CACHE_LINE_SIZE, 0);
+	if (global->queue_shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Error: Queue table reserve failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
+	global->queue = odp_shm_addr(global->queue_shm);
+
+	if (global->options.sched && odp_schedule_config(NULL)) {
+		ODPH_ERR("Error: Schedule config failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (create_queues(global)) {
 		printf("Error: Create queues failed.\n");
 		goto destroy;
@@ -624,6 +713,11 @@ destroy:
 		return -1;
 	}
 
+	if (odp_shm_free(global->queue_shm)) {
+		ODPH_ERR("Error: Queue table free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (odp_shm_free(shm)) {
 		ODPH_ERR("Error: Shared mem free failed.\n");
 		exit(EXIT_FAILURE);
@@ -11,11 +11,12 @@
 #include <inttypes.h>
 #include <stdlib.h>
 #include <getopt.h>
+#include <sys/resource.h>
 
 #include <odp_api.h>
 #include <odp/helper/odph_api.h>
 
-#define MAX_QUEUES  (256 * 1024)
+#define MAX_QUEUES  (1024 * 1024)
 #define MAX_GROUPS  256
 
 /* Max time to wait for new events in nanoseconds */
@@ -34,6 +35,7 @@ typedef struct test_options_t {
 	uint32_t num_high;
 	uint32_t num_dummy;
 	uint32_t num_event;
+	uint32_t num_hot;
 	uint32_t num_sched;
 	int      num_group;
 	uint32_t num_join;
@@ -111,6 +113,10 @@ static void print_usage(void)
 	       "                         the queues are default (or lowest) priority. Default: 0.\n"
 	       "  -d, --num_dummy        Number of empty queues. Default: 0.\n"
 	       "  -e, --num_event        Number of events per queue. Default: 100.\n"
+	       "  -u, --num_hot          Number of hot queues out of '--num_queue' queues. All events\n"
+	       "                         (num_queue * num_event) are stored evenly into the first\n"
+	       "                         'num_hot' queues, the rest of the queues are left empty. Creates\n"
+	       "                         a skewed load between queues. 0: all queues. Default: 0.\n"
 	       "  -s, --num_sched        Number of events to schedule per thread. Default: 100 000.\n"
 	       "  -g, --num_group        Number of schedule groups. Round robins threads and queues into groups.\n"
 	       "                         -1: SCHED_GROUP_WORKER\n"
@@ -147,6 +153,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"num_high",     required_argument, NULL, 'H'},
 		{"num_dummy",    required_argument, NULL, 'd'},
 		{"num_event",    required_argument, NULL, 'e'},
+		{"num_hot",      required_argument, NULL, 'u'},
 		{"num_sched",    required_argument, NULL, 's'},
 		{"num_group",    required_argument, NULL, 'g'},
 		{"num_join",     required_argument, NULL, 'j'},
@@ -165,7 +172,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:q:L:H:d:e:s:g:j:b:t:f:a:w:k:l:n:m:p:vh";
+	static const char *shortopts = "+c:q:L:H:d:e:u:s:g:j:b:t:f:a:w:k:l:n:m:p:vh";
 
 	test_options->num_cpu    = 1;
 	test_options->num_queue  = 1;
@@ -173,6 +180,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 	test_options->num_high   = 0;
 	test_options->num_dummy  = 0;
 	test_options->num_event  = 100;
+	test_options->num_hot    = 0;
 	test_options->num_sched  = 100000;
 	test_options->num_group  = 0;
 	test_options->num_join   = 0;
@@ -212,6 +220,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'e':
 			test_options->num_event = atoi(optarg);
 			break;
+		case 'u':
+			test_options->num_hot = atoi(optarg);
+			break;
 		case 's':
 			test_options->num_sched = atoi(optarg);
 			break;
@@ -285,6 +296,12 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		ret = -1;
 	}
 
+	if (test_options->num_hot > test_options->num_queue) {
+		ODPH_ERR("Number of hot queues %u exceed number of queues %u.\n",
+			 test_options->num_hot, test_options->num_queue);
+		ret = -1;
+	}
+
 	num_group = test_options->num_group;
 	num_join  = test_options->num_join;
 	if (num_group > MAX_GROUPS) {
@@ -314,6 +331,12 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 
 	test_options->queue_size = test_options->num_event;
 
+	if (test_options->num_hot) {
+		/* Hot queues store all events */
+		test_options->queue_size = (test_options->tot_event + test_options->num_hot - 1) /
+					   test_options->num_hot;
+	}
+
 	if (test_options->forward) {
 		/* When forwarding, all events may end up into
 		 * a single queue */
@@ -422,6 +445,7 @@ static int create_pool(test_global_t *global)
 	printf("  forward events            %i\n", forward ? 1 : 0);
 	printf("  wait nsec                 %" PRIu64 "\n", wait_ns);
 	printf("  events per queue          %u\n", num_event);
+	printf("  num hot queues            %u\n", test_options->num_hot);
 	printf("  queue size                %u\n", queue_size);
 	printf("  max burst size            %u\n", max_burst);
 	printf("  total events              %u\n", tot_event);
@@ -534,6 +558,17 @@ static int create_groups(test_global_t *global)
 	return 0;
 }
 
+/* Maximum resident set size of the process in kilobytes */
+static uint64_t max_rss_kb(void)
+{
+	struct rusage usage;
+
+	if (getrusage(RUSAGE_SELF, &usage))
+		return 0;
+
+	return usage.ru_maxrss;
+}
+
 static int create_queues(test_global_t *global)
 {
 	odp_queue_param_t queue_param;
@@ -541,10 +576,12 @@ static int create_queues(test_global_t *global)
 	odp_schedule_sync_t sync;
 	odp_schedule_prio_t prio;
 	const char *type_str;
-	uint32_t i, j, first;
+	uint32_t i, j, first, num;
 	test_options_t *test_options = &global->test_options;
 	uint32_t event_size = test_options->event_size;
 	uint32_t num_event = test_options->num_event;
+	uint32_t num_hot = test_options->num_hot;
+	uint32_t tot_event = test_options->tot_event;
 	uint32_t queue_size = test_options->queue_size;
 	uint32_t tot_queue = test_options->tot_queue;
 	uint32_t num_low = test_options->num_low;
@@ -555,6 +592,8 @@ static int create_queues(test_global_t *global)
 	odp_pool_t pool = global->pool;
 	uint8_t *ctx = NULL;
 	uint32_t ctx_size = test_options->ctx_size;
+	odp_time_t t1, t2;
+	uint64_t rss;
 
 	if (type == 0) {
 		type_str = "parallel";
@@ -600,6 +639,8 @@ static int create_queues(test_global_t *global)
 		queue_param.sched.group = ODP_SCHED_GROUP_ALL;
 
 	first = test_options->num_dummy;
+	rss = max_rss_kb();
+	t1 = odp_time_local_strict();
 
 	for (i = 0; i < tot_queue; i++) {
 		if (num_group > 0) {
@@ -663,6 +704,15 @@ static int create_queues(test_global_t *global)
 		}
 	}
 
+	t2 = odp_time_local_strict();
+	rss = max_rss_kb() - rss;
+
+	printf("Queue create:\n");
+	printf("  nsec per queue            %.1f\n",
+	       (double)odp_time_diff_ns(t2, t1) / tot_queue);
+	printf("  max RSS increase          %" PRIu64 " kB (%.1f bytes per queue)\n\n",
+	       rss, (1024.0 * rss) / tot_queue);
+
 	/* Store events into queues. Dummy queues are allocated from
 	 * the beginning of the array, so that usage of those affect allocation
 	 * of active queues. Dummy queues are left empty. */
@@ -696,7 +746,16 @@ static int create_queues(test_global_t *global)
 			ctx += ctx_size;
 		}
 
-		for (j = 0; j < num_event; j++) {
+		num = num_event;
+
+		if (num_hot) {
+			/* Divide all events between the first 'num_hot' queues */
+			num = 0;
+			if (i - first < num_hot)
+				num = tot_event / num_hot + (i - first < tot_event % num_hot);
+		}
+
+		for (j = 0; j < num; j++) {
 			odp_event_t ev;
 
 			if (test_options->pool_type == ODP_POOL_BUFFER) {
@@ -1277,6 +1336,8 @@ static void print_stat(test_global_t *global)
 		printf("    without wait_ns cycles: %.3f\n",
 		       (cycles_ave - wait_cycles_ave) / events_ave);
 	}
+	printf("  nsec per event:           %.3f\n",
+	       nsec_ave / events_ave);
 	printf("  ave events received:      %.3f\n",
 	       events_ave / rounds_ave);
 	printf("  rounds per sec:           %.3f M\n",
@@ -30,4 +30,26 @@ if [ $RET_VAL -ne 0 ]; then
 	exit $RET_VAL
 fi
 
+echo odp_sched_perf: atomic queues
+echo ===============================================
+
+$TEST_DIR/odp_sched_perf${EXEEXT} -p 0 -t 1
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_sched_perf -p 0 -t 1: FAILED
+	exit $RET_VAL
+fi
+
+echo odp_sched_perf: skewed queue load
+echo ===============================================
+
+$TEST_DIR/odp_sched_perf${EXEEXT} -p 0 -q 8 -u 1
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_sched_perf -p 0 -q 8 -u 1: FAILED
+	exit $RET_VAL
+fi
+
 exit 0
@@ -21,6 +21,7 @@ typedef struct test_options_t {
 	uint32_t num_round;
 	uint32_t max_burst;
 	uint32_t stash_size;
+	uint32_t cache_size;
 	int strict;
 	int num_cpu;
 
@@ -59,6 +60,7 @@ static void print_usage(void)
 	       "  -b, --burst_size <num> Max number of objects per stash call. Default: 1\n"
 	       "  -s, --stash_size <num> Stash size. Default: 1000\n"
 	       "  -r, --num_round <num>  Number of rounds. Default: 1000\n"
+	       "  -C, --cache_size <num> Maximum number of objects cached per thread. Default: 0\n"
 	       "  -m, --strict           Strict size stash\n"
 	       "  -h, --help             This help\n"
 	       "\n");
@@ -76,18 +78,20 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{ "burst_size", required_argument, NULL, 'b' },
 		{ "stash_size", required_argument, NULL, 's' },
 		{ "num_round", required_argument, NULL, 'r' },
+		{ "cache_size", required_argument, NULL, 'C' },
 		{ "strict", no_argument, NULL, 'm' },
 		{ "help", no_argument, NULL, 'h' },
 		{ NULL, 0, NULL, 0 }
 	};
 
-	static const char *shortopts = "+c:n:b:s:r:mh";
+	static const char *shortopts = "+c:n:b:s:r:C:mh";
 
 	test_options->num_cpu = 1;
 	test_options->num_stash = 1;
 	test_options->max_burst = 1;
 	test_options->stash_size = 1000;
 	test_options->num_round = 1000;
+	test_options->cache_size = 0;
 	test_options->strict = 0;
 
 	while (1) {
@@ -112,6 +116,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'r':
 			test_options->num_round = atoi(optarg);
 			break;
+		case 'C':
+			test_options->cache_size = atoi(optarg);
+			break;
 		case 'm':
 			test_options->strict = 1;
 			break;
@@ -152,6 +159,7 @@ static int create_stashes(test_global_t *global)
 	printf("  num stashes          %u\n", num_stash);
 	printf("  stash size           %u\n", test_options->stash_size);
 	printf("  max burst size       %u\n", test_options->max_burst);
+	printf("  cache size           %u\n", test_options->cache_size);
 
 	if (odp_stash_capability(&stash_capa, ODP_STASH_TYPE_DEFAULT)) {
 		ODPH_ERR("Get stash capability failed\n");
@@ -169,6 +177,11 @@ static int create_stashes(test_global_t *global)
 		return -1;
 	}
 
+	if (test_options->cache_size > stash_capa.max_cache_size) {
+		ODPH_ERR("Max cache size supported %u\n", stash_capa.max_cache_size);
+		return -1;
+	}
+
 	for (i = 0; i < num_stash; i++) {
 		odp_stash_param_t stash_param;
 
@@ -176,6 +189,7 @@ static int create_stashes(test_global_t *global)
 		stash_param.num_obj = test_options->stash_size;
 		stash_param.obj_size = sizeof(uint32_t);
 		stash_param.strict_size = test_options->strict;
+		stash_param.cache_size = test_options->cache_size;
 
 		stash[i] = odp_stash_create("test_stash_u32", &stash_param);
 		if (stash[i] == ODP_STASH_INVALID) {
@@ -192,6 +206,12 @@ static int create_stashes(test_global_t *global)
 			}
 			num_remain -= num_stored;
 		} while (num_remain);
+
+		/* Make all objects available to worker threads */
+		if (odp_stash_flush_cache(stash[i])) {
+			ODPH_ERR("Error: Stash flush failed\n");
+			return -1;
+		}
 	}
 
 	return 0;
@@ -302,6 +322,14 @@ static int run_test(void *arg)
 	stat->nsec = nsec;
 	stat->cycles = cycles;
 	stat->num_retry = num_retry;
+
+	/* Return cached objects, so that those can be freed */
+	for (i = 0; i < num_stash; i++) {
+		if (odp_stash_flush_cache(global->stash[i])) {
+			ODPH_ERR("Error: Stash flush failed\n");
+			ret = -1;
+		}
+	}
 error:
 	free(tmp);
 	return ret;
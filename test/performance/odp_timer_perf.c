@@ -19,7 +19,6 @@
 #define MODE_START_CANCEL 1
 #define MODE_START_EXPIRE 2
 #define MAX_TIMER_POOLS   32
-#define MAX_TIMERS        10000
 #define START_NS          (100 * ODP_TIME_MSEC_IN_NS)
 
 typedef struct test_options_t {
@@ -28,6 +27,7 @@ typedef struct test_options_t {
 	uint32_t num_timer;
 	uint64_t res_ns;
 	uint64_t period_ns;
+	uint32_t burst;
 	int      shared;
 	int      mode;
 	uint64_t test_rounds;
@@ -97,14 +97,16 @@ typedef struct timer_pool_t {
 typedef struct test_global_t {
 	test_options_t test_options;
 	odp_atomic_u32_t exit_test;
+	odp_atomic_u32_t last_left[MAX_TIMER_POOLS];
 	odp_atomic_u32_t timers_started;
 	odp_barrier_t barrier;
 	odp_cpumask_t cpumask;
 	timer_pool_t timer_pool[MAX_TIMER_POOLS];
 	odp_pool_t pool[MAX_TIMER_POOLS];
 	odp_queue_t queue[MAX_TIMER_POOLS];
-	odp_timer_t timer[MAX_TIMER_POOLS][MAX_TIMERS];
-	timer_ctx_t timer_ctx[MAX_TIMER_POOLS][MAX_TIMERS];
+	odp_shm_t timer_shm;
+	odp_timer_t *timer[MAX_TIMER_POOLS];
+	timer_ctx_t *timer_ctx[MAX_TIMER_POOLS];
 	odph_thread_t thread_tbl[ODP_THREAD_COUNT_MAX];
 	test_stat_t stat[ODP_THREAD_COUNT_MAX];
 	thread_arg_t thread_arg[ODP_THREAD_COUNT_MAX];
@@ -126,6 +128,8 @@ static void print_usage(void)
 	       "  -t, --num_timer        Number of timers per timer pool. Default: 10\n"
 	       "  -r, --res_ns           Resolution in nsec.     Default:  10000000\n"
 	       "  -p, --period_ns        Timeout period in nsec. Default: 100000000\n"
+	       "  -b, --burst            Number of timers that expire at the same time in mode 0.\n"
+	       "                         Default: 1\n"
 	       "  -s, --shared           Shared vs private timer pool. Currently, private pools can be\n"
 	       "                         tested only with single CPU. Default: 1\n"
 	       "                           0: Private timer pools\n"
@@ -152,6 +156,7 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{"num_timer", required_argument, NULL, 't'},
 		{"res_ns",    required_argument, NULL, 'r'},
 		{"period_ns", required_argument, NULL, 'p'},
+		{"burst",     required_argument, NULL, 'b'},
 		{"shared",    required_argument, NULL, 's'},
 		{"mode",      required_argument, NULL, 'm'},
 		{"rounds",    required_argument, NULL, 'R'},
@@ -159,13 +164,14 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		{NULL, 0, NULL, 0}
 	};
 
-	static const char *shortopts = "+c:n:t:r:p:s:m:R:h";
+	static const char *shortopts = "+c:n:t:r:p:b:s:m:R:h";
 
 	test_options->num_cpu   = 1;
 	test_options->num_tp    = 1;
 	test_options->num_timer = 10;
 	test_options->res_ns    = 10 * ODP_TIME_MSEC_IN_NS;
 	test_options->period_ns = 100 * ODP_TIME_MSEC_IN_NS;
+	test_options->burst     = 1;
 	test_options->shared    = 1;
 	test_options->mode      = 0;
 	test_options->test_rounds = 100000;
@@ -192,6 +198,9 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		case 'p':
 			test_options->period_ns = atoll(optarg);
 			break;
+		case 'b':
+			test_options->burst = atoi(optarg);
+			break;
 		case 's':
 			test_options->shared = atoi(optarg);
 			break;
@@ -210,14 +219,58 @@ static int parse_options(int argc, char *argv[], test_options_t *test_options)
 		}
 	}
 
-	if (test_options->num_timer > MAX_TIMERS) {
-		ODPH_ERR("Too many timers. Max %u\n", MAX_TIMERS);
+	if (test_options->num_tp > MAX_TIMER_POOLS) {
+		ODPH_ERR("Too many timer pools. Max %u\n", MAX_TIMER_POOLS);
+		ret = -1;
+	}
+
+	if (test_options->burst == 0) {
+		ODPH_ERR("Burst size must be at least 1\n");
 		ret = -1;
 	}
 
 	return ret;
 }
 
+static int alloc_timer_tables(test_global_t *global)
+{
+	odp_shm_t shm;
+	uint8_t *addr;
+	uint32_t i, j;
+	test_options_t *test_options = &global->test_options;
+	uint32_t num_tp = test_options->num_tp;
+	uint32_t num_timer = test_options->num_timer;
+	uint64_t size = (uint64_t)num_tp * num_timer * (sizeof(odp_timer_t) + sizeof(timer_ctx_t));
+
+	/* Timer tables are sized by the number of timers, so that large timer counts can be
+	 * tested without wasting memory on small tests */
+	shm = odp_shm_reserve("timer_perf_timers", size, ODP_CACHE_LINE_SIZE, 0);
+	global->timer_shm = shm;
+	if (shm == ODP_SHM_INVALID) {
+		ODPH_ERR("Timer table reserve failed (%" PRIu64 " bytes)\n", size);
+		return -1;
+	}
+
+	addr = odp_shm_addr(shm);
+
+	for (i = 0; i < num_tp; i++) {
+		global->timer_ctx[i] = (timer_ctx_t *)(uintptr_t)addr;
+		addr += num_timer * sizeof(timer_ctx_t);
+	}
+
+	for (i = 0; i < num_tp; i++) {
+		global->timer[i] = (odp_timer_t *)(uintptr_t)addr;
+		addr += num_timer * sizeof(odp_timer_t);
+
+		for (j = 0; j < num_timer; j++)
+			global->timer[i][j] = ODP_TIMER_INVALID;
+	}
+
+	memset(global->timer_ctx[0], 0, (uint64_t)num_tp * num_timer * sizeof(timer_ctx_t));
+
+	return 0;
+}
+
 static int set_num_cpu(test_global_t *global)
 {
 	int ret;
@@ -268,7 +321,7 @@ static int create_timer_pools(test_global_t *global)
 	odp_pool_param_t pool_param;
 	odp_pool_t pool;
 	uint64_t max_tmo_ns, min_tmo_ns;
-	uint32_t i, j;
+	uint32_t i;
 	uint32_t max_timers;
 	int priv;
 	test_options_t *test_options = &global->test_options;
@@ -277,10 +330,12 @@ static int create_timer_pools(test_global_t *global)
 	uint32_t num_timer = test_options->num_timer;
 	uint64_t res_ns    = test_options->res_ns;
 	uint64_t period_ns = test_options->period_ns;
+	uint32_t burst     = test_options->burst;
+	uint32_t num_burst = (num_timer + burst - 1) / burst;
 	int mode = test_options->mode;
 	char tp_name[] = "timer_pool_00";
 
-	max_tmo_ns = START_NS + (num_timer * period_ns);
+	max_tmo_ns = START_NS + (num_burst * period_ns);
 	min_tmo_ns = START_NS / 2;
 
 	if (test_options->mode == MODE_START_EXPIRE) {
@@ -305,6 +360,8 @@ static int create_timer_pools(test_global_t *global)
 	printf("  num timer        %u\n", num_timer);
 	printf("  resolution       %" PRIu64 " nsec\n", res_ns);
 	printf("  period           %" PRIu64 " nsec\n", period_ns);
+	if (mode == MODE_SCHED_OVERH)
+		printf("  burst            %u\n", burst);
 	printf("  max timeout      %" PRIu64 " nsec\n", max_tmo_ns);
 	printf("  min timeout      %" PRIu64 " nsec\n", min_tmo_ns);
 	printf("  first timer at   %.2f sec\n", (double)START_NS / ODP_TIME_SEC_IN_NS);
@@ -317,9 +374,6 @@ static int create_timer_pools(test_global_t *global)
 		global->timer_pool[i].tp = ODP_TIMER_POOL_INVALID;
 		global->pool[i]  = ODP_POOL_INVALID;
 		global->queue[i] = ODP_QUEUE_INVALID;
-
-		for (j = 0; j < MAX_TIMERS; j++)
-			global->timer[i][j] = ODP_TIMER_INVALID;
 	}
 
 	if (odp_timer_capability(ODP_CLOCK_DEFAULT, &timer_capa)) {
@@ -434,8 +488,10 @@ static int set_timers(test_global_t *global)
 	uint32_t num_tp    = test_options->num_tp;
 	uint32_t num_timer = test_options->num_timer;
 	uint64_t period_ns = test_options->period_ns;
+	uint32_t burst     = test_options->burst;
+	uint32_t num_burst = (num_timer + burst - 1) / burst;
 
-	max_tmo_ns = START_NS + (num_timer * period_ns);
+	max_tmo_ns = START_NS + (num_burst * period_ns);
 
 	for (i = 0; i < num_tp; i++) {
 		tp    = global->timer_pool[i].tp;
@@ -447,6 +503,9 @@ static int set_timers(test_global_t *global)
 		time     = odp_time_global();
 		time_ns  = odp_time_to_ns(time);
 
+		/* Timers of the last burst expire on the same tick */
+		odp_atomic_init_u32(&global->last_left[i], burst < num_timer ? burst : num_timer);
+
 		for (j = 0; j < num_timer; j++) {
 			uint64_t tick_ns;
 			odp_timeout_t timeout;
@@ -455,8 +514,8 @@ static int set_timers(test_global_t *global)
 			timer_ctx_t *ctx = &global->timer_ctx[i][j];
 			odp_timer_start_t start_param;
 
-			/* Set timers backwards, the last timer is set first */
-			if (j == 0)
+			/* Set timers backwards, the last timers are set first */
+			if (j < burst)
 				ctx->last = 1;
 
 			ctx->target_ns = time_ns + nsec;
@@ -470,7 +529,10 @@ static int set_timers(test_global_t *global)
 			global->timer[i][j] = timer;
 
 			tick_ns = odp_timer_ns_to_tick(tp, nsec);
-			nsec    = nsec - period_ns;
+
+			/* Timers of a burst share the same timeout */
+			if (((j + 1) % burst) == 0)
+				nsec = nsec - period_ns;
 
 			start_param.tick_type = ODP_TIMER_TICK_ABS;
 			start_param.tick = tick_cur + tick_ns;
@@ -507,6 +569,7 @@ static int set_timers(test_global_t *global)
 
 static int destroy_timer_pool(test_global_t *global)
 {
+	odp_timer_pool_info_t timer_pool_info;
 	odp_timer_pool_t tp;
 	odp_pool_t pool;
 	odp_queue_t queue;
@@ -542,8 +605,13 @@ static int destroy_timer_pool(test_global_t *global)
 			odp_pool_destroy(pool);
 
 		tp = global->timer_pool[i].tp;
-		if (tp != ODP_TIMER_POOL_INVALID)
+		if (tp != ODP_TIMER_POOL_INVALID) {
+			if (odp_timer_pool_info(tp, &timer_pool_info) == 0)
+				printf("Timer pool [%i] overruns: %" PRIu64 "\n", i,
+				       timer_pool_info.overruns);
+
 			odp_timer_pool_destroy(tp);
+		}
 	}
 
 	return 0;
@@ -628,7 +696,7 @@ static int sched_mode_worker(void *arg)
 			ODPH_DBG("after %" PRIu64 "\n", time_ns - target_ns);
 		}
 
-		if (ctx->last)
+		if (ctx->last && odp_atomic_fetch_dec_u32(&global->last_left[ctx->tp_idx]) == 1)
 			odp_atomic_inc_u32(&global->exit_test);
 	}
 
@@ -1190,6 +1258,9 @@ int main(int argc, char **argv)
 
 	odp_schedule_config(NULL);
 
+	if (alloc_timer_tables(global))
+		return -1;
+
 	if (set_num_cpu(global))
 		return -1;
 
@@ -1247,6 +1318,11 @@ int main(int argc, char **argv)
 
 	destroy_timer_pool(global);
 
+	if (odp_shm_free(global->timer_shm)) {
+		ODPH_ERR("Timer table free failed.\n");
+		exit(EXIT_FAILURE);
+	}
+
 	if (odp_shm_free(shm)) {
 		ODPH_ERR("Shared mem free failed.\n");
 		exit(EXIT_FAILURE);
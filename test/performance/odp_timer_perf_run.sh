@@ -19,6 +19,17 @@ if [ $RET_VAL -ne 0 ]; then
 	exit $RET_VAL
 fi
 
+echo odp_timer_perf: odp_schedule overhead mode with timeout bursts
+echo ===============================================
+
+$TEST_DIR/odp_timer_perf${EXEEXT} -m 0 -c 1 -t 100 -b 50
+
+RET_VAL=$?
+if [ $RET_VAL -ne 0 ]; then
+	echo odp_timer_perf -m 0 -b 50: FAILED
+	exit $RET_VAL
+fi
+
 echo odp_timer_perf: timer set + cancel mode
 echo ===============================================
 
@@ -81,6 +81,8 @@ static void test_param_init(uint8_t fill)
 	CU_ASSERT(param.vector.uarea_size == 0);
 	CU_ASSERT(param.vector.cache_size >= global_pool_capa.vector.min_cache_size &&
 		  param.vector.cache_size <= global_pool_capa.vector.max_cache_size);
+
+	CU_ASSERT(param.numa_node == -1);
 }
 
 static void pool_test_param_init(void)
@@ -1439,6 +1441,15 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 		CU_ASSERT(stats.cache_free_ops == 0);
 		if (supported.bit.cache_free_ops)
 			CU_ASSERT(selected.cache_free_ops == 0);
+		CU_ASSERT(stats.remote_alloc_ops == 0);
+		if (supported.bit.remote_alloc_ops)
+			CU_ASSERT(selected.remote_alloc_ops == 0);
+		CU_ASSERT(stats.global_ops == 0);
+		if (supported.bit.global_ops)
+			CU_ASSERT(selected.global_ops == 0);
+		CU_ASSERT(stats.max_in_use <= num_obj);
+		if (supported.bit.max_in_use)
+			CU_ASSERT(selected.max_in_use <= num_obj);
 
 		CU_ASSERT(stats.thread.first == first);
 		CU_ASSERT(stats.thread.last == last);
@@ -1553,6 +1564,17 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 		CU_ASSERT(stats.cache_free_ops == 0);
 		if (supported.bit.cache_free_ops)
 			CU_ASSERT(selected.cache_free_ops == 0);
+		CU_ASSERT(stats.remote_alloc_ops <= stats.alloc_ops);
+		if (supported.bit.remote_alloc_ops)
+			CU_ASSERT(selected.remote_alloc_ops <= selected.alloc_ops);
+		if (supported.bit.global_ops) {
+			CU_ASSERT(stats.global_ops > 0 && stats.global_ops <= num_allocs);
+			CU_ASSERT(selected.global_ops > 0 && selected.global_ops <= num_allocs);
+		}
+		if (supported.bit.max_in_use) {
+			CU_ASSERT(stats.max_in_use >= num_events);
+			CU_ASSERT(selected.max_in_use >= num_events);
+		}
 	}
 
 	for (i = 0; i < num_pool; i++) {
@@ -1589,6 +1611,9 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 			printf("  cache_available: %" PRIu64 "\n", stats.cache_available);
 			printf("  cache_alloc_ops: %" PRIu64 "\n", stats.cache_alloc_ops);
 			printf("  cache_free_ops:  %" PRIu64 "\n", stats.cache_free_ops);
+			printf("  remote_alloc_ops: %" PRIu64 "\n", stats.remote_alloc_ops);
+			printf("  global_ops:      %" PRIu64 "\n", stats.global_ops);
+			printf("  max_in_use:      %" PRIu64 "\n", stats.max_in_use);
 			printf("  thread.cache_available[0]: %" PRIu64 "\n",
 			       stats.thread.cache_available[0]);
 		}
@@ -1615,6 +1640,12 @@ static void pool_test_pool_statistics(odp_pool_type_t pool_type)
 		CU_ASSERT(stats.cache_free_ops == 0);
 		if (supported.bit.cache_free_ops)
 			CU_ASSERT(selected.cache_free_ops == 0);
+		CU_ASSERT(stats.remote_alloc_ops == 0);
+		if (supported.bit.remote_alloc_ops)
+			CU_ASSERT(selected.remote_alloc_ops == 0);
+		CU_ASSERT(stats.global_ops == 0);
+		if (supported.bit.global_ops)
+			CU_ASSERT(selected.global_ops == 0);
 
 		CU_ASSERT(odp_pool_destroy(pool[i]) == 0);
 	}
@@ -539,6 +539,117 @@ static void scheduler_test_queue_size(void)
 	CU_ASSERT_FATAL(odp_pool_destroy(pool) == 0);
 }
 
+static int check_latency_stats(void)
+{
+	odp_schedule_capability_t sched_capa;
+
+	if (odp_schedule_capability(&sched_capa) || !sched_capa.latency_stats) {
+		printf("\n    Scheduling latency statistics not supported or enabled\n");
+		return ODP_TEST_INACTIVE;
+	}
+
+	return ODP_TEST_ACTIVE;
+}
+
+static void scheduler_test_latency_stats(void)
+{
+	odp_pool_t pool;
+	odp_pool_param_t pool_param;
+	odp_queue_param_t queue_param;
+	odp_queue_t queue;
+	odp_event_t ev;
+	odp_buffer_t buf;
+	odp_schedule_latency_stats_t stats;
+	uint32_t i, j, num, num_round;
+	uint64_t sum;
+	int ret;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.buf.size  = 100;
+	pool_param.buf.num   = DEFAULT_NUM_EV;
+	pool_param.type      = ODP_POOL_BUFFER;
+
+	pool = odp_pool_create("test_latency_stats", &pool_param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	sched_queue_param_init(&queue_param);
+	queue = odp_queue_create("test_latency_stats", &queue_param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	CU_ASSERT_FATAL(odp_schedule_latency_stats_reset() == 0);
+
+	ret = odp_schedule_latency_stats(queue_param.sched.group, queue_param.sched.prio,
+					 queue_param.sched.sync, &stats);
+	CU_ASSERT_FATAL(ret == 0);
+	CU_ASSERT_FATAL(stats.sample_rate > 0);
+	CU_ASSERT(stats.num_sample == 0);
+	CU_ASSERT(stats.min_latency == 0);
+	CU_ASSERT(stats.avg_latency == 0);
+
+	/* Pass events through the queue one at a time. One out of 'sample_rate' enqueues and
+	 * schedule operations is sampled, so this produces at least two samples of both. */
+	num_round = 2 * stats.sample_rate;
+	num = 0;
+
+	for (i = 0; i < num_round; i++) {
+		buf = odp_buffer_alloc(pool);
+		CU_ASSERT_FATAL(buf != ODP_BUFFER_INVALID);
+
+		ev = odp_buffer_to_event(buf);
+		ret = odp_queue_enq(queue, ev);
+		CU_ASSERT(ret == 0);
+
+		if (ret) {
+			odp_event_free(ev);
+			continue;
+		}
+
+		for (j = 0; j < 100 * DEFAULT_NUM_EV; j++) {
+			ev = odp_schedule(NULL, ODP_SCHED_NO_WAIT);
+
+			if (ev == ODP_EVENT_INVALID)
+				continue;
+
+			odp_event_free(ev);
+			num++;
+			break;
+		}
+	}
+
+	CU_ASSERT(num == num_round);
+	CU_ASSERT(drain_queues() == 0);
+
+	ret = odp_schedule_latency_stats(queue_param.sched.group, queue_param.sched.prio,
+					 queue_param.sched.sync, &stats);
+	CU_ASSERT_FATAL(ret == 0);
+	CU_ASSERT(stats.num_sample > 0);
+	CU_ASSERT(stats.min_latency <= stats.avg_latency);
+	CU_ASSERT(stats.avg_latency <= stats.max_latency);
+
+	sum = 0;
+	for (i = 0; i < ODP_SCHED_LATENCY_HIST_BINS; i++)
+		sum += stats.latency[i];
+
+	CU_ASSERT(sum == stats.num_sample);
+
+	sum = 0;
+	for (i = 0; i < ODP_SCHED_BURST_HIST_BINS; i++)
+		sum += stats.burst[i];
+
+	CU_ASSERT(sum > 0);
+
+	CU_ASSERT(odp_schedule_latency_stats_reset() == 0);
+	CU_ASSERT(odp_schedule_latency_stats(queue_param.sched.group, queue_param.sched.prio,
+					     queue_param.sched.sync, &stats) == 0);
+	CU_ASSERT(stats.num_sample == 0);
+	CU_ASSERT(stats.min_latency == 0);
+	CU_ASSERT(stats.max_latency == 0);
+	CU_ASSERT(stats.avg_latency == 0);
+
+	CU_ASSERT_FATAL(odp_queue_destroy(queue) == 0);
+	CU_ASSERT_FATAL(odp_pool_destroy(pool) == 0);
+}
+
 static void scheduler_test_full_queues(void)
 {
 	odp_schedule_config_t default_config;
@@ -3707,6 +3818,7 @@ odp_testinfo_t scheduler_basic_suite[] = {
 	ODP_TEST_INFO(scheduler_test_queue_destroy),
 	ODP_TEST_INFO(scheduler_test_wait),
 	ODP_TEST_INFO(scheduler_test_queue_size),
+	ODP_TEST_INFO_CONDITIONAL(scheduler_test_latency_stats, check_latency_stats),
 	ODP_TEST_INFO(scheduler_test_full_queues),
 	ODP_TEST_INFO(scheduler_test_max_queues_p),
 	ODP_TEST_INFO(scheduler_test_max_queues_a),
@@ -241,6 +241,8 @@ static void shmem_test_capability(void)
 		printf("ODP_SHM_HW_ACCESS ");
 	if (capa.flags & ODP_SHM_NO_HP)
 		printf("ODP_SHM_NO_HP ");
+	if (capa.flags & ODP_SHM_NUMA_LOCAL)
+		printf("ODP_SHM_NUMA_LOCAL ");
 	printf("\n\n");
 }
 
@@ -446,6 +448,33 @@ static void shmem_test_flag_no_hp(void)
 	CU_ASSERT(odp_shm_free(shm) == 0);
 }
 
+static int shmem_check_flag_numa_local(void)
+{
+	if (_global_shm_capa.flags & ODP_SHM_NUMA_LOCAL)
+		return ODP_TEST_ACTIVE;
+	return ODP_TEST_INACTIVE;
+}
+
+/*
+ * Test reserving memory from the local NUMA node
+ */
+static void shmem_test_flag_numa_local(void)
+{
+	odp_shm_t shm;
+	uint8_t *addr;
+
+	shm = odp_shm_reserve(MEM_NAME, MEDIUM_MEM, ALIGN_SIZE, ODP_SHM_NUMA_LOCAL);
+	CU_ASSERT_FATAL(shm != ODP_SHM_INVALID);
+
+	addr = odp_shm_addr(shm);
+	CU_ASSERT_FATAL(addr != NULL);
+
+	memset(addr, 0xa5, MEDIUM_MEM);
+	CU_ASSERT(addr[0] == 0xa5 && addr[MEDIUM_MEM - 1] == 0xa5);
+
+	CU_ASSERT(odp_shm_free(shm) == 0);
+}
+
 static int shmem_check_flag_proc(void)
 {
 	if (_global_shm_capa.flags & ODP_SHM_PROC)
@@ -1142,6 +1171,7 @@ odp_testinfo_t shmem_suite[] = {
 	ODP_TEST_INFO(shmem_test_info),
 	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_hp, shmem_check_flag_hp),
 	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_no_hp, shmem_check_flag_no_hp),
+	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_numa_local, shmem_check_flag_numa_local),
 	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_proc, shmem_check_flag_proc),
 	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_export, shmem_check_flag_export),
 	ODP_TEST_INFO_CONDITIONAL(shmem_test_flag_hw_access, shmem_check_flag_hw_access),
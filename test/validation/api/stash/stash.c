@@ -281,7 +281,7 @@ static void stash_create_u64_all(void)
 		CU_ASSERT_FATAL(odp_stash_destroy(stash[i]) == 0);
 }
 
-static void stash_create_u32_all(void)
+static void create_u32_all(uint32_t cache_size)
 {
 	odp_stash_param_t param;
 	uint32_t i, retry, input, output;
@@ -295,6 +295,7 @@ static void stash_create_u32_all(void)
 	odp_stash_param_init(&param);
 	param.num_obj  = num_obj;
 	param.obj_size = sizeof(uint32_t);
+	param.cache_size = cache_size;
 
 	for (i = 0; i < num_stash; i++) {
 		stash[i] = odp_stash_create("test_stash_u32_all", &param);
@@ -324,6 +325,16 @@ static void stash_create_u32_all(void)
 		CU_ASSERT_FATAL(odp_stash_destroy(stash[i]) == 0);
 }
 
+static void stash_create_u32_all(void)
+{
+	create_u32_all(0);
+}
+
+static void stash_create_u32_all_cache(void)
+{
+	create_u32_all(global.cache_size_default);
+}
+
 static void stash_create_fifo_u64_all(void)
 {
 	odp_stash_param_t param;
@@ -480,6 +491,95 @@ static void stash_stats_u32(void)
 	CU_ASSERT_FATAL(odp_stash_destroy(stash) == 0);
 }
 
+static void stash_cache_u32(void)
+{
+	odp_stash_t stash;
+	odp_stash_param_t param;
+	odp_stash_stats_t stats;
+	int capa_count, capa_cache_count;
+	int32_t ret;
+	uint32_t i, retry, input, output;
+	uint32_t cache_size = global.cache_size_default;
+	uint32_t num = 4 * cache_size;
+	uint32_t num_get = 0;
+	uint8_t seen[num];
+
+	capa_count       = global.capa_default.stats.bit.count;
+	capa_cache_count = global.capa_default.stats.bit.cache_count;
+
+	odp_stash_param_init(&param);
+	param.num_obj    = num;
+	param.obj_size   = sizeof(uint32_t);
+	param.cache_size = cache_size;
+	param.stats.bit.count       = capa_count;
+	param.stats.bit.cache_count = capa_cache_count;
+
+	stash = odp_stash_create("test_cache_u32", &param);
+	CU_ASSERT_FATAL(stash != ODP_STASH_INVALID);
+
+	/* Objects put into the cache are returned by a following get */
+	for (i = 0; i < cache_size; i++) {
+		input = VAL_U32 + i;
+		CU_ASSERT_FATAL(odp_stash_put_u32(stash, &input, 1) == 1);
+		output = 0;
+		CU_ASSERT_FATAL(odp_stash_get_u32(stash, &output, 1) == 1);
+		CU_ASSERT(output == input);
+	}
+
+	/* Overflow the cache, so that objects are moved into the shared ring */
+	for (i = 0; i < num; i++) {
+		input = i;
+		CU_ASSERT_FATAL(odp_stash_put_u32(stash, &input, 1) == 1);
+	}
+
+	memset(&stats, 0xff, sizeof(odp_stash_stats_t));
+	CU_ASSERT_FATAL(odp_stash_stats(stash, &stats) == 0);
+
+	if (capa_count && capa_cache_count)
+		CU_ASSERT((stats.count + stats.cache_count) == num);
+
+	/* Print with objects in the cache */
+	odp_stash_print(stash);
+
+	CU_ASSERT(odp_stash_flush_cache(stash) == 0);
+
+	memset(&stats, 0xff, sizeof(odp_stash_stats_t));
+	CU_ASSERT_FATAL(odp_stash_stats(stash, &stats) == 0);
+
+	if (capa_cache_count)
+		CU_ASSERT(stats.cache_count == 0);
+
+	if (capa_count)
+		CU_ASSERT(stats.count == num);
+
+	odp_stash_print(stash);
+
+	/* All objects are found after the flush, each only once */
+	memset(seen, 0, sizeof(seen));
+
+	for (retry = 0; retry < RETRY_MSEC && num_get < num; retry++) {
+		while (num_get < num) {
+			output = -1;
+			ret = odp_stash_get_u32(stash, &output, 1);
+			if (ret != 1)
+				break;
+
+			CU_ASSERT_FATAL(output < num);
+			CU_ASSERT(seen[output] == 0);
+			seen[output] = 1;
+			num_get++;
+		}
+
+		if (num_get < num)
+			odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+	}
+
+	CU_ASSERT(num_get == num);
+	CU_ASSERT(odp_stash_get_u32(stash, &output, 1) == 0);
+
+	CU_ASSERT_FATAL(odp_stash_destroy(stash) == 0);
+}
+
 static void stash_default_put(uint32_t size, int32_t burst, stash_op_t op, int batch,
 			      odp_bool_t strict_size)
 {
@@ -960,6 +1060,14 @@ static int check_support_fifo_ptr(void)
 	return ODP_TEST_INACTIVE;
 }
 
+static int check_support_cache(void)
+{
+	if (global.capa_default.max_cache_size)
+		return ODP_TEST_ACTIVE;
+
+	return ODP_TEST_INACTIVE;
+}
+
 static int check_support_fifo(void)
 {
 	if (global.fifo_supported)
@@ -1340,6 +1448,8 @@ odp_testinfo_t stash_suite[] = {
 	ODP_TEST_INFO_CONDITIONAL(stash_create_u64_all, check_support_64),
 	ODP_TEST_INFO(stash_create_u32_all),
 	ODP_TEST_INFO(stash_stats_u32),
+	ODP_TEST_INFO_CONDITIONAL(stash_cache_u32, check_support_cache),
+	ODP_TEST_INFO_CONDITIONAL(stash_create_u32_all_cache, check_support_cache),
 	ODP_TEST_INFO_CONDITIONAL(stash_fifo_put_u64_1, check_support_fifo_64),
 	ODP_TEST_INFO_CONDITIONAL(stash_fifo_put_u64_n, check_support_fifo_64),
 	ODP_TEST_INFO_CONDITIONAL(stash_fifo_u64_put_u64_1, check_support_fifo_64),
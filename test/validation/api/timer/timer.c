@@ -1380,6 +1380,101 @@ static void timer_pool_tick_info(void)
 	}
 }
 
+static uint64_t sum_hist(const uint64_t hist[])
+{
+	uint64_t sum = 0;
+	int i;
+
+	for (i = 0; i < ODP_TIMER_POOL_STATS_HIST_BINS; i++)
+		sum += hist[i];
+
+	return sum;
+}
+
+static void timer_pool_stats(void)
+{
+	odp_timer_pool_param_t tp_param;
+	odp_timer_pool_stats_t stats;
+	odp_queue_param_t queue_param;
+	odp_pool_param_t pool_param;
+	odp_timer_start_t start_param;
+	odp_timer_pool_t tp;
+	odp_timer_t timer;
+	odp_pool_t pool;
+	odp_queue_t queue;
+	odp_event_t ev;
+	odp_time_t t1;
+	int i;
+	uint64_t tmo_ns = 2 * global_mem->param.min_tmo;
+
+	odp_pool_param_init(&pool_param);
+	pool_param.type    = ODP_POOL_TIMEOUT;
+	pool_param.tmo.num = 1;
+	pool = odp_pool_create("timeout_pool", &pool_param);
+	CU_ASSERT_FATAL(pool != ODP_POOL_INVALID);
+
+	odp_queue_param_init(&queue_param);
+	queue_param.type = ODP_QUEUE_TYPE_PLAIN;
+	queue = odp_queue_create("timer_queue", &queue_param);
+	CU_ASSERT_FATAL(queue != ODP_QUEUE_INVALID);
+
+	odp_timer_pool_param_init(&tp_param);
+	tp_param.res_ns     = global_mem->param.res_ns;
+	tp_param.min_tmo    = global_mem->param.min_tmo;
+	tp_param.max_tmo    = global_mem->param.max_tmo;
+	tp_param.num_timers = 1;
+
+	tp = odp_timer_pool_create("timer_pool_stats", &tp_param);
+	CU_ASSERT_FATAL(tp != ODP_TIMER_POOL_INVALID);
+
+	odp_timer_pool_start();
+
+	CU_ASSERT_FATAL(odp_timer_pool_stats(tp, &stats) == 0);
+	CU_ASSERT(stats.num_expired == 0);
+	CU_ASSERT(sum_hist(stats.expire_lateness) == 0);
+	CU_ASSERT(sum_hist(stats.enq_lateness) == 0);
+
+	timer = odp_timer_alloc(tp, queue, USER_PTR);
+	CU_ASSERT_FATAL(timer != ODP_TIMER_INVALID);
+
+	start_param.tick_type = ODP_TIMER_TICK_REL;
+	start_param.tick      = odp_timer_ns_to_tick(tp, tmo_ns);
+	start_param.tmo_ev    = odp_timeout_to_event(odp_timeout_alloc(pool));
+	CU_ASSERT_FATAL(start_param.tmo_ev != ODP_EVENT_INVALID);
+	CU_ASSERT_FATAL(odp_timer_start(timer, &start_param) == ODP_TIMER_SUCCESS);
+
+	t1 = odp_time_global();
+	ev = wait_event(ODP_QUEUE_TYPE_PLAIN, queue, t1, 10 * tmo_ns);
+	CU_ASSERT_FATAL(ev != ODP_EVENT_INVALID);
+	odp_event_free(ev);
+
+	/* Statistics may be updated with a delay */
+	for (i = 0; i < 100; i++) {
+		CU_ASSERT_FATAL(odp_timer_pool_stats(tp, &stats) == 0);
+
+		if (stats.num_expired)
+			break;
+
+		odp_time_wait_ns(ODP_TIME_MSEC_IN_NS);
+	}
+
+	CU_ASSERT(stats.num_expired == 1);
+	CU_ASSERT(sum_hist(stats.expire_lateness) == stats.num_expired);
+	CU_ASSERT(sum_hist(stats.enq_lateness) == stats.num_expired);
+
+	CU_ASSERT(odp_timer_pool_stats_reset(tp) == 0);
+	CU_ASSERT_FATAL(odp_timer_pool_stats(tp, &stats) == 0);
+	CU_ASSERT(stats.num_expired == 0);
+	CU_ASSERT(sum_hist(stats.expire_lateness) == 0);
+	CU_ASSERT(sum_hist(stats.enq_lateness) == 0);
+
+	CU_ASSERT(odp_timer_free(timer) == ODP_EVENT_INVALID);
+	odp_timer_pool_destroy(tp);
+
+	CU_ASSERT(odp_queue_destroy(queue) == 0);
+	CU_ASSERT(odp_pool_destroy(pool) == 0);
+}
+
 static void timer_test_event_type(odp_queue_type_t queue_type,
 				  odp_event_type_t event_type, int rounds)
 {
@@ -3093,6 +3188,7 @@ odp_testinfo_t timer_suite[] = {
 	ODP_TEST_INFO(timer_pool_current_tick),
 	ODP_TEST_INFO(timer_pool_sample_ticks),
 	ODP_TEST_INFO(timer_pool_tick_info),
+	ODP_TEST_INFO_CONDITIONAL(timer_pool_stats, check_plain_queue_support),
 	ODP_TEST_INFO_CONDITIONAL(timer_plain_rel_wait, check_plain_queue_support),
 	ODP_TEST_INFO_CONDITIONAL(timer_plain_abs_wait, check_plain_queue_support),
 	ODP_TEST_INFO_CONDITIONAL(timer_plain_rel_cancel, check_plain_queue_support),